@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+class JobSystem;
+
+// Records the draws [begin, end) of chunk index into that chunk's own list.
+// Chunks of one RecordChunks() call run concurrently, so an implementation
+// may only write state owned by the chunk. The renderer records into one
+// command list per chunk; tests and benchmarks use a stub.
+class IChunkRecorder
+{
+public:
+    virtual ~IChunkRecorder() {}
+    virtual void RecordChunk(uint32_t index, uint32_t begin, uint32_t end) = 0;
+};
+
+// How drawCount draws are split for recording.
+struct ChunkLayout
+{
+    uint32_t    Count;  // chunks, at least one
+    uint32_t    Size;   // draws per chunk; the last one may hold fewer
+};
+
+// One chunk per minDraws draws, rounded up, and at most maxChunks: every
+// chunk costs a state setup and a thread handoff, so small lists stay whole.
+// No draws still gives one (empty) chunk, so there is always a list to submit.
+ChunkLayout PartitionChunks(uint32_t drawCount, uint32_t maxChunks, uint32_t minDraws);
+
+// Calls pRecorder->RecordChunk() for every chunk of PartitionChunks() on the
+// job system and returns once all have been recorded. Returns the chunk count.
+uint32_t RecordChunks(
+    JobSystem&      jobs,
+    IChunkRecorder* pRecorder,
+    uint32_t        drawCount,
+    uint32_t        maxChunks,
+    uint32_t        minDraws);
\ No newline at end of file
@@ -3,9 +3,9 @@
 #include <d3d12.h>
 #include <ComPtr.h>
 #include <vector>
-
-class DescriptorHandle;
-class DescriptorPool;
+#include <DescriptorPool.h>
+#include <GpuAllocator.h>
+#include <MemoryUtil.h>
 
 class ConstantBuffer
 {
@@ -15,6 +15,7 @@ public:
 
     bool Init(
         ID3D12Device*   pDevice,
+        GpuAllocator*   pAllocator,
         DescriptorPool* pPool,
         size_t          size,
         int             count);
@@ -37,14 +38,16 @@ public:
     void CopyData(int dataIdx, const T& data)
     {
         BYTE* ptr = (BYTE*)m_pMappedPtr;
-        memcpy(&ptr[dataIdx * m_ElementSize], &data, sizeof(T));
+        StreamCopy(&ptr[dataIdx * m_ElementSize], &data, sizeof(T));
     }
 
     UINT64 GetElementSize() const { return m_ElementSize; }
 
 private:
     ComPtr<ID3D12Resource>          m_pCB;
-    DescriptorHandle*               m_pHandle;
+    GpuAllocator*                   m_pAllocator;
+    GpuAllocation                   m_Allocation;
+    DescriptorId                    m_HandleId;
     DescriptorPool*                 m_pPool;
     D3D12_CONSTANT_BUFFER_VIEW_DESC m_Desc;
     void*                           m_pMappedPtr;
@@ -3,9 +3,9 @@
 #include <d3d12.h>
 #include <ComPtr.h>
 #include <cstdint>
-
-class DescriptorHandle;
-class DescriptorPool;
+#include <DescriptorPool.h>
+#include <GpuAllocator.h>
+#include <RetireQueue.h>
 
 class DepthTarget
 {
@@ -18,6 +18,7 @@ public:
 
     void Init(
         ID3D12Device*   pDevice,
+        GpuAllocator*   pAllocator,
         DescriptorPool* pPoolDSV,
         uint32_t        width,
         uint32_t        height,
@@ -25,6 +26,10 @@ public:
 
     void Term();
 
+    // Like Term(), but the buffer is released only once retireValue completes
+    // in queue. The DSV is freed right away; it is consumed when recorded.
+    void Retire(RetireQueue& queue, uint64_t retireValue);
+
     DescriptorHandle* GetHandleDSV() const;
     ID3D12Resource* GetResource() const;
     D3D12_RESOURCE_DESC GetDesc() const;
@@ -32,7 +37,9 @@ public:
 
 private:
     ComPtr<ID3D12Resource>          m_pTarget;
-    DescriptorHandle*               m_pHandleDSV;
+    GpuAllocator*                   m_pAllocator;
+    GpuAllocation                   m_Allocation;
+    DescriptorId                    m_HandleDSVId;
     DescriptorPool*                 m_pPoolDSV;
     D3D12_DEPTH_STENCIL_VIEW_DESC   m_ViewDesc;
 
@@ -2,8 +2,15 @@
 
 #include <d3d12.h>
 #include <atomic>
+#include <mutex>
+#include <vector>
 #include <ComPtr.h>
 #include <Pool.h>
+#include <LockFreePool.h>
+#include <MagazinePool.h>
+#include <SlotHandle.h>
+#include <RangeAllocator.h>
+#include <RetireQueue.h>
 
 class DescriptorHandle
 {
@@ -22,6 +29,27 @@ public:
     }
 };
 
+// Generational id of a handle allocated from a DescriptorPool.
+// Unlike a raw DescriptorHandle*, an id kept after the handle was freed
+// resolves to nullptr instead of aliasing the descriptor that reused the slot.
+typedef SlotHandle DescriptorId;
+
+// Contiguous descriptors in the shader-visible heap, for multi-descriptor tables.
+typedef RangeAllocator::Allocation DescriptorRange;
+
+// Pool of descriptors carved from pages of NumDescriptors descriptors each.
+// A new page is added when every page is full, so exhaustion costs one heap
+// creation instead of a failed allocation.
+//
+// Every page is a CPU-only heap. For shader-visible pools the pages are the
+// staging copy of the shader-visible heap: views are written through
+// HandleCPU into the page and Commit() copies them to the shader-visible heap.
+// Once pages outgrow the shader-visible heap, Rehome() rebuilds it; until
+// then handles on the new pages have no GPU handle.
+//
+// Shader-visible pools also hand out contiguous ranges (AllocRange). Ranges
+// live in a region after the pages, are filled by copying existing
+// descriptors into them, and follow the same Commit()/Rehome() rules.
 class DescriptorPool
 {
 public:
@@ -34,33 +62,223 @@ public:
         POOL_COUNT = 4,
     };
 
+    enum ALLOC_MODE
+    {
+        ALLOC_MODE_LOCK      = 0,   // Pool<T>, every Alloc/Free takes a mutex
+        ALLOC_MODE_LOCK_FREE = 1,   // LockFreePool<T>, for pools hit by parallel loads
+        ALLOC_MODE_MAGAZINE  = 2,   // MagazinePool<T>, per-thread caches over Pool<T>
+    };
+
+    struct Stats
+    {
+        uint32_t    PageCount;          // pages in use
+        uint32_t    PageAllocCount;     // pages added on exhaustion
+        uint32_t    RehomeCount;        // rebuilds of the shader-visible heap
+        uint32_t    HeapCount;          // descriptors in the shader-visible heap for pages
+        uint32_t    RangeCount;         // descriptors reserved for ranges
+        uint32_t    RangeUsedCount;     // descriptors allocated in ranges
+        uint32_t    RangeFreeBlocks;    // free blocks in the range region (fragmentation)
+        uint64_t    GrowMicroseconds;   // time spent adding pages and rehoming
+    };
+
     static void Create(
         ID3D12Device*                       pDevice,
         const D3D12_DESCRIPTOR_HEAP_DESC*   pDesc,
-        DescriptorPool**                    ppPool);
+        DescriptorPool**                    ppPool,
+        ALLOC_MODE                          mode = ALLOC_MODE_LOCK);
 
     void AddRef();
     void Release();
 
     uint32_t GetCount() const;
 
+    DescriptorId AllocId();
+    void FreeId(DescriptorId& id);
+    DescriptorHandle* GetHandle(DescriptorId id) const;
+
+    // Shader-visible pools only: queues the descriptor for the next Commit().
+    // Call after writing a view through HandleCPU, including when a view is
+    // re-created into a handle that is already in use.
+    void MarkDirty(DescriptorId id);
+    void MarkDirty(const DescriptorHandle* pHandle);
+
     DescriptorHandle* AllocHandle();
     void FreeHandle(DescriptorHandle*& pHandle);
 
+    // Allocates count handles in one pool operation, for loaders creating many
+    // SRVs at once. Either all handles are allocated or none (returns false).
+    bool AllocHandles(uint32_t count, DescriptorHandle** ppHandles);
+    void FreeHandles(DescriptorHandle** ppHandles, uint32_t count);
+
+    // ALLOC_MODE_MAGAZINE only: returns handles cached by the calling thread.
+    // Loader threads should call this before they exit.
+    void FlushThreadCache();
+
+    // Shader-visible pools only: allocates count contiguous descriptors. The
+    // range region grows on demand; a grown region is usable after Rehome().
+    bool AllocRange(uint32_t count, DescriptorRange& range);
+    void FreeRange(DescriptorRange& range);
+
+    // Copies count CPU-only descriptors (e.g. handles of this pool) into the
+    // range starting at index, with a single CopyDescriptors call.
+    void CopyToRange(
+        const DescriptorRange&              range,
+        uint32_t                            index,
+        uint32_t                            count,
+        const D3D12_CPU_DESCRIPTOR_HANDLE*  pSrcHandles);
+
+    // Fills rangeCount whole ranges from pSrcHandles (the ranges' counts summed,
+    // in order) with a single CopyDescriptors call.
+    void CopyToRanges(
+        const DescriptorRange*              pRanges,
+        uint32_t                            rangeCount,
+        const D3D12_CPU_DESCRIPTOR_HANDLE*  pSrcHandles);
+
+    // GPU handle of the first descriptor, or a null handle until the range is
+    // covered by the shader-visible heap.
+    D3D12_GPU_DESCRIPTOR_HANDLE GetRangeHandleGPU(const DescriptorRange& range) const;
+
+    // CPU handle of the range's copy in the shader-visible heap, for views that
+    // are written there directly. Such writes bypass the CPU-only mirror, so
+    // they are lost on the next Rehome(); only use it for per-frame data.
+    D3D12_CPU_DESCRIPTOR_HANDLE GetRangeHandleCPU(const DescriptorRange& range) const;
+
+    // Shader-visible pools only: copies the descriptors allocated since the
+    // last call and those marked with MarkDirty() from the pages to the
+    // shader-visible heap. Call once per frame before recording. Not thread
+    // safe: the caller must ensure no other thread creates views, allocates
+    // or calls MarkDirty() during the call, or a view written meanwhile may
+    // be copied half-written and not copied again.
+    void Commit();
+
+    // true if some page or range is not covered by the shader-visible heap.
+    bool NeedsRehome() const;
+
+    // Drops trailing pages without live handles (handles cached by threads in
+    // ALLOC_MODE_MAGAZINE count as live; ids of dropped pages stay stale)
+    // and, for shader-visible pools, rebuilds the shader-visible heap to cover
+    // every page (at least minCount descriptors), rounded up to a power-of-two
+    // number of pages so that growing to N pages costs O(log N) rehomes. GPU
+    // handles of live handles change. No other thread may use the pool during the call. The current
+    // heap is kept alive in pRetire until retireValue completes; without a
+    // queue the GPU must no longer use it.
+    bool Rehome(uint32_t minCount = 0, RetireQueue* pRetire = nullptr, uint64_t retireValue = 0);
+
     uint32_t GetAvailableHandleCount() const;
     uint32_t GetAllocatedHandleCount() const;
     uint32_t GetHandleCount() const;
     ID3D12DescriptorHeap* const GetHeap() const;
+    ALLOC_MODE GetAllocMode() const;
+    bool IsShaderVisible() const;
+    uint32_t GetDescriptorSize() const;
+    Stats GetStats() const;
 
 private:
+    struct IdSlot
+    {
+        std::atomic<uint32_t>   Generation;
+        DescriptorHandle*       pHandle;
+
+        IdSlot()
+            : Generation(1)
+            , pHandle(nullptr)
+        {
+        }
+    };
+
+    // Handles are stored in SoA pools: the handles themselves are packed in one
+    // cache-line aligned array and the free-list links live elsewhere, so
+    // resolving handles never touches allocator metadata.
+    typedef Pool<DescriptorHandle, POOL_LAYOUT_SOA>         HandlePool;
+    typedef LockFreePool<DescriptorHandle, POOL_LAYOUT_SOA> LockFreeHandlePool;
+    typedef MagazinePool<DescriptorHandle, HandlePool>      MagazineHandlePool;
+
+    struct Page
+    {
+        ComPtr<ID3D12DescriptorHeap>    pHeap;      // CPU-only
+        D3D12_CPU_DESCRIPTOR_HANDLE     HandleCPU;
+        uint32_t                        BaseIndex;
+        HandlePool*                     pPool;          // ALLOC_MODE_LOCK only
+        LockFreeHandlePool*             pLockFreePool;  // ALLOC_MODE_LOCK_FREE only
+        MagazineHandlePool*             pMagazinePool;  // ALLOC_MODE_MAGAZINE only
+        IdSlot*                         pIdSlots;   // owned by the pool, see m_pIdSlots
+        std::atomic<uint64_t>*          pDirty;     // shader-visible pools only, one bit per descriptor
+
+        Page()
+            : pHeap()
+            , HandleCPU()
+            , BaseIndex(0)
+            , pPool(nullptr)
+            , pLockFreePool(nullptr)
+            , pMagazinePool(nullptr)
+            , pIdSlots(nullptr)
+            , pDirty(nullptr)
+        {
+        }
+
+        ~Page()
+        {
+            delete pPool;
+            delete pLockFreePool;
+            delete pMagazinePool;
+            delete[] pDirty;
+        }
+    };
+
+    static const uint32_t MaxPageCount  = 64;
+    static const uint32_t MinRangeCount = 256;
+
     std::atomic<uint32_t>           m_RefCount;
-    Pool<DescriptorHandle>          m_Pool;
-    ComPtr<ID3D12DescriptorHeap>    m_pHeap;
+    ALLOC_MODE                      m_Mode;
+    ComPtr<ID3D12Device>            m_pDevice;
+    D3D12_DESCRIPTOR_HEAP_DESC      m_PageDesc;
+    Page*                           m_pPages[MaxPageCount];
+    IdSlot*                         m_pIdSlots[MaxPageCount];   // kept when a page is dropped
+    std::atomic<uint32_t>           m_PageCount;
+    std::atomic<uint32_t>           m_AllocPage;
+    uint32_t                        m_PageSize;
+    uint32_t                        m_MaxPageCount;
+    bool                            m_ShaderVisible;
+    ComPtr<ID3D12DescriptorHeap>    m_pHeap;        // shader-visible pools only
+    D3D12_CPU_DESCRIPTOR_HANDLE     m_HeapCPU;
+    D3D12_GPU_DESCRIPTOR_HANDLE     m_HeapGPU;
+    uint32_t                        m_HeapCount;        // descriptors for pages in m_pHeap
+    uint32_t                        m_HeapLimit;
     uint32_t                        m_DescriptorSize;
+    Stats                           m_Stats;
+    mutable std::mutex              m_GrowMutex;
+
+    RangeAllocator                  m_Ranges;
+    ComPtr<ID3D12DescriptorHeap>    m_pRangeHeap;       // CPU-only copy of the range region
+    D3D12_CPU_DESCRIPTOR_HANDLE     m_RangeCPU;
+    uint32_t                        m_RangeHeapCount;   // range region size in m_pHeap
+    std::vector<DescriptorRange>    m_DirtyRanges;
+    mutable std::mutex              m_RangeMutex;
 
     DescriptorPool();
     ~DescriptorPool();
 
+    Page* CreatePage(uint32_t pageIndex);
+    bool AddPage(uint32_t pageCount);
+    uint32_t GetUsedCount(const Page* pPage) const;
+    uint32_t GetReservedCount(const Page* pPage) const;
+    uint32_t GetDirtyWordCount() const;
+
+    void InitHandle(Page* pPage, uint32_t index, DescriptorHandle* pHandle);
+    void SetDirty(Page* pPage, uint32_t index);
+    D3D12_GPU_DESCRIPTOR_HANDLE GetHeapHandleGPU(uint32_t index) const;
+    DescriptorHandle* AllocSlot(uint32_t& index);
+    DescriptorHandle* AllocFromPage(Page* pPage, uint32_t& index);
+    uint32_t AllocFromPage(Page* pPage, uint32_t count, DescriptorHandle** ppHandles);
+    IdSlot* GetIdSlot(uint32_t index) const;
+    Page* FindPage(const DescriptorHandle* pHandle, uint32_t& index) const;
+    void RetireHandle(Page* pPage, uint32_t index);
+    void FreeToPage(Page* pPage, DescriptorHandle* pHandle);
+    void FreeToPage(Page* pPage, DescriptorHandle** ppHandles, uint32_t count);
+    void CopyToHeap(const Page* pPage, uint32_t index, uint32_t count);
+    bool GrowRanges(uint32_t count);
+    void CommitRanges();
+
     DescriptorPool(const DescriptorPool&) = delete;
     void operator = (const DescriptorPool&) = delete;
 };
\ No newline at end of file
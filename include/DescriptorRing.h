@@ -0,0 +1,44 @@
+#pragma once
+
+#include <d3d12.h>
+#include <DescriptorPool.h>
+#include <FrameRing.h>
+
+// Shader-visible descriptors that only live for one frame. A contiguous range
+// of the pool is split into one partition per frame resource; allocating is a
+// pointer bump and a partition is recycled once the fence value of the frame
+// that last used it has completed. Nothing goes through the pool's free lists.
+class DescriptorRing
+{
+public:
+    DescriptorRing();
+    ~DescriptorRing();
+
+    bool Init(DescriptorPool* pPool, uint32_t countPerFrame, uint32_t frameCount);
+    void Term();
+
+    // Call after DescriptorPool::Rehome() for the frame, since rehoming moves
+    // the range inside the shader-visible heap.
+    bool BeginFrame(uint32_t frameIndex, uint64_t completedValue);
+    void EndFrame(uint64_t fenceValue);
+
+    bool Alloc(
+        uint32_t                        count,
+        D3D12_CPU_DESCRIPTOR_HANDLE&    handleCPU,
+        D3D12_GPU_DESCRIPTOR_HANDLE&    handleGPU);
+
+    uint64_t GetFenceValue(uint32_t frameIndex) const;
+    uint32_t GetUsedCount() const;
+    uint32_t GetPeakCount() const;
+
+private:
+    DescriptorPool*             m_pPool;
+    DescriptorRange             m_Range;
+    FrameRing                   m_Ring;
+    D3D12_CPU_DESCRIPTOR_HANDLE m_BaseCPU;
+    D3D12_GPU_DESCRIPTOR_HANDLE m_BaseGPU;
+    uint32_t                    m_DescriptorSize;
+
+    DescriptorRing(const DescriptorRing&) = delete;
+    void operator = (const DescriptorRing&) = delete;
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <d3d12.h>
+#include <cstdint>
 #include <ComPtr.h>
 
 class Fence
@@ -14,9 +15,15 @@ public:
     void Wait(ID3D12CommandQueue* pQueue, UINT timeout);
     void Sync(ID3D12CommandQueue* pQueue);
 
-    // FrameResource 
-    void Wait(UINT64 fenceValue, UINT timeout);
+    // FrameResource 용
+    // Returns the microseconds the calling thread was blocked.
+    uint64_t Wait(UINT64 fenceValue, UINT timeout);
     UINT64 Signal(ID3D12CommandQueue* pQueue);
+    UINT64 GetCompletedValue() const;
+    UINT64 GetNextValue() const;
+
+    // For ID3D12CommandQueue::Wait() on another queue.
+    ID3D12Fence* GetFence() const;
 
 private:
     ComPtr<ID3D12Fence> m_pFence;
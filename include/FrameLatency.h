@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+
+enum LATENCY_MODE
+{
+    LATENCY_MODE_FIXED = 0,     // the requested number of frames in flight
+    LATENCY_MODE_ADAPTIVE,      // the fewest frames in flight that keep the GPU busy
+};
+
+// Chooses how many frames the CPU may record ahead of the GPU.
+//
+// Adaptive mode looks at two things per frame: how long the CPU blocked on
+// the fence of the frame resource it is about to reuse, and how many earlier
+// frames the GPU still had queued when the frame was submitted. A GPU that
+// had drained its queue right after the CPU blocked is starving because the
+// pipeline is too shallow, so the depth goes up and the starved depth is not
+// retried for a while. Otherwise the depth goes down one step per window to
+// cut input latency.
+//
+// Device independent and not thread safe.
+class FrameLatency
+{
+public:
+    FrameLatency();
+    ~FrameLatency();
+
+    // maxDepth is the number of frame resources available.
+    bool Init(uint32_t maxDepth, LATENCY_MODE mode, uint32_t depth);
+    void Term();
+
+    // depth is clamped to [1, maxDepth]. Adaptive mode starts from it.
+    void SetMode(LATENCY_MODE mode, uint32_t depth);
+
+    // Once per frame, with the time spent in the frame resource wait.
+    void OnWait(uint64_t waitMicroseconds);
+
+    // Once per frame at submission, with the count of earlier frames the GPU
+    // had not completed yet.
+    void OnSubmit(uint32_t pendingFrames);
+
+    uint32_t GetDepth() const;
+    uint32_t GetMaxDepth() const;
+    LATENCY_MODE GetMode() const;
+
+private:
+    // Frames per adaptive decision.
+    static const uint32_t WindowFrames = 64;
+
+    // Starved frames per window that make the depth go up.
+    static const uint32_t StarveLimit = WindowFrames / 16;
+
+    // Windows to stay above a depth that starved before trying it again.
+    static const uint32_t CooldownWindows = 8;
+
+    // Shorter waits are scheduling noise, not a GPU bound CPU.
+    static const uint64_t WaitThresholdMicroseconds = 100;
+
+    LATENCY_MODE    m_Mode;
+    uint32_t        m_MaxDepth;
+    uint32_t        m_Depth;
+    bool            m_Waited;
+    uint32_t        m_FrameCount;
+    uint32_t        m_StarvedCount;
+    uint32_t        m_Cooldown;
+
+    void ResetWindow();
+
+    FrameLatency(const FrameLatency&) = delete;
+    void operator = (const FrameLatency&) = delete;
+};
\ No newline at end of file
@@ -4,7 +4,8 @@
 #include <DirectXMath.h>
 #include <ComPtr.h>
 #include <Material.h>
-#include <ConstantBuffer.h>
+#include <UploadBuffer.h>
+#include <vector>
 
 struct TransformBuffer
 {
@@ -20,13 +21,37 @@ struct TransformBuffer
     }
 };
 
+enum OBJECT_FLAG
+{
+    OBJECT_FLAG_NONE   = 0,
+    OBJECT_FLAG_SHADOW = 0x1,   // unlit; drawn black
+};
+
+// Per-object data. Everything shared by the pass lives in PassConstant.
+struct ObjectBuffer
+{
+    DirectX::XMMATRIX World;
+    uint32_t          MaterialIndex;
+    uint32_t          Flags;
+    uint32_t          pad[2];
+
+    ObjectBuffer()
+    {
+        World         = DirectX::XMMatrixIdentity();
+        MaterialIndex = 0;
+        Flags         = OBJECT_FLAG_NONE;
+        pad[0]        = 0;
+        pad[1]        = 0;
+    }
+};
+
 struct LightItem
 {
-    DirectX::XMFLOAT3 Color;     //  
-    float Range;                 // Ʈ/ƮƮ 
-    DirectX::XMFLOAT3 Direction; // 𷺼ų/ƮƮ 
-    float SpotPower;             // ƮƮ 
-    DirectX::XMFLOAT3 Position;  // ƮƮ 
+    DirectX::XMFLOAT3 Color;     // 빛의 세기
+    float Range;                 // 포인트/스포트라이트 전용
+    DirectX::XMFLOAT3 Direction; // 디렉셔널/스포트라이트 전용
+    float SpotPower;             // 스포트라이트 전용
+    DirectX::XMFLOAT3 Position;  // 포인트라이트 전용
     float pad;
 
     LightItem()
@@ -53,18 +78,30 @@ struct MaterialBuffer
     float             Alpha;
     DirectX::XMFLOAT3 Specular;
     float             Shininess;
+    uint32_t          DiffuseMapIndex;  // bindless 용 heap index
+    uint32_t          NormalMapIndex;
+    uint32_t          SpecularMapIndex;
+    uint32_t          pad;
 
     MaterialBuffer()
     {
-        Diffuse   = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
-        Alpha     = 0.0f;
-        Specular  = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
-        Shininess = 0.0f;
+        Diffuse          = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+        Alpha            = 0.0f;
+        Specular         = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+        Shininess        = 0.0f;
+        DiffuseMapIndex  = 0;
+        NormalMapIndex   = 0;
+        SpecularMapIndex = 0;
+        pad              = 0;
     }
 };
 
+// Uploaded once per frame and bound as a root CBV, so the layout follows the
+// HLSL constant buffer packing rules.
 struct PassConstant
 {
+    DirectX::XMMATRIX ViewProj;
+    LightBuffer       Lights;
     alignas(16) DirectX::XMFLOAT3 CameraPosition;
     alignas(16) DirectX::XMFLOAT4 AmbientLight;
     int DiffuseMapUsable;
@@ -74,6 +111,7 @@ struct PassConstant
 
     PassConstant()
     {
+        ViewProj           = DirectX::XMMatrixIdentity();
         CameraPosition     = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
         AmbientLight       = DirectX::XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f);
         DiffuseMapUsable   = 0;
@@ -86,24 +124,41 @@ struct PassConstant
 class FrameResource
 {
 public:
-    FrameResource(
-        ID3D12Device* pDevice,
-        DescriptorPool** pPool,
-        D3D12_COMMAND_LIST_TYPE type,
-        int count);
-    FrameResource(const FrameResource& rhs) = default;
-    FrameResource& operator=(const FrameResource& rhs) = default;
+    FrameResource(ID3D12Device* pDevice, D3D12_COMMAND_LIST_TYPE type, uint32_t recordCount);
     ~FrameResource();
 
 public:
     ComPtr<ID3D12CommandAllocator> Allocator;
 
-    // GPU ־  óϴ     ڿ CPU Ʈ
-    //     FrameResource Ŭ  ڿ Ҵ
-    ConstantBuffer Transform;
-    ConstantBuffer Light;
-    ConstantBuffer Material;
-    ConstantBuffer Pass;
+    // One per thread recording render items in parallel.
+    std::vector<ComPtr<ID3D12CommandAllocator>> RecordAllocators;
+
+    // GPU가 주어진 명령을 처리하는 동안 다음 프레임을 위한 자원을 CPU가 업데이트
+    // 할 수 없기 때문에 FrameResource 클래스에서 별도로 자원을 할당함
+    UploadBuffer Object;      // ObjectBuffer per render item
+    UploadBuffer Material;    // MaterialBuffer per material
+
+    // Renderer version each buffer was last brought up to date with; only
+    // data changed after it is copied when this frame resource comes around.
+    uint64_t ObjectVersion;
+    uint64_t MaterialVersion;
+
+    // One PassConstant, written to the upload ring every frame.
+    D3D12_GPU_VIRTUAL_ADDRESS Pass;
+
+    // DataIdx of every visible item in draw order, written to the upload ring
+    // every frame. Instance i of a draw reads its object index from here.
+    ID3D12Resource* pInstanceBuffer;    // upload ring buffer, nullptr without visible items
+    UINT64          InstanceOffset;
+    uint32_t        InstanceCount;
+
+    // SRVs of Object, Material and the instances (t0 to t2), written to the
+    // descriptor ring every frame.
+    D3D12_GPU_DESCRIPTOR_HANDLE BufferTable;
 
     UINT64 Fence;
+
+private:
+    FrameResource(const FrameResource&) = delete;
+    void operator = (const FrameResource&) = delete;
 };
\ No newline at end of file
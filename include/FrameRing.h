@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Linear allocator over [0, partitionSize * partitionCount) with one partition
+// per frame in flight. Allocation within a frame is a bump of the head offset.
+// A partition is reused only once the fence value recorded by EndFrame() for
+// it has completed, so nothing here touches a device: callers pass the fence
+// values in.
+class FrameRing
+{
+public:
+    FrameRing();
+    ~FrameRing();
+
+    bool Init(uint32_t partitionSize, uint32_t partitionCount);
+    void Term();
+
+    // Fails if the partition's last frame has not completed on the GPU yet.
+    bool BeginFrame(uint32_t partition, uint64_t completedValue);
+    void EndFrame(uint64_t fenceValue);
+
+    // alignment must be a power of two.
+    bool Alloc(uint32_t count, uint32_t alignment, uint32_t& offset);
+
+    uint64_t GetFenceValue(uint32_t partition) const;
+    uint32_t GetUsedCount() const;
+    uint32_t GetPeakCount() const;
+    uint32_t GetPartitionSize() const;
+    uint32_t GetPartitionCount() const;
+
+private:
+    std::vector<uint64_t>   m_FenceValues;
+    uint32_t                m_PartitionSize;
+    uint32_t                m_Partition;
+    uint32_t                m_Head;         // relative to the current partition
+    uint32_t                m_Peak;
+    bool                    m_Recording;
+
+    FrameRing(const FrameRing&) = delete;
+    void operator = (const FrameRing&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <DirectXMath.h>
+#include <DirectXCollision.h>
+
+// World-space AABBs kept as structure of arrays, so Cull() tests four boxes
+// per iteration with DirectXMath vector ops. Boxes are stored as center and
+// extents; a box is outside when it lies fully behind any frustum plane.
+//
+// SetBox() may be called from several threads for distinct indices.
+// Device independent.
+class FrustumCuller
+{
+public:
+    FrustumCuller();
+    ~FrustumCuller();
+
+    // Keeps the boxes below count.
+    void Resize(uint32_t count);
+    void Term();
+
+    void SetBox(uint32_t index, const DirectX::XMFLOAT3& center, const DirectX::XMFLOAT3& extents);
+
+    // Transforms a local box by world and stores the AABB around the result.
+    // The corners are projected, so world may be any matrix with w > 0,
+    // e.g. a planar shadow matrix.
+    void SetBox(uint32_t index, const DirectX::BoundingBox& local, DirectX::FXMMATRIX world);
+
+    // Planes are taken from a row-vector view-projection matrix with
+    // D3D clip space (0 <= z <= w).
+    void SetFrustum(DirectX::FXMMATRIX viewProj);
+
+    // Writes the indices in [begin, end) of boxes that intersect the frustum
+    // to pVisible, in order, and returns their count. Safe to call from
+    // several threads at once.
+    uint32_t Cull(uint32_t begin, uint32_t end, uint32_t* pVisible) const;
+
+    DirectX::XMFLOAT3 GetCenter(uint32_t index) const;
+    uint32_t GetCount() const;
+
+private:
+    static const uint32_t PlaneCount = 6;
+
+    // Padded to a multiple of four; the padding is never reported visible.
+    std::vector<float>  m_CenterX;
+    std::vector<float>  m_CenterY;
+    std::vector<float>  m_CenterZ;
+    std::vector<float>  m_ExtentX;
+    std::vector<float>  m_ExtentY;
+    std::vector<float>  m_ExtentZ;
+    uint32_t            m_Count;
+
+    DirectX::XMFLOAT4   m_Planes[PlaneCount];
+
+    FrustumCuller(const FrustumCuller&) = delete;
+    void operator = (const FrustumCuller&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <RangeAllocator.h>
+
+// Vertex and index ranges of one mesh inside a GeometryBuffer.
+struct GeometryRange
+{
+    uint32_t                    Page;
+    RangeAllocator::Allocation  Vertices;
+    RangeAllocator::Allocation  Indices;
+
+    GeometryRange()
+        : Page(UINT32_MAX)
+    {
+    }
+
+    bool IsValid() const
+    {
+        return Page != UINT32_MAX;
+    }
+
+    // Arguments of DrawIndexedInstanced().
+    uint32_t GetBaseVertex() const { return Vertices.Offset; }
+    uint32_t GetFirstIndex() const { return Indices.Offset; }
+    uint32_t GetIndexCount() const { return Indices.Count; }
+};
+
+// Bookkeeping of the GeometryBuffer pages: a vertex and an index
+// RangeAllocator per page. A mesh gets both of its ranges from the same page.
+// The allocator only hands out page indices and offsets; the owner creates
+// the buffers of a page before AddPage().
+//
+// Device independent and not thread safe.
+class GeometryAllocator
+{
+public:
+    GeometryAllocator();
+    ~GeometryAllocator();
+
+    // Size of a regular page.
+    bool Init(uint32_t vertexCount, uint32_t indexCount);
+    void Term();
+
+    // Sub-allocates from the existing pages only, first page first; returns
+    // false if none has room for both ranges.
+    bool Alloc(uint32_t vertexCount, uint32_t indexCount, GeometryRange& range);
+    void Free(GeometryRange& range);
+
+    // Size of the page AddPage() must be given so that the request fits:
+    // a regular page unless the mesh is larger.
+    void GetPageSizeFor(
+        uint32_t vertexCount,
+        uint32_t indexCount,
+        uint32_t& pageVertexCount,
+        uint32_t& pageIndexCount) const;
+
+    // Appends an empty page; its index is the previous page count.
+    bool AddPage(uint32_t vertexCount, uint32_t indexCount);
+
+    uint32_t GetPageCount() const;
+    uint32_t GetUsedVertexCount() const;
+    uint32_t GetUsedIndexCount() const;
+
+private:
+    struct Page
+    {
+        RangeAllocator  Vertices;
+        RangeAllocator  Indices;
+    };
+
+    std::vector<Page*>  m_Pages;
+    uint32_t            m_VertexCount;      // size of a regular page
+    uint32_t            m_IndexCount;
+
+    GeometryAllocator(const GeometryAllocator&) = delete;
+    void operator = (const GeometryAllocator&) = delete;
+};
\ No newline at end of file
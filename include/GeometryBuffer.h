@@ -0,0 +1,67 @@
+#pragma once
+
+#include <d3d12.h>
+#include <cstdint>
+#include <vector>
+#include <GeometryAllocator.h>
+#include <VertexBuffer.h>
+#include <IndexBuffer.h>
+#include <UploadBatch.h>
+
+// Static geometry shared by all meshes. Vertices and indices are
+// sub-allocated from a few large pages by GeometryAllocator, so each page is
+// bound once and meshes are drawn with base vertex / first index offsets.
+// A mesh that does not fit in any page gets a page of its own size.
+//
+// Freeing a range makes it reusable immediately; the caller must make sure
+// the GPU no longer reads it.
+class GeometryBuffer
+{
+public:
+    static const uint32_t DefaultVertexCount = 256 * 1024;
+    static const uint32_t DefaultIndexCount  = 1024 * 1024;
+
+    GeometryBuffer();
+    ~GeometryBuffer();
+
+    bool Init(
+        GpuAllocator* pAllocator,
+        uint32_t stride,
+        uint32_t vertexCount = DefaultVertexCount,
+        uint32_t indexCount = DefaultIndexCount);
+    void Term();
+
+    bool Alloc(uint32_t vertexCount, uint32_t indexCount, GeometryRange& range);
+    void Free(GeometryRange& range);
+
+    // Records the copy of the range's data into pBatch.
+    bool Upload(
+        UploadBatch* pBatch,
+        const GeometryRange& range,
+        const void* pVertices,
+        const uint32_t* pIndices);
+
+    // Binds the vertex and index buffer of a page.
+    void Bind(ID3D12GraphicsCommandList* pCmdList, uint32_t page) const;
+
+    uint32_t GetPageCount() const;
+    uint32_t GetUsedVertexCount() const;
+    uint32_t GetUsedIndexCount() const;
+
+private:
+    struct Page
+    {
+        VertexBuffer    VB;
+        IndexBuffer     IB;
+    };
+
+    GpuAllocator*       m_pAllocator;
+    std::vector<Page*>  m_Pages;            // indexed like the m_Ranges pages
+    GeometryAllocator   m_Ranges;
+    uint32_t            m_Stride;
+
+    bool AddPage(uint32_t vertexCount, uint32_t indexCount);
+
+    GeometryBuffer(const GeometryBuffer&) = delete;
+    void operator = (const GeometryBuffer&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <d3d12.h>
+#include <ComPtr.h>
+#include <vector>
+#include <HeapBlockAllocator.h>
+
+// Heaps are split by what they may hold, which resource heap tier 1 requires.
+enum HEAP_POOL
+{
+    HEAP_POOL_BUFFER = 0,   // DEFAULT heap, buffers
+    HEAP_POOL_TEXTURE,      // DEFAULT heap, non render target / depth textures
+    HEAP_POOL_TARGET,       // DEFAULT heap, render target and depth textures
+    HEAP_POOL_UPLOAD,       // UPLOAD heap, buffers
+    HEAP_POOL_COUNT
+};
+
+struct GpuAllocation
+{
+    HEAP_POOL                       Pool;
+    HeapBlockAllocator::Allocation  Block;
+
+    GpuAllocation()
+        : Pool(HEAP_POOL_COUNT)
+    {
+    }
+
+    // False for resources that were created committed.
+    bool IsValid() const
+    {
+        return Pool != HEAP_POOL_COUNT && Block.IsValid();
+    }
+};
+
+// Creates resources as placed resources in large ID3D12Heaps, one set of
+// heaps per HEAP_POOL. The sub-allocation bookkeeping is HeapBlockAllocator.
+// Resources that cannot be placed (other heap types, MSAA alignment) fall
+// back to committed resources with an invalid GpuAllocation.
+//
+// A resource must be released before its allocation is freed, and the GPU
+// must no longer use it: the memory is reused right away.
+class GpuAllocator
+{
+public:
+    static const UINT64 DefaultBlockSize = 64 * 1024 * 1024;
+
+    GpuAllocator();
+    ~GpuAllocator();
+
+    // budget caps the total size of all heaps; 0 means unlimited.
+    bool Init(ID3D12Device* pDevice, UINT64 budget = 0, UINT64 blockSize = DefaultBlockSize);
+    void Term();
+
+    HRESULT CreateResource(
+        D3D12_HEAP_TYPE             heapType,
+        const D3D12_RESOURCE_DESC*  pDesc,
+        D3D12_RESOURCE_STATES       initialState,
+        const D3D12_CLEAR_VALUE*    pClearValue,
+        GpuAllocation&              allocation,
+        ID3D12Resource**            ppResource);
+
+    void Free(GpuAllocation& allocation);
+
+    HeapBlockAllocator::Stats GetStats(HEAP_POOL pool) const;
+    HeapBlockAllocator::Stats GetTotalStats() const;
+    UINT64 GetBudget() const;
+
+private:
+    // Empty heaps kept per pool instead of being destroyed.
+    static const uint32_t SpareHeapCount = 1;
+
+    ComPtr<ID3D12Device>                m_pDevice;
+    HeapBlockAllocator                  m_Blocks[HEAP_POOL_COUNT];
+    std::vector<ComPtr<ID3D12Heap>>     m_Heaps[HEAP_POOL_COUNT];
+    UINT64                              m_Budget;
+
+    static bool GetPool(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC* pDesc, HEAP_POOL& pool);
+    bool AddHeap(HEAP_POOL pool, UINT64 size);
+
+    GpuAllocator(const GpuAllocator&) = delete;
+    void operator = (const GpuAllocator&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <RangeAllocator.h>
+
+// Bookkeeping for sub-allocating large memory blocks (e.g. ID3D12Heap).
+// Each block is split into granularity sized units managed by a
+// RangeAllocator. The allocator only hands out block indices and byte
+// offsets; the owner creates the memory behind a block after AddBlock() and
+// destroys it when ReleaseEmptyBlocks() reports the block.
+//
+// Device independent and not thread safe.
+class HeapBlockAllocator
+{
+public:
+    static const uint32_t InvalidBlock = uint32_t(-1);
+
+    struct Allocation
+    {
+        uint32_t                    Block;
+        uint64_t                    Offset;     // in bytes from the start of the block
+        uint64_t                    Size;       // requested size
+        RangeAllocator::Allocation  Range;
+
+        Allocation()
+            : Block(InvalidBlock)
+            , Offset(0)
+            , Size(0)
+        {
+        }
+
+        bool IsValid() const
+        {
+            return Block != InvalidBlock;
+        }
+    };
+
+    struct Stats
+    {
+        uint64_t    ReservedBytes;      // total size of all blocks
+        uint64_t    UsedBytes;          // allocated units, alignment padding included
+        uint64_t    LargestFreeBytes;   // largest single free range over all blocks
+        uint32_t    BlockCount;
+        uint32_t    AllocationCount;
+        uint32_t    FreeRangeCount;
+
+        // 1 - largest free range / total free: 0 when all free space is one range.
+        float GetFragmentation() const
+        {
+            const auto freeBytes = ReservedBytes - UsedBytes;
+            return (freeBytes > 0) ? 1.0f - float(double(LargestFreeBytes) / double(freeBytes)) : 0.0f;
+        }
+    };
+
+    HeapBlockAllocator();
+    ~HeapBlockAllocator();
+
+    // granularity must be a power of two. Blocks are blockSize bytes unless a
+    // single request needs more.
+    bool Init(uint64_t blockSize, uint64_t granularity);
+    void Term();
+
+    // Sub-allocates from the existing blocks only; returns false if none has
+    // room. alignment must be a power of two and is relative to the block start.
+    bool Alloc(uint64_t size, uint64_t alignment, Allocation& allocation);
+    void Free(Allocation& allocation);
+
+    // Size of the block AddBlock() must be given so that the request fits.
+    uint64_t GetBlockSizeFor(uint64_t size, uint64_t alignment) const;
+
+    // Registers a new empty block and returns its index. Indices of released
+    // blocks are reused.
+    uint32_t AddBlock(uint64_t size);
+
+    // Unregisters empty blocks beyond keepCount, calling func(block) for each
+    // so the owner can destroy the memory. Returns the count.
+    template<typename Func>
+    uint32_t ReleaseEmptyBlocks(uint32_t keepCount, Func&& func)
+    {
+        uint32_t emptyCount = 0;
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < uint32_t(m_Blocks.size()); ++i)
+        {
+            auto& block = m_Blocks[i];
+            if (block.pRanges == nullptr || block.AllocationCount > 0)
+            {
+                continue;
+            }
+
+            if (++emptyCount <= keepCount)
+            {
+                continue;
+            }
+
+            func(i);
+            RemoveBlock(i);
+            count++;
+        }
+
+        return count;
+    }
+
+    Stats GetStats() const;
+    uint64_t GetBlockSize() const;
+    uint64_t GetGranularity() const;
+
+private:
+    struct Block
+    {
+        RangeAllocator* pRanges;        // null if the slot is unused
+        uint64_t        Size;
+        uint32_t        AllocationCount;
+    };
+
+    std::vector<Block>      m_Blocks;
+    std::vector<uint32_t>   m_FreeSlots;
+    uint64_t                m_BlockSize;
+    uint64_t                m_Granularity;
+    uint32_t                m_AllocationCount;
+
+    uint64_t GetUnitCount(uint64_t size, uint64_t alignment) const;
+    void RemoveBlock(uint32_t index);
+
+    HeapBlockAllocator(const HeapBlockAllocator&) = delete;
+    void operator = (const HeapBlockAllocator&) = delete;
+};
\ No newline at end of file
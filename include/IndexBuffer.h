@@ -3,8 +3,8 @@
 #include <d3d12.h>
 #include <ComPtr.h>
 #include <cstdint>
-#include <CommandList.h>
-#include <Fence.h>
+#include <GpuAllocator.h>
+#include <UploadBatch.h>
 
 class IndexBuffer
 {
@@ -12,11 +12,10 @@ public:
     IndexBuffer();
     ~IndexBuffer();
 
+    // The initial data is copied when pBatch is submitted.
     bool Init(
-        ID3D12Device* pDevice,
-        ID3D12CommandQueue* pQueue,
-        CommandList* pCmdList,
-        Fence* pFence,
+        GpuAllocator* pAllocator,
+        UploadBatch* pBatch,
         size_t size, const uint32_t* 
         pInitData = nullptr);
 
@@ -25,10 +24,13 @@ public:
     uint32_t* Map();
     void Unmap();
 
+    ID3D12Resource* GetResource() const;
     D3D12_INDEX_BUFFER_VIEW GetView() const;
 
 private:
     ComPtr<ID3D12Resource>      m_pIB;
+    GpuAllocator*               m_pAllocator;
+    GpuAllocation               m_Allocation;
     D3D12_INDEX_BUFFER_VIEW     m_View;
 
     IndexBuffer(const IndexBuffer&) = delete;
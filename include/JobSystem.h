@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <LockFreePool.h>
+#include <WorkStealingDeque.h>
+
+// Counts the jobs started with it that have not finished yet. Waiting on a
+// counter is how callers join jobs and order dependent work.
+class JobCounter
+{
+public:
+    JobCounter()
+        : m_Pending(0)
+    {
+    }
+
+    bool IsDone() const
+    {
+        return m_Pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> m_Pending;
+
+    JobCounter(const JobCounter&) = delete;
+    void operator = (const JobCounter&) = delete;
+};
+
+// Work-stealing job scheduler. Every worker and the main thread (the one
+// that called Init) own a WorkStealingDeque: jobs are pushed to the caller's
+// own deque and idle threads steal from the others. Jobs started from any
+// other thread go through a locked queue. Wait() runs jobs until the counter
+// drops to zero, so the waiting thread helps instead of blocking. Idle
+// workers spin briefly, then sleep until a job is queued.
+class JobSystem
+{
+public:
+    typedef std::function<void()> JobFunc;
+
+    JobSystem();
+    ~JobSystem();
+
+    // workerCount 0 uses one worker per hardware thread besides the caller.
+    bool Init(uint32_t workerCount = 0);
+
+    // Every job must have finished.
+    void Term();
+
+    // pCounter may be null. The job runs right away on the calling thread
+    // when no worker exists or the queues are full.
+    void Run(JobFunc&& func, JobCounter* pCounter);
+
+    // Runs jobs on the calling thread until counter is done.
+    void Wait(JobCounter& counter);
+
+    // Calls func(begin, end) over [0, count) in chunks of grainSize and
+    // returns once every chunk has run; the calling thread takes part.
+    template<typename Func>
+    void ParallelFor(uint32_t count, uint32_t grainSize, Func&& func)
+    {
+        if (grainSize == 0)
+        {
+            grainSize = 1;
+        }
+
+        if (count <= grainSize || m_Workers.empty())
+        {
+            if (count > 0)
+            {
+                func(0u, count);
+            }
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = grainSize; begin < count; begin += grainSize)
+        {
+            const auto end = (count - begin > grainSize) ? begin + grainSize : count;
+            Run([&func, begin, end]() { func(begin, end); }, &counter);
+        }
+
+        func(0u, grainSize);
+        Wait(counter);
+    }
+
+    // Workers plus the main thread.
+    uint32_t GetThreadCount() const;
+
+private:
+    struct Job
+    {
+        JobFunc     Func;
+        JobCounter* pCounter;
+    };
+
+    static const uint32_t MaxJobCount    = 4096;
+    static const uint32_t DequeCapacity  = 1024;
+    static const uint32_t IdleSpinCount  = 64;
+    static const uint32_t InvalidThread  = uint32_t(-1);
+
+    LockFreePool<Job>                       m_JobPool;
+    std::vector<WorkStealingDeque<Job>*>    m_Deques;   // [0] belongs to the main thread
+    std::vector<std::thread>                m_Workers;
+
+    std::mutex                              m_InjectMutex;
+    std::deque<Job*>                        m_Injected;
+    std::atomic<uint32_t>                   m_InjectedCount;
+
+    std::mutex                              m_SleepMutex;
+    std::condition_variable                 m_WakeCond;
+    uint64_t                                m_WakeEpoch;    // guarded by m_SleepMutex
+    std::atomic<uint32_t>                   m_SleepingCount;
+    std::atomic<bool>                       m_Stop;
+
+    void WorkerMain(uint32_t index);
+    uint32_t GetThreadIndex() const;
+    Job* FindJob(uint32_t index);
+    Job* Sleep(uint32_t index);
+    void Wake();
+    void Execute(Job* pJob);
+
+    JobSystem(const JobSystem&) = delete;
+    void operator = (const JobSystem&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,373 @@
+#ifndef _LOCK_FREE_POOL_H_
+#define _LOCK_FREE_POOL_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cassert>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <Pool.h>
+
+// Lock-free counterpart of Pool<T> with the same interface.
+// The free list is an index based stack; the upper 32 bits of the head carry
+// a tag that is bumped on every update, so a pop racing with another thread's
+// pop/push of the same item fails its CAS instead of corrupting the list (ABA).
+// Unlike Pool<T>, no linked list of active items is kept.
+template<typename T, POOL_LAYOUT Layout = POOL_LAYOUT_AOS>
+class LockFreePool
+{
+public:
+    LockFreePool()
+        : m_pBuffer(nullptr)
+        , m_pValues(nullptr)
+        , m_Head(MakeHead(InvalidIndex, 0))
+        , m_Capacity(0)
+        , m_Count(0)
+    {
+    }
+
+    ~LockFreePool()
+    {
+        Term();
+    }
+
+    bool Init(uint32_t count)
+    {
+        if (count == 0 || count == InvalidIndex)
+        {
+            return false;
+        }
+
+        m_pBuffer = static_cast<uint8_t*>(malloc(sizeof(Slot) * count));
+        if (m_pBuffer == nullptr)
+        {
+            return false;
+        }
+
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            m_pValues = static_cast<T*>(::operator new(
+                sizeof(T) * count, std::align_val_t(PoolCacheLineSize), std::nothrow));
+            if (m_pValues == nullptr)
+            {
+                free(m_pBuffer);
+                m_pBuffer = nullptr;
+                return false;
+            }
+        }
+
+        m_Capacity = count;
+
+        for (auto i = 0u; i < m_Capacity; ++i)
+        {
+            auto item = GetItem(i);
+            item->m_Index = i;
+            new (&item->m_Next) std::atomic<uint32_t>(i + 1 < m_Capacity ? i + 1 : InvalidIndex);
+        }
+
+        m_Head.store(MakeHead(0, 0), std::memory_order_release);
+        m_Count.store(0, std::memory_order_release);
+
+        return true;
+    }
+
+    void Term()
+    {
+        if (m_pBuffer)
+        {
+            free(m_pBuffer);
+            m_pBuffer = nullptr;
+        }
+
+        if (m_pValues)
+        {
+            ::operator delete(m_pValues, std::align_val_t(PoolCacheLineSize));
+            m_pValues = nullptr;
+        }
+
+        m_Head.store(MakeHead(InvalidIndex, 0), std::memory_order_release);
+        m_Capacity = 0;
+        m_Count.store(0, std::memory_order_release);
+    }
+
+    template<typename Func>
+    T* Alloc(Func&& func)
+    {
+        auto item = Pop();
+        if (item == nullptr)
+        {
+            return nullptr;
+        }
+
+        m_Count.fetch_add(1, std::memory_order_relaxed);
+
+        auto val = new ((void*)ToValue(item)) T();
+        func(item->m_Index, val);
+
+        return val;
+    }
+
+    T* Alloc()
+    {
+        return Alloc([](uint32_t, T*) {});
+    }
+
+    // Pops up to count items with a single successful CAS.
+    // Returns the number of items written to ppValues.
+    template<typename Func>
+    uint32_t AllocN(uint32_t count, T** ppValues, Func&& func)
+    {
+        if (count == 0 || ppValues == nullptr)
+        {
+            return 0;
+        }
+
+        auto n = PopChain(count, ppValues);
+        m_Count.fetch_add(n, std::memory_order_relaxed);
+
+        for (auto i = 0u; i < n; ++i)
+        {
+            auto index = GetIndex(ppValues[i]);
+            ppValues[i] = new ((void*)ppValues[i]) T();
+            func(index, ppValues[i]);
+        }
+
+        return n;
+    }
+
+    uint32_t AllocN(uint32_t count, T** ppValues)
+    {
+        return AllocN(count, ppValues, [](uint32_t, T*) {});
+    }
+
+    void Free(T* pValue)
+    {
+        if (pValue == nullptr)
+        {
+            return;
+        }
+
+        auto item = ToItem(pValue);
+        assert(item->m_Index < m_Capacity);
+
+        // Counted down before the item is visible to other threads, so a
+        // racing Alloc() never pushes the count above the capacity.
+        m_Count.fetch_sub(1, std::memory_order_relaxed);
+        Push(item);
+    }
+
+    // Links the items into a chain and pushes it with a single successful CAS.
+    // nullptr entries are skipped.
+    void FreeN(T* const* ppValues, uint32_t count)
+    {
+        if (count == 0 || ppValues == nullptr)
+        {
+            return;
+        }
+
+        Item* first = nullptr;
+        Item* last  = nullptr;
+        uint32_t n  = 0;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (ppValues[i] == nullptr)
+            {
+                continue;
+            }
+
+            auto item = ToItem(ppValues[i]);
+            assert(item->m_Index < m_Capacity);
+
+            if (last != nullptr)
+            {
+                last->m_Next.store(item->m_Index, std::memory_order_relaxed);
+            }
+            else
+            {
+                first = item;
+            }
+
+            last = item;
+            n++;
+        }
+
+        if (first == nullptr)
+        {
+            return;
+        }
+
+        m_Count.fetch_sub(n, std::memory_order_relaxed);
+        PushChain(first, last);
+    }
+
+    uint32_t GetIndex(const T* pValue) const
+    {
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            return uint32_t(pValue - m_pValues);
+        }
+        else
+        {
+            return reinterpret_cast<const Slot*>(pValue)->m_Item.m_Index;
+        }
+    }
+
+    uint32_t GetSize() const
+    {
+        return m_Capacity;
+    }
+
+    uint32_t GetUsedCount() const
+    {
+        return m_Count.load(std::memory_order_relaxed);
+    }
+
+    uint32_t GetAvailableCount() const
+    {
+        return m_Capacity - GetUsedCount();
+    }
+
+private:
+    static const uint32_t InvalidIndex = uint32_t(-1);
+
+    struct Item
+    {
+        uint32_t                m_Index;
+        std::atomic<uint32_t>   m_Next;
+    };
+
+    struct AosSlot
+    {
+        T                       m_Value;
+        Item                    m_Item;
+    };
+
+    struct SoaSlot
+    {
+        Item                    m_Item;
+    };
+
+    typedef typename std::conditional<Layout == POOL_LAYOUT_SOA, SoaSlot, AosSlot>::type Slot;
+
+    uint8_t*                m_pBuffer;
+    T*                      m_pValues;  // POOL_LAYOUT_SOA only
+    std::atomic<uint64_t>   m_Head;     // [63:32] tag, [31:0] index
+    uint32_t                m_Capacity;
+    std::atomic<uint32_t>   m_Count;
+
+    static uint64_t MakeHead(uint32_t index, uint32_t tag)
+    {
+        return (uint64_t(tag) << 32) | index;
+    }
+
+    static uint32_t GetHeadIndex(uint64_t head)
+    {
+        return uint32_t(head & 0xffffffff);
+    }
+
+    static uint32_t GetHeadTag(uint64_t head)
+    {
+        return uint32_t(head >> 32);
+    }
+
+    Item* GetItem(uint32_t index)
+    {
+        assert(index < m_Capacity);
+        return &reinterpret_cast<Slot*>(m_pBuffer + sizeof(Slot) * index)->m_Item;
+    }
+
+    T* ToValue(Item* item)
+    {
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            return m_pValues + item->m_Index;
+        }
+        else
+        {
+            return &reinterpret_cast<Slot*>(m_pBuffer + sizeof(Slot) * item->m_Index)->m_Value;
+        }
+    }
+
+    Item* ToItem(T* pValue)
+    {
+        return GetItem(GetIndex(pValue));
+    }
+
+    Item* Pop()
+    {
+        T* pValue = nullptr;
+        if (PopChain(1, &pValue) == 0)
+        {
+            return nullptr;
+        }
+
+        return ToItem(pValue);
+    }
+
+    void Push(Item* item)
+    {
+        PushChain(item, item);
+    }
+
+    // Every update of the head bumps the tag, so if the CAS succeeds nothing
+    // was pushed or popped since head was loaded and the next indices read
+    // while walking the chain were consistent. Stale reads only fail the CAS.
+    uint32_t PopChain(uint32_t count, T** ppValues)
+    {
+        auto head = m_Head.load(std::memory_order_acquire);
+
+        for (;;)
+        {
+            auto index = GetHeadIndex(head);
+            auto n = 0u;
+
+            while (n < count && index != InvalidIndex)
+            {
+                auto item = GetItem(index);
+                ppValues[n++] = ToValue(item);
+                index = item->m_Next.load(std::memory_order_relaxed);
+            }
+
+            if (n == 0)
+            {
+                return 0;
+            }
+
+            const auto newHead = MakeHead(index, GetHeadTag(head) + 1);
+
+            if (m_Head.compare_exchange_weak(
+                head, newHead,
+                std::memory_order_acquire,
+                std::memory_order_acquire))
+            {
+                return n;
+            }
+        }
+    }
+
+    void PushChain(Item* first, Item* last)
+    {
+        auto head = m_Head.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            last->m_Next.store(GetHeadIndex(head), std::memory_order_relaxed);
+            const auto newHead = MakeHead(first->m_Index, GetHeadTag(head) + 1);
+
+            if (m_Head.compare_exchange_weak(
+                head, newHead,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+    }
+
+    LockFreePool(const LockFreePool&) = delete;
+    void operator = (const LockFreePool&) = delete;
+};
+
+#endif
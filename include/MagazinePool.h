@@ -0,0 +1,451 @@
+#ifndef _MAGAZINE_POOL_H_
+#define _MAGAZINE_POOL_H_
+
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+#include <Pool.h>
+
+// Per-thread magazine cache in front of a shared pool (Pool<T> by default).
+// Each thread keeps a small magazine of free items and moves them to/from the
+// shared pool in batches of MagazineBatch (one AllocN/FreeN each), so most
+// Alloc/Free calls stay on the calling thread. Items parked in magazines are
+// reported as available: a thread whose magazine and the shared pool are
+// empty drains the other threads' magazines before giving up, and a thread
+// returns its magazines when it exits.
+//
+// Each magazine has a lock that is only contended while another thread
+// drains it. A thread keeps one slot per live pool it used; slots of
+// destroyed pools are dropped the next time it meets a new pool.
+template<typename T, typename TPool = Pool<T>>
+class MagazinePool
+{
+public:
+    static const uint32_t MagazineSize  = 32;
+    static const uint32_t MagazineBatch = MagazineSize / 2;
+
+    MagazinePool()
+        : m_Pool()
+        , m_Id(0)
+    {
+    }
+
+    ~MagazinePool()
+    {
+        Term();
+    }
+
+    bool Init(uint32_t count)
+    {
+        Term();
+
+        if (!m_Pool.Init(count))
+        {
+            return false;
+        }
+
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.Mutex);
+
+        m_Id = NextId();
+        registry.Pools[m_Id] = this;
+
+        return true;
+    }
+
+    void Term()
+    {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> registryGuard(registry.Mutex);
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        if (m_Id != 0)
+        {
+            registry.Pools.erase(m_Id);
+        }
+
+        for (auto pMagazine : m_Magazines)
+        {
+            delete pMagazine;
+        }
+
+        m_Magazines.clear();
+
+        // Thread-local slots still refer to the old id and will never match
+        // again; each thread drops them on its next new pool.
+        m_Id = 0;
+        m_Pool.Term();
+    }
+
+    template<typename Func>
+    T* Alloc(Func&& func)
+    {
+        auto pMagazine = GetMagazine();
+        if (pMagazine == nullptr)
+        {
+            return nullptr;
+        }
+
+        Entry entry;
+        if (!Pop(pMagazine, entry))
+        {
+            DrainOthers(pMagazine);
+            if (!Pop(pMagazine, entry))
+            {
+                return nullptr;
+            }
+        }
+
+        auto val = new ((void*)entry.pValue) T();
+        func(entry.Index, val);
+
+        return val;
+    }
+
+    T* Alloc()
+    {
+        return Alloc([](uint32_t, T*) {});
+    }
+
+    template<typename Func>
+    uint32_t AllocN(uint32_t count, T** ppValues, Func&& func)
+    {
+        if (ppValues == nullptr)
+        {
+            return 0;
+        }
+
+        auto n = 0u;
+        while (n < count)
+        {
+            auto val = Alloc(func);
+            if (val == nullptr)
+            {
+                break;
+            }
+
+            ppValues[n++] = val;
+        }
+
+        return n;
+    }
+
+    uint32_t AllocN(uint32_t count, T** ppValues)
+    {
+        return AllocN(count, ppValues, [](uint32_t, T*) {});
+    }
+
+    void Free(T* pValue)
+    {
+        if (pValue == nullptr)
+        {
+            return;
+        }
+
+        auto pMagazine = GetMagazine();
+        if (pMagazine == nullptr)
+        {
+            m_Pool.Free(pValue);
+            return;
+        }
+
+        std::lock_guard<std::mutex> guard(pMagazine->Mutex);
+
+        auto count = pMagazine->Count.load(std::memory_order_relaxed);
+        if (count == MagazineSize)
+        {
+            count = Drain(pMagazine, MagazineBatch);
+        }
+
+        pMagazine->Items[count].pValue = pValue;
+        pMagazine->Items[count].Index  = m_Pool.GetIndex(pValue);
+        pMagazine->Count.store(count + 1, std::memory_order_relaxed);
+    }
+
+    void FreeN(T* const* ppValues, uint32_t count)
+    {
+        if (ppValues == nullptr)
+        {
+            return;
+        }
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            Free(ppValues[i]);
+        }
+    }
+
+    // Returns every item cached by the calling thread to the shared pool.
+    void Flush()
+    {
+        auto pMagazine = GetMagazine();
+        if (pMagazine != nullptr)
+        {
+            std::lock_guard<std::mutex> guard(pMagazine->Mutex);
+            Drain(pMagazine, pMagazine->Count.load(std::memory_order_relaxed));
+        }
+    }
+
+    uint32_t GetSize() const
+    {
+        return m_Pool.GetSize();
+    }
+
+    uint32_t GetUsedCount() const
+    {
+        const auto used   = m_Pool.GetUsedCount();
+        const auto cached = GetCachedCount();
+        return (used > cached) ? used - cached : 0;
+    }
+
+    uint32_t GetAvailableCount() const
+    {
+        return GetSize() - GetUsedCount();
+    }
+
+    // Items taken from the shared pool: handed out or parked in a magazine.
+    uint32_t GetReservedCount() const
+    {
+        return m_Pool.GetUsedCount();
+    }
+
+private:
+    struct Entry
+    {
+        T*          pValue;
+        uint32_t    Index;
+    };
+
+    struct Magazine
+    {
+        Entry                   Items[MagazineSize];
+        std::atomic<uint32_t>   Count;      // changed under Mutex, read without it for stats
+        std::mutex              Mutex;      // held by the owning thread, or by a thread draining it
+
+        Magazine()
+            : Count(0)
+        {
+        }
+    };
+
+    struct LocalSlot
+    {
+        uint64_t    Id;
+        Magazine*   pMagazine;
+    };
+
+    // Live pools by id, so that a thread can tell which of its slots still
+    // have a pool behind them.
+    struct Registry
+    {
+        std::mutex                                      Mutex;
+        std::unordered_map<uint64_t, MagazinePool*>     Pools;
+    };
+
+    // Returns the thread's magazines to their pools when the thread exits.
+    struct LocalCache
+    {
+        std::vector<LocalSlot> Slots;
+
+        ~LocalCache()
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.Mutex);
+
+            for (const auto& slot : Slots)
+            {
+                auto itr = registry.Pools.find(slot.Id);
+                if (itr != registry.Pools.end())
+                {
+                    itr->second->ReleaseMagazine(slot.pMagazine);
+                }
+            }
+        }
+    };
+
+    TPool                   m_Pool;
+    uint64_t                m_Id;
+    std::vector<Magazine*>  m_Magazines;
+    mutable std::mutex      m_Mutex;
+
+    static uint64_t NextId()
+    {
+        static std::atomic<uint64_t> s_Id(0);
+        return ++s_Id;
+    }
+
+    // Never destroyed: pools and thread-local caches may outlive any static.
+    static Registry& GetRegistry()
+    {
+        static Registry* s_pRegistry = new Registry();
+        return *s_pRegistry;
+    }
+
+    static std::vector<LocalSlot>& GetLocalSlots()
+    {
+        static thread_local LocalCache s_Cache;
+        return s_Cache.Slots;
+    }
+
+    Magazine* GetMagazine()
+    {
+        const auto id = m_Id;
+        if (id == 0)
+        {
+            return nullptr;
+        }
+
+        auto& slots = GetLocalSlots();
+        for (const auto& slot : slots)
+        {
+            if (slot.Id == id)
+            {
+                return slot.pMagazine;
+            }
+        }
+
+        auto pMagazine = new (std::nothrow) Magazine();
+        if (pMagazine == nullptr)
+        {
+            return nullptr;
+        }
+
+        {
+            auto& registry = GetRegistry();
+            std::lock_guard<std::mutex> registryGuard(registry.Mutex);
+
+            // Slots of destroyed pools are dropped here, so a thread holds
+            // at most one slot per live pool.
+            slots.erase(std::remove_if(slots.begin(), slots.end(), [&registry](const LocalSlot& slot)
+            {
+                return registry.Pools.find(slot.Id) == registry.Pools.end();
+            }), slots.end());
+
+            std::lock_guard<std::mutex> guard(m_Mutex);
+            m_Magazines.push_back(pMagazine);
+        }
+
+        slots.push_back({ id, pMagazine });
+        return pMagazine;
+    }
+
+    // Removes the magazine of an exiting thread and returns its items. The
+    // caller holds the registry lock.
+    void ReleaseMagazine(Magazine* pMagazine)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        auto itr = std::find(m_Magazines.begin(), m_Magazines.end(), pMagazine);
+        if (itr == m_Magazines.end())
+        {
+            return;
+        }
+
+        m_Magazines.erase(itr);
+
+        {
+            std::lock_guard<std::mutex> magazineGuard(pMagazine->Mutex);
+            Drain(pMagazine, pMagazine->Count.load(std::memory_order_relaxed));
+        }
+
+        delete pMagazine;
+    }
+
+    bool Pop(Magazine* pMagazine, Entry& entry)
+    {
+        std::lock_guard<std::mutex> guard(pMagazine->Mutex);
+
+        auto count = pMagazine->Count.load(std::memory_order_relaxed);
+        if (count == 0)
+        {
+            count = Refill(pMagazine);
+            if (count == 0)
+            {
+                return false;
+            }
+        }
+
+        entry = pMagazine->Items[count - 1];
+        pMagazine->Count.store(count - 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Returns the items cached by every other thread to the shared pool.
+    // Called without holding pSelf's lock, so two threads draining each
+    // other never wait on one another.
+    void DrainOthers(Magazine* pSelf)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        for (auto pMagazine : m_Magazines)
+        {
+            if (pMagazine == pSelf)
+            {
+                continue;
+            }
+
+            std::lock_guard<std::mutex> magazineGuard(pMagazine->Mutex);
+            Drain(pMagazine, pMagazine->Count.load(std::memory_order_relaxed));
+        }
+    }
+
+    uint32_t GetCachedCount() const
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        uint32_t count = 0;
+        for (auto pMagazine : m_Magazines)
+        {
+            count += pMagazine->Count.load(std::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    uint32_t Refill(Magazine* pMagazine)
+    {
+        auto count = pMagazine->Count.load(std::memory_order_relaxed);
+        auto pEntries = &pMagazine->Items[count];
+
+        T* pValues[MagazineBatch];
+        const auto allocated = m_Pool.AllocN(MagazineBatch, pValues);
+
+        for (auto i = 0u; i < allocated; ++i)
+        {
+            pEntries[i].pValue = pValues[i];
+            pEntries[i].Index  = m_Pool.GetIndex(pValues[i]);
+        }
+
+        count += allocated;
+        pMagazine->Count.store(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    uint32_t Drain(Magazine* pMagazine, uint32_t drainCount)
+    {
+        auto count = pMagazine->Count.load(std::memory_order_relaxed);
+        assert(drainCount <= count);
+
+        T* pValues[MagazineSize];
+        for (auto i = 0u; i < drainCount; ++i)
+        {
+            pValues[i] = pMagazine->Items[count - drainCount + i].pValue;
+        }
+
+        m_Pool.FreeN(pValues, drainCount);
+
+        count -= drainCount;
+        pMagazine->Count.store(count, std::memory_order_relaxed);
+        return count;
+    }
+
+    MagazinePool(const MagazinePool&) = delete;
+    void operator = (const MagazinePool&) = delete;
+};
+
+#endif
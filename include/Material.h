@@ -4,6 +4,8 @@
 #include <ResourceUploadBatch.h>
 #include <Texture.h>
 #include <ConstantBuffer.h>
+#include <TableCache.h>
+#include <RetireQueue.h>
 #include <map>
 
 class Material
@@ -27,12 +29,18 @@ public:
 
     bool Init(
         ID3D12Device*   pDevice,
+        GpuAllocator*   pAllocator,
         DescriptorPool* pPool,
         size_t          bufferSize,
         size_t          count);
 
     void Term();
 
+    // Like Term(), but the textures, buffers and texture tables are released
+    // only once retireValue completes in queue: frames in flight may still
+    // read them.
+    void Retire(RetireQueue& queue, uint64_t retireValue);
+
     bool SetTexture(
         size_t                          index,
         TEXTURE_USAGE                   usage,
@@ -58,20 +66,43 @@ public:
     D3D12_GPU_VIRTUAL_ADDRESS GetBufferAddress(size_t index) const;
     D3D12_GPU_DESCRIPTOR_HANDLE GetTextureHandle(size_t index, TEXTURE_USAGE usage) const;
 
+    // Heap index of the texture for bindless access (the dummy texture if unset).
+    uint32_t GetTextureIndex(size_t index, TEXTURE_USAGE usage) const;
+
+    // Contiguous SRV table of the subset: t0 diffuse, t1 normal, t2 specular.
+    // Null until CommitTextureTables() has resolved it.
+    D3D12_GPU_DESCRIPTOR_HANDLE GetTextureTable(size_t index) const;
+
+    // Resolves the tables of subsets whose textures changed. Subsets with the
+    // same textures share one table; new tables are filled with one batched
+    // CopyDescriptors call. Tables dropped now are freed once completedValue
+    // reaches retireValue.
+    void CommitTextureTables(uint64_t retireValue, uint64_t completedValue);
+
     size_t GetCount() const;
 
+    static const uint32_t TextureTableSize     = 3;
+    static const uint32_t MaxUnusedTableCount  = 64;
+
 private:
+    typedef TableCache<DescriptorRange, TextureTableSize> TextureTableCache;
+
     struct Subset
     {
         ConstantBuffer*             pCostantBuffer;
-        D3D12_GPU_DESCRIPTOR_HANDLE TextureHandle[TEXTURE_USAGE_COUNT];
+        DescriptorId                TextureHandle[TEXTURE_USAGE_COUNT];
+        uint32_t                    TableEntry;
+        bool                        TableDirty;
     };
 
     std::map<std::wstring, Texture*>    m_pTexture;
     std::vector<Subset>                 m_Subset;
+    TextureTableCache                   m_TableCache;
     ID3D12Device*                       m_pDevice;
     DescriptorPool*                     m_pPool;
 
+    void SetTextureHandle(size_t index, TEXTURE_USAGE usage, const Texture* pTexture);
+
     Material(const Material&) = delete;
     void operator = (const Material&) = delete;
 };
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+// Copies size bytes into write-combined memory such as a mapped upload heap.
+// The bulk is written with non-temporal stores, one full 64-byte line at a
+// time, so lines are never flushed partially and the source does not evict
+// the cache. Falls back to memcpy for small copies and on targets without
+// SSE2. The regions must not overlap.
+void StreamCopy(void* pDst, const void* pSrc, size_t size);
\ No newline at end of file
@@ -2,10 +2,8 @@
 
 #include <map>
 #include <ResMesh.h>
-#include <VertexBuffer.h>
-#include <IndexBuffer.h>
-#include <CommandList.h>
-#include <Fence.h>
+#include <GeometryBuffer.h>
+#include <UploadBatch.h>
 
 //#define MAX_INFLUENCE_BONE_COUNT  4
 
@@ -18,24 +16,27 @@ public:
     Mesh();
     virtual ~Mesh();
 
+    // Vertices and indices are sub-allocated from pGeometry, which must
+    // outlive the mesh.
     bool Init(
-        ID3D12Device* pDevice,
-        ID3D12CommandQueue* pQueue,
-        CommandList* pCmdList,
-        Fence* pFence,
+        GeometryBuffer* pGeometry,
+        UploadBatch* pBatch,
         const ResMesh& resource);
 
     void Term();
 
-    void Draw(ID3D12GraphicsCommandList* pCmdList);
+    // The page returned by GetPage() must be bound to pCmdList.
+    void Draw(ID3D12GraphicsCommandList* pCmdList, uint32_t instanceCount = 1);
 
     uint32_t GetMaterialId() const;
+    uint32_t GetPage() const;
+    const DirectX::BoundingBox& GetBounds() const;
 
 private:
-    VertexBuffer    m_VB;
-    IndexBuffer     m_IB;
-    uint32_t        m_MaterialId;
-    uint32_t        m_IndexCount;
+    GeometryBuffer*         m_pGeometry;
+    GeometryRange           m_Range;
+    uint32_t                m_MaterialId;
+    DirectX::BoundingBox    m_Bounds;       // local space
 
     std::map<std::string, BoneInfo> m_BoneInfoMap;
 
@@ -4,14 +4,29 @@
 #include <cstdint>
 #include <mutex>
 #include <cassert>
-#include <functional>
+#include <new>
+#include <type_traits>
+
+// Storage layout of the pool items.
+//  AOS : each value is stored next to its index/link metadata.
+//  SOA : values live in one contiguous cache-line aligned array and the
+//        metadata in a separate array, so reading values never pulls link
+//        pointers into cache.
+enum POOL_LAYOUT
+{
+    POOL_LAYOUT_AOS = 0,
+    POOL_LAYOUT_SOA = 1,
+};
 
-template<typename T>
+static const size_t PoolCacheLineSize = 64;
+
+template<typename T, POOL_LAYOUT Layout = POOL_LAYOUT_AOS>
 class Pool
 {
 public:
     Pool()
         : m_pBuffer(nullptr)
+        , m_pValues(nullptr)
         , m_pActive(nullptr)
         , m_pFree(nullptr)
         , m_Capacity(0)
@@ -28,12 +43,24 @@ public:
     {
         std::lock_guard<std::mutex> guard(m_Mutex);
 
-        m_pBuffer = static_cast<uint8_t*>(malloc(sizeof(Item) * (count + 2)));
+        m_pBuffer = static_cast<uint8_t*>(malloc(sizeof(Slot) * (count + 2)));
         if (m_pBuffer == nullptr)
         {
             return false;
         }
 
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            m_pValues = static_cast<T*>(::operator new(
+                sizeof(T) * count, std::align_val_t(PoolCacheLineSize), std::nothrow));
+            if (m_pValues == nullptr)
+            {
+                free(m_pBuffer);
+                m_pBuffer = nullptr;
+                return false;
+            }
+        }
+
         m_Capacity = count;
 
         for (auto i = 2u, j = 0u; i < m_Capacity + 2; ++i, ++j)
@@ -72,13 +99,20 @@ public:
             m_pBuffer = nullptr;
         }
 
+        if (m_pValues)
+        {
+            ::operator delete(m_pValues, std::align_val_t(PoolCacheLineSize));
+            m_pValues = nullptr;
+        }
+
         m_pActive = nullptr;
         m_pFree = nullptr;
         m_Capacity = 0;
         m_Count = 0;
     }
 
-    T* Alloc(std::function<void(uint32_t, T*)> func = nullptr)
+    template<typename Func>
+    T* Alloc(Func&& func)
     {
         std::lock_guard<std::mutex> guard(m_Mutex);
 
@@ -87,23 +121,38 @@ public:
             return nullptr;
         }
 
-        auto item = m_pFree->m_pNext;
-        m_pFree->m_pNext = item->m_pNext;
+        return AllocItem(func);
+    }
 
-        item->m_pPrev = m_pActive->m_pPrev;
-        item->m_pNext = m_pActive;
-        item->m_pPrev->m_pNext = item->m_pNext->m_pPrev = item;
+    T* Alloc()
+    {
+        return Alloc([](uint32_t, T*) {});
+    }
 
-        m_Count++;
+    // Allocates up to count items under a single lock acquisition.
+    // Returns the number of items written to ppValues.
+    template<typename Func>
+    uint32_t AllocN(uint32_t count, T** ppValues, Func&& func)
+    {
+        if (count == 0 || ppValues == nullptr)
+        {
+            return 0;
+        }
 
-        auto val = new ((void*)item) T();
+        std::lock_guard<std::mutex> guard(m_Mutex);
 
-        if (func != nullptr)
+        auto n = 0u;
+        while (n < count && m_pFree->m_pNext != m_pFree && m_Count + 1 <= m_Capacity)
         {
-            func(item->m_Index, val);
+            ppValues[n++] = AllocItem(func);
         }
 
-        return val;
+        return n;
+    }
+
+    uint32_t AllocN(uint32_t count, T** ppValues)
+    {
+        return AllocN(count, ppValues, [](uint32_t, T*) {});
     }
 
     void Free(T* pValue)
@@ -115,16 +164,51 @@ public:
 
         std::lock_guard<std::mutex> guard(m_Mutex);
 
-        auto item = reinterpret_cast<Item*>(pValue);
+        FreeItem(ToItem(pValue));
+    }
 
-        item->m_pPrev->m_pNext = item->m_pNext;
-        item->m_pNext->m_pPrev = item->m_pPrev;
+    // Returns count items under a single lock acquisition. nullptr entries are skipped.
+    void FreeN(T* const* ppValues, uint32_t count)
+    {
+        if (count == 0 || ppValues == nullptr)
+        {
+            return;
+        }
 
-        item->m_pPrev = nullptr;
-        item->m_pNext = m_pFree->m_pNext;
+        std::lock_guard<std::mutex> guard(m_Mutex);
 
-        m_pFree->m_pNext = item;
-        m_Count--;
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (ppValues[i] != nullptr)
+            {
+                FreeItem(ToItem(ppValues[i]));
+            }
+        }
+    }
+
+    // Calls func(value) for every allocated item, walking the active list
+    // under the lock. func must not call back into the pool.
+    template<typename Func>
+    void ForEach(Func&& func)
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        for (auto item = m_pActive->m_pNext; item != m_pActive; item = item->m_pNext)
+        {
+            func(ToValue(item));
+        }
+    }
+
+    uint32_t GetIndex(const T* pValue) const
+    {
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            return uint32_t(pValue - m_pValues);
+        }
+        else
+        {
+            return reinterpret_cast<const Slot*>(pValue)->m_Item.m_Index;
+        }
     }
 
     uint32_t GetSize() const
@@ -145,25 +229,26 @@ public:
 private:
     struct Item
     {
-        T           m_Value;
         uint32_t    m_Index;
         Item*       m_pNext;
         Item*       m_pPrev;
+    };
 
-        Item()
-            : m_Value()
-            , m_Index(0)
-            , m_pNext(nullptr)
-            , m_pPrev(nullptr)
-        {
-        }
+    struct AosSlot
+    {
+        T           m_Value;
+        Item        m_Item;
+    };
 
-        ~Item()
-        {
-        }
+    struct SoaSlot
+    {
+        Item        m_Item;
     };
 
-    uint8_t*    m_pBuffer;
+    typedef typename std::conditional<Layout == POOL_LAYOUT_SOA, SoaSlot, AosSlot>::type Slot;
+
+    uint8_t*    m_pBuffer;      // slots (sentinels at 0 and 1)
+    T*          m_pValues;      // POOL_LAYOUT_SOA only
     Item*       m_pActive;
     Item*       m_pFree;
     uint32_t    m_Capacity;
@@ -173,14 +258,61 @@ private:
     Item* GetItem(uint32_t index)
     {
         assert(0 <= index && index <= m_Capacity + 2);
-        return reinterpret_cast<Item*>(m_pBuffer + sizeof(Item) * index);
+        return &reinterpret_cast<Slot*>(m_pBuffer + sizeof(Slot) * index)->m_Item;
     }
 
-    Item* AssignItem(uint32_t index)
+    T* ToValue(Item* item)
     {
-        assert(0 <= index && index <= m_Capacity + 2);
-        auto buf = (m_pBuffer + sizeof(Item) * index);
-        return new (buf) Item;
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            return m_pValues + item->m_Index;
+        }
+        else
+        {
+            return &reinterpret_cast<Slot*>(m_pBuffer + sizeof(Slot) * (item->m_Index + 2))->m_Value;
+        }
+    }
+
+    Item* ToItem(T* pValue)
+    {
+        if constexpr (Layout == POOL_LAYOUT_SOA)
+        {
+            return GetItem(uint32_t(pValue - m_pValues) + 2);
+        }
+        else
+        {
+            return &reinterpret_cast<Slot*>(pValue)->m_Item;
+        }
+    }
+
+    template<typename Func>
+    T* AllocItem(Func& func)
+    {
+        auto item = m_pFree->m_pNext;
+        m_pFree->m_pNext = item->m_pNext;
+
+        item->m_pPrev = m_pActive->m_pPrev;
+        item->m_pNext = m_pActive;
+        item->m_pPrev->m_pNext = item->m_pNext->m_pPrev = item;
+
+        m_Count++;
+
+        auto val = new ((void*)ToValue(item)) T();
+        func(item->m_Index, val);
+
+        return val;
+    }
+
+    void FreeItem(Item* item)
+    {
+        item->m_pPrev->m_pNext = item->m_pNext;
+        item->m_pNext->m_pPrev = item->m_pPrev;
+
+        item->m_pPrev = nullptr;
+        item->m_pNext = m_pFree->m_pNext;
+
+        m_pFree->m_pNext = item;
+        m_Count--;
     }
 
     Pool(const Pool&) = delete;
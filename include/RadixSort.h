@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// LSD radix sort of 64-bit keys, each carrying a 32-bit value, 8 bits per
+// pass. The histograms of all passes are built in one read of the keys, and
+// a pass is skipped when every key has the same byte there, so keys with
+// unused bit ranges cost fewer passes. The sort is stable.
+//
+// Scratch buffers are kept between calls. Not thread safe.
+class RadixSorter
+{
+public:
+    RadixSorter();
+    ~RadixSorter();
+
+    // keys and values must be the same size. Sorted ascending by key.
+    void Sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values);
+
+    // Frees the scratch buffers.
+    void Term();
+
+private:
+    static const uint32_t RadixBits = 8;
+    static const uint32_t RadixSize = 1 << RadixBits;
+    static const uint32_t PassCount = 64 / RadixBits;
+
+    std::vector<uint64_t>   m_TempKeys;
+    std::vector<uint32_t>   m_TempValues;
+
+    RadixSorter(const RadixSorter&) = delete;
+    void operator = (const RadixSorter&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Allocator of contiguous ranges of [0, size). It only hands out offsets, so
+// it can manage descriptor indices (or anything else) without a device.
+//
+// Free ranges are kept in segregated lists by size class (floor(log2(size))),
+// TLSF style. A request first checks the first few ranges of its own class,
+// then takes the head of the next non-empty larger class, which always fits.
+// Only when no larger range exists is the rest of its own class searched, so
+// a long list of too-small ranges costs nothing while larger ones are left.
+// Allocation splits the range it takes; freeing coalesces with free neighbours.
+class RangeAllocator
+{
+public:
+    static const uint32_t InvalidNode = uint32_t(-1);
+
+    struct Allocation
+    {
+        uint32_t    Offset;
+        uint32_t    Count;
+        uint32_t    Node;
+
+        Allocation()
+            : Offset(0)
+            , Count(0)
+            , Node(InvalidNode)
+        {
+        }
+
+        bool IsValid() const
+        {
+            return Node != InvalidNode;
+        }
+    };
+
+    RangeAllocator();
+    ~RangeAllocator();
+
+    bool Init(uint32_t size);
+    void Term();
+
+    // Extends the managed space to [0, size). Existing allocations keep their offsets.
+    bool Grow(uint32_t size);
+
+    bool Alloc(uint32_t count, Allocation& allocation);
+    void Free(Allocation& allocation);
+
+    uint32_t GetSize() const;
+    uint32_t GetUsedCount() const;
+    uint32_t GetFreeCount() const;
+    uint32_t GetFreeRangeCount() const;
+    uint32_t GetLargestFreeRange() const;
+
+private:
+    static const uint32_t ClassCount        = 32;
+    static const uint32_t MaxClassScanCount = 8;
+
+    struct Node
+    {
+        uint32_t    Offset;
+        uint32_t    Size;
+        uint32_t    PrevPhys;
+        uint32_t    NextPhys;
+        uint32_t    PrevFree;
+        uint32_t    NextFree;
+        bool        IsFree;
+    };
+
+    std::vector<Node>       m_Nodes;
+    std::vector<uint32_t>   m_UnusedNodes;
+    uint32_t                m_FreeHead[ClassCount];
+    uint32_t                m_ClassMask;        // bit c set if class c has free ranges
+    uint32_t                m_LastNode;         // node ending at m_Size
+    uint32_t                m_Size;
+    uint32_t                m_UsedCount;
+    uint32_t                m_FreeRangeCount;
+
+    static uint32_t GetClass(uint32_t size);
+
+    uint32_t FindInClass(uint32_t cls, uint32_t count, uint32_t maxScanCount) const;
+
+    uint32_t NewNode();
+    void ReleaseNode(uint32_t node);
+    void InsertFree(uint32_t node);
+    void RemoveFree(uint32_t node);
+
+    RangeAllocator(const RangeAllocator&) = delete;
+    void operator = (const RangeAllocator&) = delete;
+};
\ No newline at end of file
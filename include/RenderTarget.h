@@ -4,9 +4,8 @@
 #include <dxgi1_6.h>
 #include <ComPtr.h>
 #include <cstdint>
-
-class DescriptorHandle;
-class DescriptorPool;
+#include <DescriptorPool.h>
+#include <GpuAllocator.h>
 
 class RenderTarget
 {
@@ -16,6 +15,7 @@ public:
 
     void Init(
         ID3D12Device*   pDevice,
+        GpuAllocator*   pAllocator,
         DescriptorPool* pPoolRTV,
         uint32_t        width,
         uint32_t        height,
@@ -36,7 +36,9 @@ public:
 
 private:
     ComPtr<ID3D12Resource>          m_pTarget;
-    DescriptorHandle*               m_pHandleRTV;
+    GpuAllocator*                   m_pAllocator;
+    GpuAllocation                   m_Allocation;
+    DescriptorId                    m_HandleRTVId;
     DescriptorPool*                 m_pPoolRTV;
     D3D12_RENDER_TARGET_VIEW_DESC   m_ViewDesc;
 
@@ -7,17 +7,29 @@
 #include <d3dcommon.h>
 #include <d3dcompiler.h>
 #include <ComPtr.h>
+#include <ChunkRecorder.h>
 #include <ConstantBuffer.h>
 #include <DescriptorPool.h>
+#include <DescriptorRing.h>
 #include <DllExport.h>
 #include <RenderTarget.h>
 #include <DepthTarget.h>
 #include <CommandList.h>
 #include <FrameResource.h>
 #include <Fence.h>
+#include <FrameLatency.h>
+#include <FrustumCuller.h>
+#include <GeometryBuffer.h>
+#include <GpuAllocator.h>
+#include <RadixSort.h>
+#include <SortKey.h>
+#include <JobSystem.h>
+#include <RetireQueue.h>
+#include <UploadBatch.h>
 #include <Material.h>
 #include <Mesh.h>
 #include <Texture.h>
+#include <UploadRing.h>
 #include <GameTimer.h>
 
 constexpr auto DirLightInitDir        = DirectX::XMFLOAT3(0.0f, 30.0f, -15.0f);
@@ -28,6 +40,40 @@ constexpr auto SpotLightInitDir       = DirectX::XMFLOAT3(0.0f, 30.0f, -15.0f);
 constexpr auto SpotLightInitRange     = 150.0f;
 constexpr auto SpotLightInitSpotPower = 5.0f;
 
+struct RenderStats
+{
+    uint64_t UploadBytes;       // bytes written to upload heaps for the last frame
+    uint64_t HeapBudget;        // cap on GPU heap memory, 0 if unlimited
+    uint64_t HeapReserved;      // bytes in GPU heaps
+    uint64_t HeapUsed;          // bytes placed in GPU heaps
+    float    HeapFragmentation; // 1 - largest free range / free bytes
+    uint64_t CpuWait;           // microseconds the CPU blocked on the frame resource fence
+    uint32_t FramesInFlight;    // frames the CPU may record ahead of the GPU
+    uint32_t PipelineDepth;     // frames queued on the GPU at the last submission, that one included
+    uint32_t VisibleItems;      // render items that passed frustum culling
+    uint32_t CulledItems;       // render items outside the frustum
+    uint32_t DrawCalls;         // instanced draws, one per run of visible items sharing a mesh
+    uint64_t LoadTime;          // microseconds the last successful Load() took
+    uint64_t LoadMeshTime;      // part of LoadTime spent parsing and staging meshes
+
+    RenderStats()
+    {
+        UploadBytes       = 0;
+        HeapBudget        = 0;
+        HeapReserved      = 0;
+        HeapUsed          = 0;
+        HeapFragmentation = 0.0f;
+        CpuWait           = 0;
+        FramesInFlight    = 0;
+        PipelineDepth     = 0;
+        VisibleItems      = 0;
+        CulledItems       = 0;
+        DrawCalls         = 0;
+        LoadTime          = 0;
+        LoadMeshTime      = 0;
+    }
+};
+
 class IRenderer
 {
 public:
@@ -35,10 +81,16 @@ public:
     virtual void Resize(uint32_t width, uint32_t height) = 0;
     virtual void Render() = 0;
     virtual void Tick() = 0;
+    virtual RenderStats GetStats() const = 0;
+
+    // framesInFlight is clamped to [1, FrameResourceCount]; adaptive mode
+    // starts from it and tunes it at run time.
+    virtual void SetFrameLatency(LATENCY_MODE mode, uint32_t framesInFlight) = 0;
+    virtual void SetSyncInterval(uint32_t interval) = 0;
 
 public:
     static const uint32_t    FrameCount = 2;
-    static const int         FrameResourceCount = 3;
+    static const int         FrameResourceCount = 3;   // maximum frames in flight
     static D3D_FEATURE_LEVEL FeatureLevel;
     static DXGI_FORMAT       BackBufferFormat;
     static UINT              Msaa4xQuality;
@@ -49,18 +101,34 @@ public:
     PassConstant    Pass;
 };
 
+enum RENDER_ITEM_FIELD
+{
+    RENDER_ITEM_FIELD_WORLD    = 0,
+    RENDER_ITEM_FIELD_MATERIAL = 1,     // MaterialIndex and Flags
+    RENDER_ITEM_FIELD_COUNT
+};
+
 struct RenderItem
 {
     bool IsShadow;
+    RENDER_PASS Pass;
     int MeshIdx;
     int DataIdx;
-    TransformBuffer Transform;
-    LightBuffer     Light;
-    MaterialBuffer  Material;
-    PassConstant    Pass;
+    ObjectBuffer Object;
+    uint64_t Version[RENDER_ITEM_FIELD_COUNT];  // Renderer version of the last change
 };
 
-class Renderer : public IRenderer
+// Visible items drawn with one instanced draw. They share a pass and a mesh,
+// and with it the material, and are consecutive in draw order.
+struct DrawBatch
+{
+    RENDER_PASS Pass;
+    int         MeshIdx;
+    uint32_t    FirstInstance;  // index into m_VisibleItems
+    uint32_t    InstanceCount;
+};
+
+class Renderer : public IRenderer, private IChunkRecorder
 {
 public:
     Renderer(HINSTANCE hInst, HWND hWnd, uint32_t width, uint32_t height);
@@ -71,6 +139,9 @@ public:
     void Resize(uint32_t width, uint32_t height);
     void Render();
     void Tick() { m_Timer.Tick(); }
+    RenderStats GetStats() const { return m_Stats; }
+    void SetFrameLatency(LATENCY_MODE mode, uint32_t framesInFlight);
+    void SetSyncInterval(uint32_t interval) { m_SyncInterval = interval; }
 
 private:
     HINSTANCE m_hInst;
@@ -78,14 +149,21 @@ private:
     uint32_t  m_Width;
     uint32_t  m_Height;
 
+    JobSystem                  m_Jobs;
     ComPtr<ID3D12Device>       m_pDevice;
+    GpuAllocator               m_GpuAllocator;
     ComPtr<ID3D12CommandQueue> m_pQueue;
     ComPtr<IDXGISwapChain3>    m_pSwapChain;
     RenderTarget               m_ColorTarget[FrameCount];
     DepthTarget                m_DepthTarget;
     DescriptorPool*            m_pPool[DescriptorPool::POOL_COUNT];
+    DescriptorRing             m_DescriptorRing;    // per-frame views, see BuildBufferTable()
+    UploadRing                 m_UploadRing;
     CommandList                m_CommandList;
+    UploadBatch                m_GeometryBatch;
+    GeometryBuffer             m_Geometry;
     Fence                      m_Fence;
+    RetireQueue                m_RetireQueue;   // released once their fence value completes
     uint32_t                   m_FrameIndex;
     D3D12_VIEWPORT             m_Viewport;
     D3D12_RECT                 m_Scissor;
@@ -93,21 +171,59 @@ private:
     std::vector<Mesh*>           m_pMesh;
     Material                     m_Material;
     ComPtr<ID3D12PipelineState>  m_pPSO;
+    ComPtr<ID3D12PipelineState>  m_pBlendPSO;
     ComPtr<ID3D12RootSignature>  m_pRootSig;
     float                        m_RotateAngle;
+    bool                         m_Bindless;
+
+    // Bumped by every Update() and every load. Data stamped with a version
+    // newer than what a frame resource last synced is copied into it.
+    uint64_t                     m_Version;
+    uint64_t                     m_MaterialVersion;
+    RenderStats                  m_Stats;
 
     std::vector<FrameResource*>  m_FrameResources;
     FrameResource*               m_CurrFrameRes;
     int                          m_CurrFrameResIndex;
+    FrameLatency                 m_Latency;         // frame resources in use, at most FrameResourceCount
+    uint32_t                     m_SyncInterval;
 
     ComPtr<ID3D12GraphicsCommandList> m_pCmdList;
+    ComPtr<ID3D12GraphicsCommandList> m_pEndCmdList;    // recorded after the render items
     ComPtr<ID3D12CommandAllocator>    m_pDirCmdAllocator;
 
+    // Render items are recorded in chunks, one command list per thread.
+    std::vector<ComPtr<ID3D12GraphicsCommandList>> m_pRecordCmdLists;
+    uint32_t                                       m_RecordThreadCount;
+
     std::vector<RenderItem> m_RenderItems;
+    std::vector<uint32_t>   m_VisibleItems;     // indices into m_RenderItems, in draw order
+    std::vector<uint64_t>   m_SortKeys;         // one per visible item
+    std::vector<DrawBatch>  m_Batches;          // in draw order
+    RadixSorter             m_Sorter;
+    FrustumCuller           m_Culler;           // world bounds of m_RenderItems
 
     GameTimer m_Timer;
 
 private:
+    // Per-frame descriptors carved from POOL_TYPE_RES. The buffer table takes
+    // BufferTableSize of them.
+    static const uint32_t TransientDescriptorCount = 64;
+    static const uint32_t BufferTableSize          = 3;
+
+    // Initial per-frame size of the upload ring; it grows on demand.
+    static const uint32_t UploadRingSize = 64 * 1024;
+
+    // Threads recording render items, one command list each. Fewer are
+    // used for small draw lists, about one per MinRecordDraws draws (see
+    // PartitionChunks()).
+    static const uint32_t MaxRecordThreads = 8;
+    static const uint32_t MinRecordDraws   = 256;
+
+    // Render items per job in Update() and in culling.
+    static const uint32_t UpdateGrainSize  = 1024;
+    static const uint32_t CullGrainSize    = 4096;
+
     bool InitD3DComponent();
     bool InitD3DAsset();
 
@@ -117,17 +233,25 @@ private:
 
     void BuildRenderItems();
     void BuildFrameResources();
+    void ReleaseMeshes();
+    void RetireMeshes(std::vector<Mesh*>& meshes);
 
     void Update();
-    void UpdateTransform();
-    void UpdateLight();
+    void UpdateObject();
     void UpdateMaterial();
     void UpdatePass();
+    void CullRenderItems();
+    void SortRenderItems();
+    void BuildDrawBatches();
 
+    void CommitDescriptors();
+    void BuildBufferTable();
     void Draw();
-    void DrawRenderItems();
+    uint32_t RecordRenderItems();
 
-    void Present(uint32_t interval);
+    // IChunkRecorder: records m_Batches [begin, end) into m_pRecordCmdLists[index].
+    void RecordChunk(uint32_t index, uint32_t begin, uint32_t end);
+    void DrawRenderItems(ID3D12GraphicsCommandList* pCmdList, uint32_t begin, uint32_t end);
 };
 
 extern "C" DLL_API IRenderer * CreateRenderer(
@@ -2,9 +2,13 @@
 
 #include <d3d12.h>
 #include <DirectXMath.h>
+#include <DirectXCollision.h>
+#include <functional>
 #include <string>
 #include <vector>
 
+class JobSystem;
+
 #define MAX_INFLUENCE_BONE_COUNT  4
 
 struct TexturePath
@@ -57,7 +61,7 @@ struct ResMaterial
     ResMaterial()
         : Diffuse   (0.0f, 0.0f, 0.0f)
         , Specular  (0.0f, 0.0f, 0.0f)
-        , Alpha     (0.0f)
+        , Alpha     (1.0f)
         , Shininess (0.0f)
     {}
 };
@@ -123,9 +127,24 @@ struct ResMesh
     std::vector<uint32_t>   Indices;
     uint32_t                MaterialId;
     std::vector<BoneInfo>   BonesInfo;
+    DirectX::BoundingBox    Bounds;     // local space, around every vertex
 };
 
 bool LoadMesh(
     const wchar_t*              filename,
     std::vector<ResMesh>&       meshes,
     std::vector<ResMaterial>&   materials);
+
+// Hands each mesh to onMesh as soon as it is parsed, in order; returning
+// false aborts the load. With pJobs, the meshes after the one being handed
+// over are parsed as jobs, up to one per thread ahead, so consuming a mesh
+// (e.g. staging its upload) overlaps with parsing the next ones. Without it
+// meshes are parsed on the calling thread. Mesh::Scale is set once every
+// mesh has been handed over.
+typedef std::function<bool(size_t index, ResMesh& mesh)> MeshCallback;
+
+bool LoadMesh(
+    const wchar_t*              filename,
+    const MeshCallback&         onMesh,
+    std::vector<ResMaterial>&   materials,
+    JobSystem*                  pJobs = nullptr);
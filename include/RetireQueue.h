@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+// Defers releasing objects the GPU may still read until a fence value has
+// completed. Releases run in enqueue order; fence values are expected not to
+// decrease, and one that does is raised to the last queued value so the
+// queue stays ordered. Nothing here touches a device: callers pass the fence
+// values in.
+class RetireQueue
+{
+public:
+    typedef std::function<void()> ReleaseFunc;
+
+    RetireQueue();
+    ~RetireQueue();
+
+    // release runs once a completed value of at least fenceValue is collected.
+    void Enqueue(uint64_t fenceValue, ReleaseFunc&& release);
+
+    // Runs the releases whose fence value is at most completedValue and
+    // returns their count.
+    uint32_t Collect(uint64_t completedValue);
+
+    // Runs every pending release. The GPU must be idle.
+    void Flush();
+
+    size_t GetPendingCount() const;
+    uint64_t GetLastFenceValue() const;
+
+private:
+    struct Entry
+    {
+        uint64_t    FenceValue;
+        ReleaseFunc Release;
+    };
+
+    std::deque<Entry>   m_Entries;
+
+    RetireQueue(const RetireQueue&) = delete;
+    void operator = (const RetireQueue&) = delete;
+};
\ No newline at end of file
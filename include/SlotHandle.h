@@ -0,0 +1,54 @@
+#ifndef _SLOT_HANDLE_H_
+#define _SLOT_HANDLE_H_
+
+#include <cstdint>
+
+// 32-bit (index, generation) handle. A handle whose generation no longer
+// matches its slot refers to a freed (or reused) slot and resolves to nothing.
+// Generation 0 is never issued, so a zero handle is always invalid.
+struct SlotHandle
+{
+    static const uint32_t IndexBits      = 20;
+    static const uint32_t GenerationBits = 32 - IndexBits;
+    static const uint32_t IndexMask      = (1u << IndexBits) - 1;
+    static const uint32_t GenerationMask = (1u << GenerationBits) - 1;
+    static const uint32_t MaxIndexCount  = 1u << IndexBits;
+
+    uint32_t Value;
+
+    SlotHandle()
+        : Value(0)
+    {
+    }
+
+    SlotHandle(uint32_t index, uint32_t generation)
+        : Value(((generation & GenerationMask) << IndexBits) | (index & IndexMask))
+    {
+    }
+
+    bool IsValid() const
+    {
+        return Value != 0;
+    }
+
+    uint32_t GetIndex() const
+    {
+        return Value & IndexMask;
+    }
+
+    uint32_t GetGeneration() const
+    {
+        return Value >> IndexBits;
+    }
+
+    static uint32_t NextGeneration(uint32_t generation)
+    {
+        generation = (generation + 1) & GenerationMask;
+        return (generation == 0) ? 1 : generation;
+    }
+
+    bool operator == (const SlotHandle& rhs) const { return Value == rhs.Value; }
+    bool operator != (const SlotHandle& rhs) const { return Value != rhs.Value; }
+};
+
+#endif
\ No newline at end of file
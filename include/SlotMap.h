@@ -0,0 +1,194 @@
+#ifndef _SLOT_MAP_H_
+#define _SLOT_MAP_H_
+
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <vector>
+#include <SlotHandle.h>
+
+// Fixed capacity container addressed by SlotHandle.
+// Live values are kept densely packed (erase swaps the last value into the
+// hole), so iterating all live values is a linear scan of one array; lookups
+// go through one indirection (slot -> dense index).
+// Not thread safe.
+template<typename T>
+class SlotMap
+{
+public:
+    SlotMap()
+        : m_FreeHead(InvalidIndex)
+        , m_Capacity(0)
+    {
+    }
+
+    ~SlotMap()
+    {
+        Term();
+    }
+
+    bool Init(uint32_t count)
+    {
+        if (count == 0 || count > SlotHandle::MaxIndexCount)
+        {
+            return false;
+        }
+
+        m_Capacity = count;
+
+        m_Values.clear();
+        m_Values.reserve(count);
+        m_DenseToSlot.clear();
+        m_DenseToSlot.reserve(count);
+
+        m_Slots.resize(count);
+        for (auto i = 0u; i < count; ++i)
+        {
+            m_Slots[i].DenseIndex = (i + 1 < count) ? i + 1 : InvalidIndex;
+            m_Slots[i].Generation = 1;
+        }
+
+        m_FreeHead = 0;
+
+        return true;
+    }
+
+    void Term()
+    {
+        m_Values.clear();
+        m_DenseToSlot.clear();
+        m_Slots.clear();
+        m_FreeHead = InvalidIndex;
+        m_Capacity = 0;
+    }
+
+    SlotHandle Insert(const T& value)
+    {
+        if (m_FreeHead == InvalidIndex)
+        {
+            return SlotHandle();
+        }
+
+        const auto index = m_FreeHead;
+        auto& slot = m_Slots[index];
+        m_FreeHead = slot.DenseIndex;
+
+        slot.DenseIndex = uint32_t(m_Values.size());
+        m_Values.push_back(value);
+        m_DenseToSlot.push_back(index);
+
+        return SlotHandle(index, slot.Generation);
+    }
+
+    SlotHandle Insert()
+    {
+        return Insert(T());
+    }
+
+    bool Erase(SlotHandle handle)
+    {
+        if (!Contains(handle))
+        {
+            return false;
+        }
+
+        const auto index = handle.GetIndex();
+        auto& slot = m_Slots[index];
+
+        const auto hole = slot.DenseIndex;
+        const auto last = uint32_t(m_Values.size() - 1);
+
+        if (hole != last)
+        {
+            m_Values[hole] = std::move(m_Values[last]);
+            m_DenseToSlot[hole] = m_DenseToSlot[last];
+            m_Slots[m_DenseToSlot[hole]].DenseIndex = hole;
+        }
+
+        m_Values.pop_back();
+        m_DenseToSlot.pop_back();
+
+        slot.Generation = SlotHandle::NextGeneration(slot.Generation);
+        slot.DenseIndex = m_FreeHead;
+        m_FreeHead = index;
+
+        return true;
+    }
+
+    bool Contains(SlotHandle handle) const
+    {
+        if (!handle.IsValid())
+        {
+            return false;
+        }
+
+        const auto index = handle.GetIndex();
+        if (index >= m_Capacity)
+        {
+            return false;
+        }
+
+        return m_Slots[index].Generation == handle.GetGeneration();
+    }
+
+    T* Get(SlotHandle handle)
+    {
+        return Contains(handle) ? &m_Values[m_Slots[handle.GetIndex()].DenseIndex] : nullptr;
+    }
+
+    const T* Get(SlotHandle handle) const
+    {
+        return Contains(handle) ? &m_Values[m_Slots[handle.GetIndex()].DenseIndex] : nullptr;
+    }
+
+    // Handle of the value stored at the given dense position.
+    SlotHandle GetHandle(uint32_t denseIndex) const
+    {
+        assert(denseIndex < m_DenseToSlot.size());
+        const auto index = m_DenseToSlot[denseIndex];
+        return SlotHandle(index, m_Slots[index].Generation);
+    }
+
+    T*       GetData()       { return m_Values.data(); }
+    const T* GetData() const { return m_Values.data(); }
+
+    T*       begin()       { return m_Values.data(); }
+    T*       end()         { return m_Values.data() + m_Values.size(); }
+    const T* begin() const { return m_Values.data(); }
+    const T* end()   const { return m_Values.data() + m_Values.size(); }
+
+    uint32_t GetSize() const
+    {
+        return m_Capacity;
+    }
+
+    uint32_t GetUsedCount() const
+    {
+        return uint32_t(m_Values.size());
+    }
+
+    uint32_t GetAvailableCount() const
+    {
+        return m_Capacity - GetUsedCount();
+    }
+
+private:
+    static const uint32_t InvalidIndex = uint32_t(-1);
+
+    struct Slot
+    {
+        uint32_t DenseIndex;    // next free slot while the slot is free
+        uint32_t Generation;
+    };
+
+    std::vector<T>          m_Values;
+    std::vector<uint32_t>   m_DenseToSlot;
+    std::vector<Slot>       m_Slots;
+    uint32_t                m_FreeHead;
+    uint32_t                m_Capacity;
+
+    SlotMap(const SlotMap&) = delete;
+    void operator = (const SlotMap&) = delete;
+};
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// Draw order group; blended items are drawn after the opaque ones.
+enum RENDER_PASS
+{
+    RENDER_PASS_OPAQUE = 0,     // sorted by state, then front to back
+    RENDER_PASS_BLEND  = 1,     // sorted back to front
+};
+
+// Materials with less than full opacity are drawn in the blend pass.
+inline RENDER_PASS GetRenderPass(float alpha)
+{
+    return (alpha < 1.0f) ? RENDER_PASS_BLEND : RENDER_PASS_OPAQUE;
+}
+
+// The top bits of a positive view depth. Smaller depth gives a smaller
+// value; zero, negative and NaN depths give 0.
+uint32_t QuantizeDepth(float depth);
+
+// 64-bit draw order key; sorting keys ascending gives the draw order.
+// Fields wider than their bits are truncated.
+uint64_t MakeSortKey(RENDER_PASS pass, uint32_t pso, uint32_t material, uint32_t mesh, float depth);
\ No newline at end of file
@@ -0,0 +1,303 @@
+#ifndef _TABLE_CACHE_H_
+#define _TABLE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+// Cache of descriptor tables keyed on the source descriptors they were built
+// from, so that identical combinations share one table.
+//
+// Entries are reference counted. An entry whose count drops to zero stays in
+// the cache in least-recently-released order and is handed out again if the
+// same key comes back. Trim() evicts unreferenced entries beyond the
+// configured limit, oldest first, but only once the retire value given to
+// Release() has completed (e.g. a fence value), so the GPU no longer reads
+// them. The cache only stores values; the caller owns whatever they refer to.
+//
+// Device independent and not thread safe.
+template<typename TValue, uint32_t KeySize>
+class TableCache
+{
+public:
+    typedef std::array<uint32_t, KeySize> Key;
+
+    static const uint32_t InvalidIndex = uint32_t(-1);
+
+    TableCache()
+        : m_LruHead(InvalidIndex)
+        , m_LruTail(InvalidIndex)
+        , m_UnusedCount(0)
+        , m_MaxUnusedCount(0)
+        , m_HitCount(0)
+        , m_MissCount(0)
+    {
+    }
+
+    ~TableCache()
+    {
+        Term();
+    }
+
+    void Init(uint32_t maxUnusedCount)
+    {
+        Term();
+        m_MaxUnusedCount = maxUnusedCount;
+    }
+
+    void Term()
+    {
+        m_Entries.clear();
+        m_FreeEntries.clear();
+        m_Lookup.clear();
+
+        m_LruHead     = InvalidIndex;
+        m_LruTail     = InvalidIndex;
+        m_UnusedCount = 0;
+        m_HitCount    = 0;
+        m_MissCount   = 0;
+    }
+
+    // Returns the entry for key with its reference count incremented, or
+    // InvalidIndex if the key is not cached.
+    uint32_t Acquire(const Key& key)
+    {
+        auto itr = m_Lookup.find(key);
+        if (itr == m_Lookup.end())
+        {
+            m_MissCount++;
+            return InvalidIndex;
+        }
+
+        m_HitCount++;
+
+        const auto index = itr->second;
+        auto& entry = m_Entries[index];
+        if (entry.RefCount == 0)
+        {
+            Unlink(index);
+            m_UnusedCount--;
+        }
+
+        entry.RefCount++;
+        return index;
+    }
+
+    // Adds a new entry with a reference count of one. The key must not be cached.
+    uint32_t Insert(const Key& key, const TValue& value)
+    {
+        assert(m_Lookup.find(key) == m_Lookup.end());
+
+        uint32_t index;
+        if (!m_FreeEntries.empty())
+        {
+            index = m_FreeEntries.back();
+            m_FreeEntries.pop_back();
+        }
+        else
+        {
+            index = uint32_t(m_Entries.size());
+            m_Entries.push_back(Entry());
+        }
+
+        auto& entry = m_Entries[index];
+        entry.TableKey    = key;
+        entry.Value       = value;
+        entry.RefCount    = 1;
+        entry.RetireValue = 0;
+        entry.PrevLru     = InvalidIndex;
+        entry.NextLru     = InvalidIndex;
+        entry.Live        = true;
+
+        m_Lookup[key] = index;
+        return index;
+    }
+
+    // Drops one reference. The entry may be evicted once retireValue completes.
+    void Release(uint32_t index, uint64_t retireValue)
+    {
+        if (index >= m_Entries.size() || !m_Entries[index].Live)
+        {
+            return;
+        }
+
+        auto& entry = m_Entries[index];
+        assert(entry.RefCount > 0);
+
+        entry.RetireValue = retireValue;
+        if (--entry.RefCount > 0)
+        {
+            return;
+        }
+
+        // Append as most recently released.
+        entry.PrevLru = m_LruTail;
+        entry.NextLru = InvalidIndex;
+        if (m_LruTail != InvalidIndex)
+        {
+            m_Entries[m_LruTail].NextLru = index;
+        }
+        else
+        {
+            m_LruHead = index;
+        }
+        m_LruTail = index;
+
+        m_UnusedCount++;
+    }
+
+    // Evicts unreferenced entries beyond the limit whose retire value is at
+    // most completedValue, calling func(value) for each. Returns the count.
+    template<typename Func>
+    uint32_t Trim(uint64_t completedValue, Func&& func)
+    {
+        uint32_t count = 0;
+        while (m_UnusedCount > m_MaxUnusedCount && m_LruHead != InvalidIndex)
+        {
+            const auto index = m_LruHead;
+            if (m_Entries[index].RetireValue > completedValue)
+            {
+                break;
+            }
+
+            Evict(index, func);
+            count++;
+        }
+
+        return count;
+    }
+
+    // Evicts every entry, referenced or not.
+    template<typename Func>
+    void Clear(Func&& func)
+    {
+        for (auto& entry : m_Entries)
+        {
+            if (entry.Live)
+            {
+                func(entry.Value);
+            }
+        }
+
+        const auto maxUnused = m_MaxUnusedCount;
+        Term();
+        m_MaxUnusedCount = maxUnused;
+    }
+
+    TValue* Get(uint32_t index)
+    {
+        return (index < m_Entries.size() && m_Entries[index].Live) ? &m_Entries[index].Value : nullptr;
+    }
+
+    const TValue* Get(uint32_t index) const
+    {
+        return (index < m_Entries.size() && m_Entries[index].Live) ? &m_Entries[index].Value : nullptr;
+    }
+
+    uint32_t GetCount() const
+    {
+        return uint32_t(m_Lookup.size());
+    }
+
+    uint32_t GetUnusedCount() const
+    {
+        return m_UnusedCount;
+    }
+
+    uint64_t GetHitCount() const
+    {
+        return m_HitCount;
+    }
+
+    uint64_t GetMissCount() const
+    {
+        return m_MissCount;
+    }
+
+private:
+    // FNV-1a over the key words.
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (auto value : key)
+            {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            }
+
+            return size_t(hash);
+        }
+    };
+
+    struct Entry
+    {
+        Key         TableKey;
+        TValue      Value;
+        uint32_t    RefCount;
+        uint64_t    RetireValue;
+        uint32_t    PrevLru;
+        uint32_t    NextLru;
+        bool        Live;
+    };
+
+    std::vector<Entry>                          m_Entries;
+    std::vector<uint32_t>                       m_FreeEntries;
+    std::unordered_map<Key, uint32_t, KeyHash>  m_Lookup;
+    uint32_t                                    m_LruHead;      // least recently released
+    uint32_t                                    m_LruTail;
+    uint32_t                                    m_UnusedCount;
+    uint32_t                                    m_MaxUnusedCount;
+    uint64_t                                    m_HitCount;
+    uint64_t                                    m_MissCount;
+
+    void Unlink(uint32_t index)
+    {
+        auto& entry = m_Entries[index];
+
+        if (entry.PrevLru != InvalidIndex)
+        {
+            m_Entries[entry.PrevLru].NextLru = entry.NextLru;
+        }
+        else
+        {
+            m_LruHead = entry.NextLru;
+        }
+
+        if (entry.NextLru != InvalidIndex)
+        {
+            m_Entries[entry.NextLru].PrevLru = entry.PrevLru;
+        }
+        else
+        {
+            m_LruTail = entry.PrevLru;
+        }
+
+        entry.PrevLru = InvalidIndex;
+        entry.NextLru = InvalidIndex;
+    }
+
+    template<typename Func>
+    void Evict(uint32_t index, Func& func)
+    {
+        auto& entry = m_Entries[index];
+
+        Unlink(index);
+        m_UnusedCount--;
+
+        func(entry.Value);
+
+        m_Lookup.erase(entry.TableKey);
+        entry.Live = false;
+        m_FreeEntries.push_back(index);
+    }
+
+    TableCache(const TableCache&) = delete;
+    void operator = (const TableCache&) = delete;
+};
+
+#endif
\ No newline at end of file
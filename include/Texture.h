@@ -3,9 +3,8 @@
 #include <d3d12.h>
 #include <ComPtr.h>
 #include <ResourceUploadBatch.h>
-
-class DescriptorHandle;
-class DescriptorPool;
+#include <DescriptorPool.h>
+#include <GpuAllocator.h>
 
 class Texture
 {
@@ -28,6 +27,7 @@ public:
 
     bool Init(
         ID3D12Device*               pDevice,
+        GpuAllocator*               pAllocator,
         DescriptorPool*             pPool,
         const D3D12_RESOURCE_DESC*  pDesc,
         bool                        isCube);
@@ -37,9 +37,16 @@ public:
     D3D12_CPU_DESCRIPTOR_HANDLE GetHandleCPU() const;
     D3D12_GPU_DESCRIPTOR_HANDLE GetHandleGPU() const;
 
+    // Index of the SRV in the pool's shader-visible heap, for bindless access.
+    // Unlike the GPU handle it stays the same when the pool rehomes.
+    uint32_t GetHeapIndex() const;
+    DescriptorId GetHandleId() const;
+
 private:
     ComPtr<ID3D12Resource>  m_pTex;
-    DescriptorHandle*       m_pHandle;
+    GpuAllocator*           m_pAllocator;       // null for textures loaded from files
+    GpuAllocation           m_Allocation;
+    DescriptorId            m_HandleId;
     DescriptorPool*         m_pPool;
 
     Texture(const Texture&) = delete;
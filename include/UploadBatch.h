@@ -0,0 +1,71 @@
+#pragma once
+
+#include <d3d12.h>
+#include <ComPtr.h>
+#include <CommandList.h>
+#include <Fence.h>
+#include <UploadBuffer.h>
+#include <vector>
+
+// Records buffer uploads into a single command list on a dedicated copy
+// queue. Source data is staged in upload chunks that are sub-allocated
+// linearly; End() submits everything with one fence signal, and the chunks
+// are recycled once that fence has completed.
+//
+// Destination buffers must be in the COMMON state. They are promoted to
+// COPY_DEST by the copy and decay back to COMMON when it completes, so the
+// direct queue can use them as vertex/index buffers without barriers.
+class UploadBatch
+{
+public:
+    UploadBatch();
+    ~UploadBatch();
+
+    bool Init(ID3D12Device* pDevice, UINT64 chunkSize = DefaultChunkSize);
+    void Term();
+
+    bool Begin();
+
+    // Stages size bytes of pData and records a copy to pDst at dstOffset.
+    bool Upload(ID3D12Resource* pDst, UINT64 dstOffset, const void* pData, UINT64 size);
+
+    // Submits the recorded copies. If pWaitQueue is given it waits for them
+    // on the GPU, so work submitted to it afterwards sees the data without
+    // the CPU blocking. Returns the fence value of the batch.
+    UINT64 End(ID3D12CommandQueue* pWaitQueue = nullptr);
+
+    // Blocks until every submitted batch has completed.
+    void Flush();
+
+    UINT64 GetStagedSize() const;
+
+    static const UINT64 DefaultChunkSize = 8 * 1024 * 1024;
+
+private:
+    static const size_t MaxFreeChunkCount = 2;
+
+    struct Chunk
+    {
+        UploadBuffer*   pBuffer;
+        UINT64          Offset;
+        UINT64          FenceValue;
+    };
+
+    ComPtr<ID3D12Device>        m_pDevice;
+    ComPtr<ID3D12CommandQueue>  m_pQueue;
+    CommandList                 m_CommandList;
+    Fence                       m_Fence;
+    ID3D12GraphicsCommandList*  m_pCmd;
+    UINT64                      m_ChunkSize;
+    UINT64                      m_LastFenceValue;
+    UINT64                      m_StagedSize;
+    std::vector<Chunk>          m_Active;       // recorded into the open batch
+    std::vector<Chunk>          m_Pending;      // submitted, not yet completed
+    std::vector<Chunk>          m_Free;
+
+    bool Alloc(UINT64 size, UploadBuffer*& pBuffer, UINT64& offset);
+    void Recycle(UINT64 completedValue);
+
+    UploadBatch(const UploadBatch&) = delete;
+    void operator = (const UploadBatch&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <d3d12.h>
+#include <ComPtr.h>
+
+// Buffer on the upload heap that stays mapped for its whole lifetime.
+class UploadBuffer
+{
+public:
+    UploadBuffer();
+    ~UploadBuffer();
+
+    bool Init(ID3D12Device* pDevice, UINT64 size);
+    void Term();
+
+    ID3D12Resource* GetResource() const;
+    D3D12_GPU_VIRTUAL_ADDRESS GetAddress() const;
+    UINT64 GetSize() const;
+
+    void* GetPtr() const;
+
+    template<typename T>
+    T* GetPtr() const
+    {
+        return reinterpret_cast<T*>(GetPtr());
+    }
+
+private:
+    ComPtr<ID3D12Resource>  m_pBuffer;
+    void*                   m_pMappedPtr;
+    UINT64                  m_Size;
+
+    UploadBuffer(const UploadBuffer&) = delete;
+    void operator = (const UploadBuffer&) = delete;
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <d3d12.h>
+#include <ComPtr.h>
+#include <FrameRing.h>
+#include <UploadBuffer.h>
+#include <vector>
+
+// Persistently mapped upload buffer shared by the frames in flight. Each frame
+// bump-allocates from its own partition and a partition is recycled once the
+// fence value of the frame that last used it has completed (see FrameRing).
+//
+// A frame that runs out of space moves to a buffer twice as large; the old
+// buffer is kept alive until that frame's fence value completes.
+class UploadRing
+{
+public:
+    struct Allocation
+    {
+        void*                       pCPU;
+        D3D12_GPU_VIRTUAL_ADDRESS   Address;
+        ID3D12Resource*             pResource;  // buffer holding it, for views
+        UINT64                      Offset;     // from the start of pResource
+    };
+
+    UploadRing();
+    ~UploadRing();
+
+    bool Init(ID3D12Device* pDevice, uint32_t sizePerFrame, uint32_t frameCount);
+    void Term();
+
+    bool BeginFrame(uint32_t frameIndex, uint64_t completedValue);
+    void EndFrame(uint64_t fenceValue);
+
+    bool Alloc(
+        uint32_t    size,
+        Allocation& allocation,
+        uint32_t    alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+    uint32_t GetUsedSize() const;
+    uint32_t GetSizePerFrame() const;
+
+private:
+    static const uint64_t PendingFence = UINT64_MAX;
+
+    struct RetiredBuffer
+    {
+        ComPtr<ID3D12Resource>  pBuffer;
+        uint64_t                FenceValue;
+    };
+
+    ComPtr<ID3D12Device>        m_pDevice;
+    UploadBuffer                m_Buffer;
+    uint8_t*                    m_pMappedPtr;
+    D3D12_GPU_VIRTUAL_ADDRESS   m_Address;
+    FrameRing                   m_Ring;
+    uint32_t                    m_FrameCount;
+    uint32_t                    m_FrameIndex;
+    std::vector<RetiredBuffer>  m_Retired;
+
+    bool CreateBuffer(uint32_t sizePerFrame);
+    bool Grow(uint32_t size, uint32_t alignment);
+
+    UploadRing(const UploadRing&) = delete;
+    void operator = (const UploadRing&) = delete;
+};
\ No newline at end of file
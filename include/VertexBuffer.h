@@ -2,8 +2,8 @@
 
 #include <d3d12.h>
 #include <ComPtr.h>
-#include <CommandList.h>
-#include <Fence.h>
+#include <GpuAllocator.h>
+#include <UploadBatch.h>
 
 class VertexBuffer
 {
@@ -11,25 +11,22 @@ public:
     VertexBuffer();
     ~VertexBuffer();
 
+    // The initial data is copied when pBatch is submitted.
     bool Init(
-        ID3D12Device* pDevice,
-        ID3D12CommandQueue* pQueue,
-        CommandList* pCmdList,
-        Fence* pFence,
+        GpuAllocator* pAllocator,
+        UploadBatch* pBatch,
         size_t size, 
         size_t stride, 
         const void* pInitData = nullptr);
 
     template<typename T>
     bool Init(
-        ID3D12Device* pDevice,
-        ID3D12CommandQueue* pQueue,
-        CommandList* pCmdList,
-        Fence* pFence,
+        GpuAllocator* pAllocator,
+        UploadBatch* pBatch,
         size_t size, 
         const T* pInitData = nullptr)
     {
-        return Init(pDevice, pQueue, pCmdList, pFence, size, sizeof(T), pInitData);
+        return Init(pAllocator, pBatch, size, sizeof(T), pInitData);
     }
 
     void Term();
@@ -43,10 +40,13 @@ public:
         return reinterpret_cast<T*>(Map());
     }
 
+    ID3D12Resource* GetResource() const;
     D3D12_VERTEX_BUFFER_VIEW GetView() const;
 
 private:
     ComPtr<ID3D12Resource>   m_pVB;
+    GpuAllocator*            m_pAllocator;
+    GpuAllocation            m_Allocation;
     D3D12_VERTEX_BUFFER_VIEW m_View;
 
     VertexBuffer(const VertexBuffer&) = delete;
@@ -0,0 +1,159 @@
+#ifndef _WORK_STEALING_DEQUE_H_
+#define _WORK_STEALING_DEQUE_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+// Chase-Lev work-stealing deque of pointers, after "Correct and Efficient
+// Work-Stealing for Weak Memory Models" (Le et al.). The owner thread pushes
+// and pops at the bottom in LIFO order; any other thread steals from the top.
+// The capacity is fixed: Push() fails instead of growing, and the caller is
+// expected to run the work itself.
+template<typename T>
+class WorkStealingDeque
+{
+public:
+    WorkStealingDeque()
+        : m_Top(0)
+        , m_Bottom(0)
+        , m_pBuffer(nullptr)
+        , m_Mask(0)
+    {
+    }
+
+    ~WorkStealingDeque()
+    {
+        Term();
+    }
+
+    // capacity must be a power of two.
+    bool Init(uint32_t capacity)
+    {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+        {
+            return false;
+        }
+
+        Term();
+
+        m_pBuffer = static_cast<std::atomic<T*>*>(malloc(sizeof(std::atomic<T*>) * capacity));
+        if (m_pBuffer == nullptr)
+        {
+            return false;
+        }
+
+        for (auto i = 0u; i < capacity; ++i)
+        {
+            new (&m_pBuffer[i]) std::atomic<T*>(nullptr);
+        }
+
+        m_Mask = int64_t(capacity) - 1;
+        m_Top.store(0, std::memory_order_relaxed);
+        m_Bottom.store(0, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    void Term()
+    {
+        if (m_pBuffer != nullptr)
+        {
+            free(m_pBuffer);
+            m_pBuffer = nullptr;
+        }
+
+        m_Mask = 0;
+        m_Top.store(0, std::memory_order_relaxed);
+        m_Bottom.store(0, std::memory_order_relaxed);
+    }
+
+    // Owner thread only.
+    bool Push(T* pValue)
+    {
+        const auto b = m_Bottom.load(std::memory_order_relaxed);
+        const auto t = m_Top.load(std::memory_order_acquire);
+        if (b - t > m_Mask)
+        {
+            return false;
+        }
+
+        m_pBuffer[b & m_Mask].store(pValue, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(b + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    // Owner thread only. Returns nullptr when empty.
+    T* Pop()
+    {
+        const auto b = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = m_Top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            m_Bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto pValue = m_pBuffer[b & m_Mask].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last item: race the thieves for it through top.
+            if (!m_Top.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                pValue = nullptr;
+            }
+            m_Bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        return pValue;
+    }
+
+    // Any thread. Returns nullptr when empty or when another thread won the
+    // race for the top item.
+    T* Steal()
+    {
+        auto t = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = m_Bottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+        {
+            return nullptr;
+        }
+
+        auto pValue = m_pBuffer[t & m_Mask].load(std::memory_order_acquire);
+        if (!m_Top.compare_exchange_strong(
+            t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return pValue;
+    }
+
+    // Approximate when other threads are pushing or stealing.
+    bool IsEmpty() const
+    {
+        return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Top is written by thieves and bottom by the owner; keep them on
+    // separate cache lines.
+    alignas(64) std::atomic<int64_t>    m_Top;
+    alignas(64) std::atomic<int64_t>    m_Bottom;
+    std::atomic<T*>*                    m_pBuffer;
+    int64_t                             m_Mask;
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    void operator = (const WorkStealingDeque&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@ struct VSOutput
     float2 TexCoord          : TEXCOORD;
     float4 WorldPos          : WORLD_POS;
     float3x3 InvTangentBasis : INV_TANGENT_BASIS;
+    nointerpolation uint ObjectIndex : OBJECT_INDEX;
 };
 
 struct PSOutput
@@ -14,43 +15,67 @@ struct PSOutput
 
 struct Light
 {
-    float3 Color;     //  
-    float Range;      // Ʈ/ƮƮ 
-    float3 Direction; // 𷺼ų/ƮƮ 
-    float SpotPower;  // ƮƮ 
-    float3 Position;  // ƮƮ 
+    float3 Color;     // 빛의 세기
+    float Range;      // 포인트/스포트라이트 전용
+    float3 Direction; // 디렉셔널/스포트라이트 전용
+    float SpotPower;  // 스포트라이트 전용
+    float3 Position;  // 포인트라이트 전용
     float pad;
 };
 
-cbuffer LightBuffer : register(b1)
+// The layouts match the C++ structs in FrameResource.h.
+static const uint OBJECT_FLAG_SHADOW = 0x1;
+
+struct ObjectData
 {
-    Light DirLight;
-    Light PointLight;
-    Light SpotLight;
-}
+    float4x4 World;
+    uint     MaterialIndex;
+    uint     Flags;
+    uint2    Pad;
+};
 
-cbuffer MaterialBuffer : register(b2)
+struct MaterialData
 {
-    float3 Diffuse  : packoffset(c0);
-    float  Alpha    : packoffset(c0.w);
-    float3 Specular : packoffset(c1);
-    float Shininess : packoffset(c1.w);
-}
+    float3 Diffuse;
+    float  Alpha;
+    float3 Specular;
+    float  Shininess;
+    uint   DiffuseMapIndex;
+    uint   NormalMapIndex;
+    uint   SpecularMapIndex;
+    uint   Pad0;
+};
 
-cbuffer PassConstantBuffer : register(b3)
+cbuffer PassConstants : register(b1)
 {
-    float3 CameraPosition  : packoffset(c0);
-    float4 AmbientLight    : packoffset(c1);
-    int DiffuseMapUsable   : packoffset(c2.x);
-    int SpecularMapUsable  : packoffset(c2.y);
-    int ShininessMapUsable : packoffset(c2.z);
-    int NormalMapUsable    : packoffset(c2.w);
+    float4x4 ViewProj;
+    Light    DirLight;
+    Light    PointLight;
+    Light    SpotLight;
+    float3   CameraPosition;
+    float    Pad0;
+    float4   AmbientLight;
+    int      DiffuseMapUsable;
+    int      SpecularMapUsable;
+    int      ShininessMapUsable;
+    int      NormalMapUsable;
 }
 
-SamplerState ColorSmp    : register(s0);
-Texture2D    ColorMap    : register(t0);
-Texture2D    NormalMap   : register(t1);
-Texture2D    SpecularMap : register(t2);
+// Objects are indexed by the vertex shader's ObjectIndex, materials by the
+// object's MaterialIndex.
+StructuredBuffer<ObjectData>   Objects   : register(t0);
+StructuredBuffer<MaterialData> Materials : register(t1);
+
+SamplerState ColorSmp : register(s0);
+
+#ifdef BINDLESS
+// Every SRV of the resource heap; materials carry heap indices.
+Texture2D    Textures[]  : register(t0, space1);
+#else
+Texture2D    ColorMap    : register(t0, space1);
+Texture2D    NormalMap   : register(t1, space1);
+Texture2D    SpecularMap : register(t2, space1);
+#endif
 
 float3 GetLightFromDirLight(float3 normal);
 float3 GetLightFromPointLight(float3 normal);
@@ -69,19 +94,50 @@ float3 ComputePhong(
     float3 lightColor,
     float3 normal);
 
-static VSOutput g_Input;
+static VSOutput     g_Input;
+static ObjectData   g_Object;
+static MaterialData g_Material;
+
+float4 SampleColorMap(float2 uv)
+{
+#ifdef BINDLESS
+    return Textures[g_Material.DiffuseMapIndex].Sample(ColorSmp, uv);
+#else
+    return ColorMap.Sample(ColorSmp, uv);
+#endif
+}
+
+float4 SampleNormalMap(float2 uv)
+{
+#ifdef BINDLESS
+    return Textures[g_Material.NormalMapIndex].Sample(ColorSmp, uv);
+#else
+    return NormalMap.Sample(ColorSmp, uv);
+#endif
+}
+
+float4 SampleSpecularMap(float2 uv)
+{
+#ifdef BINDLESS
+    return Textures[g_Material.SpecularMapIndex].Sample(ColorSmp, uv);
+#else
+    return SpecularMap.Sample(ColorSmp, uv);
+#endif
+}
 
 PSOutput main(VSOutput input)
 {
     PSOutput output = (PSOutput) 0;
-    g_Input = input;
+    g_Input    = input;
+    g_Object   = Objects[input.ObjectIndex];
+    g_Material = Materials[g_Object.MaterialIndex];
     
     // Normal vector
     float3 N;
     
     if(NormalMapUsable)
     {
-        N = NormalMap.Sample(ColorSmp, input.TexCoord).xyz * 2.0f - 1.0f;
+        N = SampleNormalMap(input.TexCoord).xyz * 2.0f - 1.0f;
         N = mul(input.InvTangentBasis, N);
     }
     else
@@ -97,7 +153,7 @@ PSOutput main(VSOutput input)
     
     if(DiffuseMapUsable)
     {
-        color = ColorMap.Sample(ColorSmp, input.TexCoord);
+        color = SampleColorMap(input.TexCoord);
     }
     else
     {
@@ -105,7 +161,9 @@ PSOutput main(VSOutput input)
     }
     
     float3 light = dirLight + ptLight + sptLight;
-    output.Color = float4(color.rgb * light, color.a * Alpha);
+    if (g_Object.Flags & OBJECT_FLAG_SHADOW)
+        light = float3(0.0f, 0.0f, 0.0f);
+    output.Color = float4(color.rgb * light, color.a * g_Material.Alpha);
     return output;
 }
 
@@ -170,7 +228,7 @@ float3 ComputeLambert
     float3 normal
 )
 {
-    return lightColor * Diffuse * saturate(dot(lightDir, normal) * -1);
+    return lightColor * g_Material.Diffuse * saturate(dot(lightDir, normal) * -1);
 }
 
 float3 ComputePhong
@@ -184,9 +242,9 @@ float3 ComputePhong
     float3 V = normalize(CameraPosition - worldPos.xyz);
     float3 R = normalize(reflect(lightDir, normal));
     
-    float3 S = Specular;
+    float3 S = g_Material.Specular;
     if (SpecularMapUsable)
-        S = SpecularMap.Sample(ColorSmp, g_Input.TexCoord).xyz;
+        S = SampleSpecularMap(g_Input.TexCoord).xyz;
 
-    return lightColor * S * pow(saturate(dot(V, R)), Shininess);
+    return lightColor * S * pow(saturate(dot(V, R)), g_Material.Shininess);
 }
\ No newline at end of file
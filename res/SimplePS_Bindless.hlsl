@@ -0,0 +1,3 @@
+// SimplePS with materials indexing every texture of the resource heap.
+#define BINDLESS
+#include "SimplePS.hlsl"
\ No newline at end of file
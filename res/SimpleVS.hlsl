@@ -13,23 +13,44 @@ struct VSOutput
     float2 TexCoord          : TEXCOORD;
     float4 WorldPos          : WORLD_POS;
     float3x3 InvTangentBasis : INV_TANGENT_BASIS;
+    nointerpolation uint ObjectIndex : OBJECT_INDEX;
 };
 
-cbuffer Transform : register(b0)
+// Matches ObjectBuffer in FrameResource.h.
+struct ObjectData
 {
-    float4x4 World : packoffset(c0);
-    float4x4 View  : packoffset(c4);
-    float4x4 Proj  : packoffset(c8);
+    float4x4 World;
+    uint     MaterialIndex;
+    uint     Flags;
+    uint2    Pad;
+};
+
+// Instances of a draw are consecutive in Instances, which maps them to
+// their objects: Instances[FirstInstance + SV_InstanceID].
+cbuffer DrawConstants : register(b0)
+{
+    uint FirstInstance;
+}
+
+// Leading part of PassConstant; the rest is only read by the pixel shader.
+cbuffer PassConstants : register(b1)
+{
+    float4x4 ViewProj;
 }
 
-VSOutput main(VSInput input)
+StructuredBuffer<ObjectData> Objects   : register(t0);
+StructuredBuffer<uint>       Instances : register(t2);
+
+VSOutput main(VSInput input, uint instanceID : SV_InstanceID)
 {
     VSOutput output = (VSOutput) 0;
 
+    uint objectIndex = Instances[FirstInstance + instanceID];
+    float4x4 World = Objects[objectIndex].World;
+
     float4 localPos = float4(input.Position, 1.0f);
     float4 worldPos = mul(World, localPos);
-    float4 viewPos = mul(View, worldPos);
-    float4 projPos = mul(Proj, viewPos);
+    float4 projPos = mul(ViewProj, worldPos);
 
     output.Position = projPos;
     output.TexCoord = input.TexCoord;
@@ -41,6 +62,7 @@ VSOutput main(VSInput input)
     
     output.InvTangentBasis = transpose(float3x3(T, B, N));
     output.Normal = N;
+    output.ObjectIndex = objectIndex;
     
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include <ChunkRecorder.h>
+#include <JobSystem.h>
+#include <algorithm>
+
+ChunkLayout PartitionChunks(uint32_t drawCount, uint32_t maxChunks, uint32_t minDraws)
+{
+    minDraws = std::max(minDraws, 1u);
+
+    auto count = (drawCount + minDraws - 1) / minDraws;
+    count = std::max(1u, std::min(count, maxChunks));
+
+    ChunkLayout layout;
+    layout.Count = count;
+    layout.Size  = (drawCount + count - 1) / count;
+    return layout;
+}
+
+uint32_t RecordChunks
+(
+    JobSystem&      jobs,
+    IChunkRecorder* pRecorder,
+    uint32_t        drawCount,
+    uint32_t        maxChunks,
+    uint32_t        minDraws
+)
+{
+    const auto layout = PartitionChunks(drawCount, maxChunks, minDraws);
+
+    jobs.ParallelFor(layout.Count, 1, [&](uint32_t first, uint32_t last)
+    {
+        for (auto i = first; i < last; ++i)
+        {
+            const auto begin = std::min(i * layout.Size, drawCount);
+            const auto end   = std::min(begin + layout.Size, drawCount);
+            pRecorder->RecordChunk(i, begin, end);
+        }
+    });
+
+    return layout.Count;
+}
\ No newline at end of file
@@ -3,7 +3,8 @@
 
 ConstantBuffer::ConstantBuffer()
     : m_pCB(nullptr)
-    , m_pHandle(nullptr)
+    , m_pAllocator(nullptr)
+    , m_HandleId()
     , m_pPool(nullptr)
     , m_pMappedPtr(nullptr)
 {
@@ -17,16 +18,17 @@ ConstantBuffer::~ConstantBuffer()
 bool ConstantBuffer::Init
 (
     ID3D12Device*   pDevice,
+    GpuAllocator*   pAllocator,
     DescriptorPool* pPool,
     size_t          size,
     int             count
 )
 {
-    if (pDevice == nullptr || pPool == nullptr || size == 0)
+    if (pDevice == nullptr || pAllocator == nullptr || pPool == nullptr || size == 0)
         return false;
 
     assert(m_pPool == nullptr);
-    assert(m_pHandle == nullptr);
+    assert(!m_HandleId.IsValid());
 
     m_pPool = pPool;
     m_pPool->AddRef();
@@ -36,13 +38,6 @@ bool ConstantBuffer::Init
 
     m_ElementSize = sizeAligned;
 
-    D3D12_HEAP_PROPERTIES prop = {};
-    prop.Type = D3D12_HEAP_TYPE_UPLOAD;
-    prop.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    prop.CreationNodeMask = 1;
-    prop.VisibleNodeMask = 1;
-
     D3D12_RESOURCE_DESC desc = {};
     desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
     desc.Alignment = 0;
@@ -56,25 +51,31 @@ bool ConstantBuffer::Init
     desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     desc.Flags = D3D12_RESOURCE_FLAG_NONE;
 
-    auto hr = pDevice->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
+    auto hr = pAllocator->CreateResource(
+        D3D12_HEAP_TYPE_UPLOAD,
         &desc,
         D3D12_RESOURCE_STATE_GENERIC_READ,
         nullptr,
+        m_Allocation,
         IID_PPV_ARGS(m_pCB.GetAddressOf()));
     if (FAILED(hr))
         return false;
 
+    m_pAllocator = pAllocator;
+
     hr = m_pCB->Map(0, nullptr, &m_pMappedPtr);
     if (FAILED(hr))
         return false;
 
     m_Desc.BufferLocation = m_pCB->GetGPUVirtualAddress();
     m_Desc.SizeInBytes = UINT(sizeAligned) * count;
-    m_pHandle = pPool->AllocHandle();
+    m_HandleId = pPool->AllocId();
+    auto pHandle = pPool->GetHandle(m_HandleId);
+    if (pHandle == nullptr)
+        return false;
 
-    pDevice->CreateConstantBufferView(&m_Desc, m_pHandle->HandleCPU);
+    pDevice->CreateConstantBufferView(&m_Desc, pHandle->HandleCPU);
+    pPool->MarkDirty(m_HandleId);
 
     return true;
 }
@@ -87,10 +88,15 @@ void ConstantBuffer::Term()
         m_pCB.Reset();
     }
 
+    if (m_pAllocator != nullptr)
+    {
+        m_pAllocator->Free(m_Allocation);
+        m_pAllocator = nullptr;
+    }
+
     if (m_pPool != nullptr)
     {
-        m_pPool->FreeHandle(m_pHandle);
-        m_pHandle = nullptr;
+        m_pPool->FreeId(m_HandleId);
     }
 
     if (m_pPool != nullptr)
@@ -109,18 +115,20 @@ D3D12_GPU_VIRTUAL_ADDRESS ConstantBuffer::GetAddress() const
 
 D3D12_CPU_DESCRIPTOR_HANDLE ConstantBuffer::GetHandleCPU() const
 {
-    if (m_pHandle == nullptr)
+    auto pHandle = (m_pPool != nullptr) ? m_pPool->GetHandle(m_HandleId) : nullptr;
+    if (pHandle == nullptr)
         return D3D12_CPU_DESCRIPTOR_HANDLE();
 
-    return m_pHandle->HandleCPU;
+    return pHandle->HandleCPU;
 }
 
 D3D12_GPU_DESCRIPTOR_HANDLE ConstantBuffer::GetHandleGPU() const
 {
-    if (m_pHandle == nullptr)
+    auto pHandle = (m_pPool != nullptr) ? m_pPool->GetHandle(m_HandleId) : nullptr;
+    if (pHandle == nullptr)
         return D3D12_GPU_DESCRIPTOR_HANDLE();
 
-    return m_pHandle->HandleGPU;
+    return pHandle->HandleGPU;
 }
 
 void* ConstantBuffer::GetPtr() const
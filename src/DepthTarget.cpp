@@ -3,7 +3,8 @@
 
 DepthTarget::DepthTarget()
     : m_pTarget(nullptr)
-    , m_pHandleDSV(nullptr)
+    , m_pAllocator(nullptr)
+    , m_HandleDSVId()
     , m_pPoolDSV(nullptr)
 {
 }
@@ -38,32 +39,27 @@ const D3D12_DEPTH_STENCIL_DESC DepthTarget::DepthDesc =
 void DepthTarget::Init
 (
     ID3D12Device*   pDevice,
+    GpuAllocator*   pAllocator,
     DescriptorPool* pPoolRTV,
     uint32_t        width,
     uint32_t        height,
     DXGI_FORMAT     format
 )
 {
-    if (pDevice == nullptr || pPoolRTV == nullptr || width == 0 || height == 0)
+    if (pDevice == nullptr || pAllocator == nullptr || pPoolRTV == nullptr || width == 0 || height == 0)
         __debugbreak();
 
-    assert(m_pHandleDSV == nullptr);
+    assert(!m_HandleDSVId.IsValid());
     assert(m_pPoolDSV == nullptr);
 
     m_pPoolDSV = pPoolRTV;
     m_pPoolDSV->AddRef();
 
-    m_pHandleDSV = m_pPoolDSV->AllocHandle();
-    if (m_pHandleDSV == nullptr)
+    m_HandleDSVId = m_pPoolDSV->AllocId();
+    auto pHandle = m_pPoolDSV->GetHandle(m_HandleDSVId);
+    if (pHandle == nullptr)
         __debugbreak();
 
-    D3D12_HEAP_PROPERTIES prop = {};
-    prop.Type                 = D3D12_HEAP_TYPE_DEFAULT;
-    prop.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    prop.CreationNodeMask     = 1;
-    prop.VisibleNodeMask      = 1;
-
     D3D12_RESOURCE_DESC desc = {};
     desc.Dimension          = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
     desc.Alignment          = 0;
@@ -82,16 +78,18 @@ void DepthTarget::Init
     clearValue.DepthStencil.Depth   = 1.0f;
     clearValue.DepthStencil.Stencil = 0;
 
-    auto hr = pDevice->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
+    auto hr = pAllocator->CreateResource(
+        D3D12_HEAP_TYPE_DEFAULT,
         &desc,
         D3D12_RESOURCE_STATE_DEPTH_WRITE,
         &clearValue,
+        m_Allocation,
         IID_PPV_ARGS(m_pTarget.GetAddressOf()));
     if (FAILED(hr))
         __debugbreak();
 
+    m_pAllocator = pAllocator;
+
     m_ViewDesc.ViewDimension      = D3D12_DSV_DIMENSION_TEXTURE2D;
     m_ViewDesc.Format             = format;
     m_ViewDesc.Texture2D.MipSlice = 0;
@@ -100,17 +98,22 @@ void DepthTarget::Init
     pDevice->CreateDepthStencilView(
         m_pTarget.Get(),
         &m_ViewDesc,
-        m_pHandleDSV->HandleCPU);
+        pHandle->HandleCPU);
 }
 
 void DepthTarget::Term()
 {
     m_pTarget.Reset();
 
-    if (m_pPoolDSV != nullptr && m_pHandleDSV != nullptr)
+    if (m_pAllocator != nullptr)
     {
-        m_pPoolDSV->FreeHandle(m_pHandleDSV);
-        m_pHandleDSV = nullptr;
+        m_pAllocator->Free(m_Allocation);
+        m_pAllocator = nullptr;
+    }
+
+    if (m_pPoolDSV != nullptr && m_HandleDSVId.IsValid())
+    {
+        m_pPoolDSV->FreeId(m_HandleDSVId);
     }
 
     if (m_pPoolDSV != nullptr)
@@ -120,9 +123,34 @@ void DepthTarget::Term()
     }
 }
 
+void DepthTarget::Retire(RetireQueue& queue, uint64_t retireValue)
+{
+    auto pTarget    = m_pTarget;
+    auto pAllocator = m_pAllocator;
+    auto allocation = m_Allocation;
+
+    queue.Enqueue(retireValue, [pTarget, pAllocator, allocation]() mutable
+    {
+        pTarget.Reset();
+        if (pAllocator != nullptr)
+        {
+            pAllocator->Free(allocation);
+        }
+    });
+
+    // The queued release owns the memory now.
+    m_pAllocator = nullptr;
+    m_Allocation = GpuAllocation();
+
+    Term();
+}
+
 DescriptorHandle* DepthTarget::GetHandleDSV() const
 {
-    return m_pHandleDSV;
+    if (m_pPoolDSV == nullptr)
+        return nullptr;
+
+    return m_pPoolDSV->GetHandle(m_HandleDSVId);
 }
 
 ID3D12Resource* DepthTarget::GetResource() const
@@ -1,17 +1,68 @@
 #include <DescriptorPool.h>
+#include <Logger.h>
+#include <chrono>
+
+namespace {
+    uint64_t GetElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+
+    uint32_t NextPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+}
 
 DescriptorPool::DescriptorPool()
     : m_RefCount(1)
-    , m_Pool()
+    , m_Mode(ALLOC_MODE_LOCK)
+    , m_pDevice()
+    , m_PageDesc()
+    , m_pPages()
+    , m_pIdSlots()
+    , m_PageCount(0)
+    , m_AllocPage(0)
+    , m_PageSize(0)
+    , m_MaxPageCount(0)
+    , m_ShaderVisible(false)
     , m_pHeap()
+    , m_HeapCPU()
+    , m_HeapGPU()
+    , m_HeapCount(0)
+    , m_HeapLimit(0)
     , m_DescriptorSize(0)
+    , m_Stats()
+    , m_Ranges()
+    , m_pRangeHeap()
+    , m_RangeCPU()
+    , m_RangeHeapCount(0)
 {
 }
 
 DescriptorPool::~DescriptorPool()
 {
-    m_Pool.Term();
+    for (auto i = 0u; i < MaxPageCount; ++i)
+    {
+        delete m_pPages[i];
+        m_pPages[i] = nullptr;
+
+        delete[] m_pIdSlots[i];
+        m_pIdSlots[i] = nullptr;
+    }
+
+    m_PageCount = 0;
+    m_Ranges.Term();
+    m_pRangeHeap.Reset();
     m_pHeap.Reset();
+    m_pDevice.Reset();
     m_DescriptorSize = 0;
 }
 
@@ -34,84 +85,988 @@ uint32_t DescriptorPool::GetCount() const
     return m_RefCount;
 }
 
-DescriptorHandle* DescriptorPool::AllocHandle()
+DescriptorPool::Page* DescriptorPool::CreatePage(uint32_t pageIndex)
+{
+    auto pPage = new (std::nothrow) Page();
+    if (pPage == nullptr)
+        return nullptr;
+
+    auto hr = m_pDevice->CreateDescriptorHeap(
+        &m_PageDesc,
+        IID_PPV_ARGS(pPage->pHeap.GetAddressOf()));
+    if (FAILED(hr))
+    {
+        delete pPage;
+        return nullptr;
+    }
+
+    pPage->HandleCPU = pPage->pHeap->GetCPUDescriptorHandleForHeapStart();
+    pPage->BaseIndex = pageIndex * m_PageSize;
+
+    // Id slots outlive their page. A page created again at the same index
+    // continues the generations, so ids issued for the old one never match.
+    if (m_pIdSlots[pageIndex] == nullptr)
+    {
+        m_pIdSlots[pageIndex] = new (std::nothrow) IdSlot[m_PageSize];
+        if (m_pIdSlots[pageIndex] == nullptr)
+        {
+            delete pPage;
+            return nullptr;
+        }
+    }
+
+    pPage->pIdSlots = m_pIdSlots[pageIndex];
+
+    if (m_ShaderVisible)
+    {
+        pPage->pDirty = new (std::nothrow) std::atomic<uint64_t>[GetDirtyWordCount()];
+        if (pPage->pDirty == nullptr)
+        {
+            delete pPage;
+            return nullptr;
+        }
+
+        for (auto i = 0u; i < GetDirtyWordCount(); ++i)
+        {
+            pPage->pDirty[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Only the pool of the chosen mode is created; the handle arrays are
+    // the bulk of a page.
+    bool initialized = false;
+    switch (m_Mode)
+    {
+    case ALLOC_MODE_LOCK_FREE:
+        pPage->pLockFreePool = new (std::nothrow) LockFreeHandlePool();
+        initialized = (pPage->pLockFreePool != nullptr) && pPage->pLockFreePool->Init(m_PageSize);
+        break;
+
+    case ALLOC_MODE_MAGAZINE:
+        pPage->pMagazinePool = new (std::nothrow) MagazineHandlePool();
+        initialized = (pPage->pMagazinePool != nullptr) && pPage->pMagazinePool->Init(m_PageSize);
+        break;
+
+    default:
+        pPage->pPool = new (std::nothrow) HandlePool();
+        initialized = (pPage->pPool != nullptr) && pPage->pPool->Init(m_PageSize);
+        break;
+    }
+
+    if (!initialized)
+    {
+        delete pPage;
+        return nullptr;
+    }
+
+    return pPage;
+}
+
+bool DescriptorPool::AddPage(uint32_t pageCount)
+{
+    std::lock_guard<std::mutex> guard(m_GrowMutex);
+
+    // Another thread added a page in the meantime; the caller retries on it.
+    if (m_PageCount.load(std::memory_order_relaxed) != pageCount)
+        return true;
+
+    if (pageCount >= m_MaxPageCount)
+    {
+        ELOG("Error : DescriptorPool page limit reached. pages = %u", pageCount);
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto pPage = CreatePage(pageCount);
+    if (pPage == nullptr)
+    {
+        ELOG("Error : DescriptorPool::CreatePage() Failed.");
+        return false;
+    }
+
+    m_pPages[pageCount] = pPage;
+    m_AllocPage.store(pageCount, std::memory_order_relaxed);
+    m_PageCount.store(pageCount + 1, std::memory_order_release);
+
+    auto elapsed = GetElapsedMicroseconds(start);
+
+    m_Stats.PageCount = pageCount + 1;
+    m_Stats.PageAllocCount++;
+    m_Stats.GrowMicroseconds += elapsed;
+
+    DLOG("DescriptorPool : page %u added (%u descriptors, %llu us)",
+        pageCount, m_PageSize, (unsigned long long)elapsed);
+
+    return true;
+}
+
+uint32_t DescriptorPool::GetUsedCount(const Page* pPage) const
+{
+    switch (m_Mode)
+    {
+    case ALLOC_MODE_LOCK_FREE:
+        return pPage->pLockFreePool->GetUsedCount();
+
+    case ALLOC_MODE_MAGAZINE:
+        return pPage->pMagazinePool->GetUsedCount();
+
+    default:
+        return pPage->pPool->GetUsedCount();
+    }
+}
+
+// Like GetUsedCount(), but handles cached in thread magazines count as used:
+// they still belong to the page.
+uint32_t DescriptorPool::GetReservedCount(const Page* pPage) const
+{
+    if (m_Mode == ALLOC_MODE_MAGAZINE)
+        return pPage->pMagazinePool->GetReservedCount();
+
+    return GetUsedCount(pPage);
+}
+
+uint32_t DescriptorPool::GetDirtyWordCount() const
+{
+    return (m_PageSize + 63) / 64;
+}
+
+void DescriptorPool::InitHandle(Page* pPage, uint32_t index, DescriptorHandle* pHandle)
+{
+    auto handleCPU = pPage->HandleCPU;
+    handleCPU.ptr += SIZE_T(m_DescriptorSize) * index;
+
+    pHandle->HandleCPU = handleCPU;
+    pHandle->HandleGPU = GetHeapHandleGPU(pPage->BaseIndex + index);
+
+    pPage->pIdSlots[index].pHandle = pHandle;
+
+    SetDirty(pPage, index);
+}
+
+void DescriptorPool::SetDirty(Page* pPage, uint32_t index)
+{
+    if (pPage->pDirty != nullptr)
+    {
+        pPage->pDirty[index / 64].fetch_or(uint64_t(1) << (index % 64), std::memory_order_release);
+    }
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorPool::GetHeapHandleGPU(uint32_t index) const
 {
-    auto func = [&](uint32_t index, DescriptorHandle* pHandle)
+    auto handleGPU = D3D12_GPU_DESCRIPTOR_HANDLE();
+    if (m_ShaderVisible && index < m_HeapCount)
     {
-        auto handleCPU = m_pHeap->GetCPUDescriptorHandleForHeapStart();
-        handleCPU.ptr += m_DescriptorSize * index;
+        handleGPU.ptr = m_HeapGPU.ptr + UINT64(m_DescriptorSize) * index;
+    }
 
-        auto handleGPU = m_pHeap->GetGPUDescriptorHandleForHeapStart();
-        handleGPU.ptr += m_DescriptorSize * index;
+    return handleGPU;
+}
 
-        pHandle->HandleCPU = handleCPU;
-        pHandle->HandleGPU = handleGPU;
+DescriptorHandle* DescriptorPool::AllocFromPage(Page* pPage, uint32_t& index)
+{
+    auto func = [this, pPage, &index](uint32_t i, DescriptorHandle* pHandle)
+    {
+        InitHandle(pPage, i, pHandle);
+        index = pPage->BaseIndex + i;
     };
 
-    return m_Pool.Alloc(func);
+    switch (m_Mode)
+    {
+    case ALLOC_MODE_LOCK_FREE:
+        return pPage->pLockFreePool->Alloc(func);
+
+    case ALLOC_MODE_MAGAZINE:
+        return pPage->pMagazinePool->Alloc(func);
+
+    default:
+        return pPage->pPool->Alloc(func);
+    }
+}
+
+uint32_t DescriptorPool::AllocFromPage(Page* pPage, uint32_t count, DescriptorHandle** ppHandles)
+{
+    auto func = [this, pPage](uint32_t i, DescriptorHandle* pHandle)
+    {
+        InitHandle(pPage, i, pHandle);
+    };
+
+    switch (m_Mode)
+    {
+    case ALLOC_MODE_LOCK_FREE:
+        return pPage->pLockFreePool->AllocN(count, ppHandles, func);
+
+    case ALLOC_MODE_MAGAZINE:
+        return pPage->pMagazinePool->AllocN(count, ppHandles, func);
+
+    default:
+        return pPage->pPool->AllocN(count, ppHandles, func);
+    }
+}
+
+DescriptorHandle* DescriptorPool::AllocSlot(uint32_t& index)
+{
+    for (;;)
+    {
+        const auto pageCount = m_PageCount.load(std::memory_order_acquire);
+        const auto hint      = m_AllocPage.load(std::memory_order_relaxed) % pageCount;
+
+        // Start from the page that served the last allocation so full pages
+        // are not scanned on every call.
+        for (auto i = 0u; i < pageCount; ++i)
+        {
+            auto page = (hint + i) % pageCount;
+            auto pHandle = AllocFromPage(m_pPages[page], index);
+            if (pHandle != nullptr)
+            {
+                if (page != hint)
+                    m_AllocPage.store(page, std::memory_order_relaxed);
+
+                return pHandle;
+            }
+        }
+
+        if (!AddPage(pageCount))
+            return nullptr;
+    }
+}
+
+DescriptorPool::IdSlot* DescriptorPool::GetIdSlot(uint32_t index) const
+{
+    const auto page = index / m_PageSize;
+    if (page >= m_PageCount.load(std::memory_order_acquire))
+        return nullptr;
+
+    return &m_pPages[page]->pIdSlots[index % m_PageSize];
+}
+
+DescriptorPool::Page* DescriptorPool::FindPage(const DescriptorHandle* pHandle, uint32_t& index) const
+{
+    const auto pageCount = m_PageCount.load(std::memory_order_acquire);
+    const auto pageBytes = SIZE_T(m_DescriptorSize) * m_PageSize;
+    const auto ptr       = pHandle->HandleCPU.ptr;
+
+    for (auto i = 0u; i < pageCount; ++i)
+    {
+        auto start = m_pPages[i]->HandleCPU.ptr;
+        if (start <= ptr && ptr < start + pageBytes)
+        {
+            index = uint32_t((ptr - start) / m_DescriptorSize);
+            return m_pPages[i];
+        }
+    }
+
+    assert(false && "Handle does not belong to this pool.");
+    return nullptr;
+}
+
+void DescriptorPool::RetireHandle(Page* pPage, uint32_t index)
+{
+    // Invalidates every id issued for this slot.
+    auto& slot = pPage->pIdSlots[index];
+    slot.Generation.store(
+        SlotHandle::NextGeneration(slot.Generation.load(std::memory_order_relaxed)),
+        std::memory_order_release);
+}
+
+DescriptorId DescriptorPool::AllocId()
+{
+    uint32_t index = 0;
+    auto pHandle = AllocSlot(index);
+    if (pHandle == nullptr)
+        return DescriptorId();
+
+    auto pSlot = GetIdSlot(index);
+    return DescriptorId(index, pSlot->Generation.load(std::memory_order_acquire));
+}
+
+void DescriptorPool::FreeId(DescriptorId& id)
+{
+    auto pSlot = id.IsValid() ? GetIdSlot(id.GetIndex()) : nullptr;
+    if (pSlot == nullptr)
+    {
+        id = DescriptorId();
+        return;
+    }
+
+    // Only the caller whose id still matches retires the slot, so freeing a
+    // stale id (double free) is a no-op.
+    auto generation = id.GetGeneration();
+    if (pSlot->Generation.compare_exchange_strong(
+        generation,
+        SlotHandle::NextGeneration(generation),
+        std::memory_order_acq_rel))
+    {
+        FreeToPage(m_pPages[id.GetIndex() / m_PageSize], pSlot->pHandle);
+    }
+
+    id = DescriptorId();
+}
+
+DescriptorHandle* DescriptorPool::GetHandle(DescriptorId id) const
+{
+    auto pSlot = id.IsValid() ? GetIdSlot(id.GetIndex()) : nullptr;
+    if (pSlot == nullptr)
+        return nullptr;
+
+    if (pSlot->Generation.load(std::memory_order_acquire) != id.GetGeneration())
+        return nullptr;
+
+    return pSlot->pHandle;
+}
+
+void DescriptorPool::MarkDirty(DescriptorId id)
+{
+    if (!m_ShaderVisible)
+        return;
+
+    if (GetHandle(id) == nullptr)
+        return;
+
+    const auto index = id.GetIndex();
+    auto pPage = m_pPages[index / m_PageSize];
+    SetDirty(pPage, index % m_PageSize);
+}
+
+void DescriptorPool::MarkDirty(const DescriptorHandle* pHandle)
+{
+    if (!m_ShaderVisible || pHandle == nullptr)
+        return;
+
+    uint32_t index = 0;
+    auto pPage = FindPage(pHandle, index);
+    if (pPage != nullptr)
+    {
+        SetDirty(pPage, index);
+    }
+}
+
+DescriptorHandle* DescriptorPool::AllocHandle()
+{
+    uint32_t index = 0;
+    return AllocSlot(index);
+}
+
+bool DescriptorPool::AllocHandles(uint32_t count, DescriptorHandle** ppHandles)
+{
+    if (count == 0 || ppHandles == nullptr)
+        return false;
+
+    uint32_t allocated = 0;
+    for (;;)
+    {
+        const auto pageCount = m_PageCount.load(std::memory_order_acquire);
+        for (auto i = 0u; i < pageCount && allocated < count; ++i)
+        {
+            allocated += AllocFromPage(m_pPages[i], count - allocated, ppHandles + allocated);
+        }
+
+        if (allocated == count)
+            return true;
+
+        if (!AddPage(pageCount))
+            break;
+    }
+
+    FreeHandles(ppHandles, allocated);
+    return false;
 }
 
 void DescriptorPool::FreeHandle(DescriptorHandle*& pHandle)
 {
     if (pHandle != nullptr)
     {
-        m_Pool.Free(pHandle);
+        uint32_t index = 0;
+        auto pPage = FindPage(pHandle, index);
+        if (pPage != nullptr)
+        {
+            RetireHandle(pPage, index);
+            FreeToPage(pPage, pHandle);
+        }
+
         pHandle = nullptr;
     }
 }
 
+void DescriptorPool::FreeToPage(Page* pPage, DescriptorHandle* pHandle)
+{
+    switch (m_Mode)
+    {
+    case ALLOC_MODE_LOCK_FREE:
+        pPage->pLockFreePool->Free(pHandle);
+        break;
+
+    case ALLOC_MODE_MAGAZINE:
+        pPage->pMagazinePool->Free(pHandle);
+        break;
+
+    default:
+        pPage->pPool->Free(pHandle);
+        break;
+    }
+}
+
+void DescriptorPool::FreeToPage(Page* pPage, DescriptorHandle** ppHandles, uint32_t count)
+{
+    switch (m_Mode)
+    {
+    case ALLOC_MODE_LOCK_FREE:
+        pPage->pLockFreePool->FreeN(ppHandles, count);
+        break;
+
+    case ALLOC_MODE_MAGAZINE:
+        pPage->pMagazinePool->FreeN(ppHandles, count);
+        break;
+
+    default:
+        pPage->pPool->FreeN(ppHandles, count);
+        break;
+    }
+}
+
+void DescriptorPool::FreeHandles(DescriptorHandle** ppHandles, uint32_t count)
+{
+    if (count == 0 || ppHandles == nullptr)
+        return;
+
+    // Consecutive handles from the same page are returned in one FreeN.
+    auto i = 0u;
+    while (i < count)
+    {
+        uint32_t index = 0;
+        auto pPage = (ppHandles[i] != nullptr) ? FindPage(ppHandles[i], index) : nullptr;
+        if (pPage == nullptr)
+        {
+            ++i;
+            continue;
+        }
+
+        RetireHandle(pPage, index);
+
+        auto first = i++;
+        while (i < count && ppHandles[i] != nullptr && FindPage(ppHandles[i], index) == pPage)
+        {
+            RetireHandle(pPage, index);
+            ++i;
+        }
+
+        FreeToPage(pPage, ppHandles + first, i - first);
+    }
+
+    for (auto j = 0u; j < count; ++j)
+    {
+        ppHandles[j] = nullptr;
+    }
+}
+
+void DescriptorPool::FlushThreadCache()
+{
+    if (m_Mode != ALLOC_MODE_MAGAZINE)
+        return;
+
+    const auto pageCount = m_PageCount.load(std::memory_order_acquire);
+    for (auto i = 0u; i < pageCount; ++i)
+    {
+        m_pPages[i]->pMagazinePool->Flush();
+    }
+}
+
+void DescriptorPool::CopyToHeap(const Page* pPage, uint32_t index, uint32_t count)
+{
+    auto dst = m_HeapCPU;
+    dst.ptr += SIZE_T(m_DescriptorSize) * (pPage->BaseIndex + index);
+
+    auto src = pPage->HandleCPU;
+    src.ptr += SIZE_T(m_DescriptorSize) * index;
+
+    m_pDevice->CopyDescriptorsSimple(count, dst, src, m_PageDesc.Type);
+}
+
+void DescriptorPool::Commit()
+{
+    if (!m_ShaderVisible)
+        return;
+
+    CommitRanges();
+
+    const auto pageCount = m_PageCount.load(std::memory_order_acquire);
+    for (auto i = 0u; i < pageCount; ++i)
+    {
+        auto pPage = m_pPages[i];
+
+        // Pages past the shader-visible heap are copied by Rehome().
+        if (pPage->BaseIndex >= m_HeapCount)
+            break;
+
+        for (auto w = 0u; w < GetDirtyWordCount(); ++w)
+        {
+            auto bits = pPage->pDirty[w].exchange(0, std::memory_order_acquire);
+            auto bit  = 0u;
+
+            // One copy per run of consecutive dirty descriptors.
+            while (bits != 0)
+            {
+                if ((bits & 1) == 0)
+                {
+                    bits >>= 1;
+                    ++bit;
+                    continue;
+                }
+
+                auto run = 0u;
+                while ((bits & 1) != 0)
+                {
+                    bits >>= 1;
+                    ++run;
+                }
+
+                CopyToHeap(pPage, w * 64 + bit, run);
+                bit += run;
+            }
+        }
+    }
+}
+
+bool DescriptorPool::GrowRanges(uint32_t count)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    const auto oldSize = m_Ranges.GetSize();
+
+    auto newSize = (oldSize > 0) ? oldSize * 2 : MinRangeCount;
+    while (newSize < oldSize + count)
+    {
+        newSize *= 2;
+    }
+
+    if (m_HeapCount + newSize > m_HeapLimit)
+    {
+        ELOG("Error : DescriptorPool range limit reached. ranges = %u", oldSize);
+        return false;
+    }
+
+    auto desc = m_PageDesc;
+    desc.NumDescriptors = newSize;
+
+    ComPtr<ID3D12DescriptorHeap> pHeap;
+    auto hr = m_pDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(pHeap.GetAddressOf()));
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Device::CreateDescriptorHeap() Failed. retcode = 0x%x", hr);
+        return false;
+    }
+
+    auto handleCPU = pHeap->GetCPUDescriptorHandleForHeapStart();
+    if (oldSize > 0)
+    {
+        m_pDevice->CopyDescriptorsSimple(oldSize, handleCPU, m_RangeCPU, m_PageDesc.Type);
+    }
+
+    m_pRangeHeap = pHeap;
+    m_RangeCPU   = handleCPU;
+    m_Ranges.Grow(newSize);
+
+    auto elapsed = GetElapsedMicroseconds(start);
+
+    DLOG("DescriptorPool : range region grown to %u descriptors (%llu us)",
+        newSize, (unsigned long long)elapsed);
+
+    return true;
+}
+
+bool DescriptorPool::AllocRange(uint32_t count, DescriptorRange& range)
+{
+    if (!m_ShaderVisible || count == 0)
+        return false;
+
+    std::lock_guard<std::mutex> guard(m_RangeMutex);
+
+    while (!m_Ranges.Alloc(count, range))
+    {
+        if (!GrowRanges(count))
+            return false;
+    }
+
+    return true;
+}
+
+void DescriptorPool::FreeRange(DescriptorRange& range)
+{
+    std::lock_guard<std::mutex> guard(m_RangeMutex);
+    m_Ranges.Free(range);
+}
+
+void DescriptorPool::CopyToRange
+(
+    const DescriptorRange&              range,
+    uint32_t                            index,
+    uint32_t                            count,
+    const D3D12_CPU_DESCRIPTOR_HANDLE*  pSrcHandles
+)
+{
+    if (!range.IsValid() || pSrcHandles == nullptr || count == 0 || index + count > range.Count)
+        return;
+
+    std::lock_guard<std::mutex> guard(m_RangeMutex);
+
+    auto dst = m_RangeCPU;
+    dst.ptr += SIZE_T(m_DescriptorSize) * (range.Offset + index);
+
+    // Null source range sizes: every source handle is a range of one descriptor.
+    m_pDevice->CopyDescriptors(1, &dst, &count, count, pSrcHandles, nullptr, m_PageDesc.Type);
+
+    DescriptorRange dirty;
+    dirty.Offset = range.Offset + index;
+    dirty.Count  = count;
+    dirty.Node   = range.Node;
+    m_DirtyRanges.push_back(dirty);
+}
+
+void DescriptorPool::CopyToRanges
+(
+    const DescriptorRange*              pRanges,
+    uint32_t                            rangeCount,
+    const D3D12_CPU_DESCRIPTOR_HANDLE*  pSrcHandles
+)
+{
+    if (pRanges == nullptr || pSrcHandles == nullptr || rangeCount == 0)
+        return;
+
+    for (auto i = 0u; i < rangeCount; ++i)
+    {
+        if (!pRanges[i].IsValid())
+            return;
+    }
+
+    std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> dstHandles;
+    std::vector<UINT>                        dstSizes;
+    dstHandles.reserve(rangeCount);
+    dstSizes  .reserve(rangeCount);
+
+    std::lock_guard<std::mutex> guard(m_RangeMutex);
+
+    UINT srcCount = 0;
+    for (auto i = 0u; i < rangeCount; ++i)
+    {
+        const auto& range = pRanges[i];
+
+        auto dst = m_RangeCPU;
+        dst.ptr += SIZE_T(m_DescriptorSize) * range.Offset;
+
+        dstHandles.push_back(dst);
+        dstSizes  .push_back(range.Count);
+        srcCount += range.Count;
+
+        m_DirtyRanges.push_back(range);
+    }
+
+    m_pDevice->CopyDescriptors(
+        rangeCount, dstHandles.data(), dstSizes.data(),
+        srcCount, pSrcHandles, nullptr,
+        m_PageDesc.Type);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE DescriptorPool::GetRangeHandleGPU(const DescriptorRange& range) const
+{
+    auto handleGPU = D3D12_GPU_DESCRIPTOR_HANDLE();
+    if (m_ShaderVisible && range.IsValid() && range.Offset + range.Count <= m_RangeHeapCount)
+    {
+        handleGPU.ptr = m_HeapGPU.ptr + UINT64(m_DescriptorSize) * (m_HeapCount + range.Offset);
+    }
+
+    return handleGPU;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE DescriptorPool::GetRangeHandleCPU(const DescriptorRange& range) const
+{
+    auto handleCPU = D3D12_CPU_DESCRIPTOR_HANDLE();
+    if (m_ShaderVisible && range.IsValid() && range.Offset + range.Count <= m_RangeHeapCount)
+    {
+        handleCPU.ptr = m_HeapCPU.ptr + SIZE_T(m_DescriptorSize) * (m_HeapCount + range.Offset);
+    }
+
+    return handleCPU;
+}
+
+void DescriptorPool::CommitRanges()
+{
+    std::lock_guard<std::mutex> guard(m_RangeMutex);
+
+    for (const auto& range : m_DirtyRanges)
+    {
+        // Ranges past the shader-visible heap are copied by Rehome().
+        if (range.Offset + range.Count > m_RangeHeapCount)
+            continue;
+
+        auto dst = m_HeapCPU;
+        dst.ptr += SIZE_T(m_DescriptorSize) * (m_HeapCount + range.Offset);
+
+        auto src = m_RangeCPU;
+        src.ptr += SIZE_T(m_DescriptorSize) * range.Offset;
+
+        m_pDevice->CopyDescriptorsSimple(range.Count, dst, src, m_PageDesc.Type);
+    }
+
+    m_DirtyRanges.clear();
+}
+
+bool DescriptorPool::NeedsRehome() const
+{
+    if (!m_ShaderVisible)
+        return false;
+
+    if (m_PageCount.load(std::memory_order_acquire) * m_PageSize > m_HeapCount)
+        return true;
+
+    std::lock_guard<std::mutex> guard(m_RangeMutex);
+    return m_Ranges.GetSize() > m_RangeHeapCount;
+}
+
+bool DescriptorPool::Rehome(uint32_t minCount, RetireQueue* pRetire, uint64_t retireValue)
+{
+    std::lock_guard<std::mutex> guard(m_GrowMutex);
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Compaction: trailing pages without live or cached handles are
+    // released. Their id slots stay, without handles.
+    auto pageCount = m_PageCount.load(std::memory_order_relaxed);
+    while (pageCount > 1 && GetReservedCount(m_pPages[pageCount - 1]) == 0)
+    {
+        --pageCount;
+        m_PageCount.store(pageCount, std::memory_order_release);
+
+        delete m_pPages[pageCount];
+        m_pPages[pageCount] = nullptr;
+
+        for (auto j = 0u; j < m_PageSize; ++j)
+        {
+            m_pIdSlots[pageCount][j].pHandle = nullptr;
+        }
+    }
+
+    if (m_AllocPage.load(std::memory_order_relaxed) >= pageCount)
+        m_AllocPage.store(0, std::memory_order_relaxed);
+
+    m_Stats.PageCount = pageCount;
+
+    if (!m_ShaderVisible)
+        return true;
+
+    auto heapPages = (pageCount > minCount / m_PageSize) ? pageCount : (minCount + m_PageSize - 1) / m_PageSize;
+    heapPages = NextPowerOfTwo(heapPages);
+    if (heapPages > m_MaxPageCount)
+        heapPages = m_MaxPageCount;
+
+    std::lock_guard<std::mutex> rangeGuard(m_RangeMutex);
+
+    const auto heapCount  = heapPages * m_PageSize;
+    const auto rangeCount = m_Ranges.GetSize();
+    if (heapCount == m_HeapCount && rangeCount == m_RangeHeapCount)
+        return true;
+
+    auto desc = m_PageDesc;
+    desc.NumDescriptors = heapCount + rangeCount;
+    desc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+    ComPtr<ID3D12DescriptorHeap> pHeap;
+    auto hr = m_pDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(pHeap.GetAddressOf()));
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Device::CreateDescriptorHeap() Failed. retcode = 0x%x", hr);
+        return false;
+    }
+
+    // Frames in flight still reference the old heap; nothing writes to it
+    // from here on, so keeping it alive is enough.
+    if (pRetire != nullptr && m_pHeap != nullptr)
+    {
+        auto pOldHeap = m_pHeap;
+        pRetire->Enqueue(retireValue, [pOldHeap]() mutable { pOldHeap.Reset(); });
+    }
+
+    m_pHeap          = pHeap;
+    m_HeapCPU        = m_pHeap->GetCPUDescriptorHandleForHeapStart();
+    m_HeapGPU        = m_pHeap->GetGPUDescriptorHandleForHeapStart();
+    m_HeapCount      = heapCount;
+    m_RangeHeapCount = rangeCount;
+
+    for (auto i = 0u; i < pageCount; ++i)
+    {
+        auto pPage = m_pPages[i];
+
+        for (auto w = 0u; w < GetDirtyWordCount(); ++w)
+        {
+            pPage->pDirty[w].store(0, std::memory_order_relaxed);
+        }
+
+        CopyToHeap(pPage, 0, m_PageSize);
+
+        // Slots that were never allocated have no handle yet; freed slots
+        // are rewritten on their next allocation anyway.
+        for (auto j = 0u; j < m_PageSize; ++j)
+        {
+            auto pHandle = pPage->pIdSlots[j].pHandle;
+            if (pHandle != nullptr)
+                pHandle->HandleGPU = GetHeapHandleGPU(pPage->BaseIndex + j);
+        }
+    }
+
+    if (rangeCount > 0)
+    {
+        auto dst = m_HeapCPU;
+        dst.ptr += SIZE_T(m_DescriptorSize) * m_HeapCount;
+        m_pDevice->CopyDescriptorsSimple(rangeCount, dst, m_RangeCPU, m_PageDesc.Type);
+    }
+
+    m_DirtyRanges.clear();
+
+    auto elapsed = GetElapsedMicroseconds(start);
+
+    m_Stats.RehomeCount++;
+    m_Stats.HeapCount = m_HeapCount;
+    m_Stats.GrowMicroseconds += elapsed;
+
+    DLOG("DescriptorPool : shader-visible heap rehomed (%u + %u descriptors, %llu us)",
+        m_HeapCount, m_RangeHeapCount, (unsigned long long)elapsed);
+
+    return true;
+}
+
 uint32_t DescriptorPool::GetAvailableHandleCount() const
 {
-    return m_Pool.GetAvailableCount();
+    return GetHandleCount() - GetAllocatedHandleCount();
 }
 
 uint32_t DescriptorPool::GetAllocatedHandleCount() const
 {
-    return m_Pool.GetUsedCount();
+    uint32_t count = 0;
+
+    const auto pageCount = m_PageCount.load(std::memory_order_acquire);
+    for (auto i = 0u; i < pageCount; ++i)
+    {
+        count += GetUsedCount(m_pPages[i]);
+    }
+
+    return count;
 }
 
 uint32_t DescriptorPool::GetHandleCount() const
 {
-    return m_Pool.GetSize();
+    return m_PageCount.load(std::memory_order_acquire) * m_PageSize;
 }
 
 ID3D12DescriptorHeap* const DescriptorPool::GetHeap() const
 {
-    return m_pHeap.Get();
+    if (m_ShaderVisible)
+        return m_pHeap.Get();
+
+    return m_pPages[0]->pHeap.Get();
+}
+
+DescriptorPool::ALLOC_MODE DescriptorPool::GetAllocMode() const
+{
+    return m_Mode;
+}
+
+bool DescriptorPool::IsShaderVisible() const
+{
+    return m_ShaderVisible;
+}
+
+uint32_t DescriptorPool::GetDescriptorSize() const
+{
+    return m_DescriptorSize;
+}
+
+DescriptorPool::Stats DescriptorPool::GetStats() const
+{
+    std::lock_guard<std::mutex> guard(m_GrowMutex);
+    std::lock_guard<std::mutex> rangeGuard(m_RangeMutex);
+
+    auto stats = m_Stats;
+    stats.RangeCount      = m_Ranges.GetSize();
+    stats.RangeUsedCount  = m_Ranges.GetUsedCount();
+    stats.RangeFreeBlocks = m_Ranges.GetFreeRangeCount();
+
+    return stats;
 }
 
 void DescriptorPool::Create
 (
     ID3D12Device*                       pDevice,
     const D3D12_DESCRIPTOR_HEAP_DESC*   pDesc,
-    DescriptorPool**                    ppPool
+    DescriptorPool**                    ppPool,
+    ALLOC_MODE                          mode
 )
 {
-    if (pDevice == nullptr || pDesc == nullptr || ppPool == nullptr)
+    if (pDevice == nullptr || pDesc == nullptr || ppPool == nullptr || pDesc->NumDescriptors == 0)
         __debugbreak();
 
     auto instance = new (std::nothrow) DescriptorPool();
     if (instance == nullptr)
         __debugbreak();
 
-    auto hr = pDevice->CreateDescriptorHeap(
-        pDesc,
-        IID_PPV_ARGS(instance->m_pHeap.GetAddressOf()));
+    instance->m_pDevice        = pDevice;
+    instance->m_Mode           = mode;
+    instance->m_PageSize       = pDesc->NumDescriptors;
+    instance->m_ShaderVisible  = (pDesc->Flags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE) != 0;
+    instance->m_DescriptorSize = pDevice->GetDescriptorHandleIncrementSize(pDesc->Type);
 
-    if (FAILED(hr))
+    // Pages are always CPU-only heaps.
+    instance->m_PageDesc       = *pDesc;
+    instance->m_PageDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+    // Ids address every page, and a shader-visible heap has to cover all of them.
+    auto maxCount = SlotHandle::MaxIndexCount;
+    if (instance->m_ShaderVisible)
+    {
+        instance->m_HeapLimit = (pDesc->Type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
+            ? uint32_t(D3D12_MAX_SHADER_VISIBLE_SAMPLER_HEAP_SIZE)
+            : uint32_t(D3D12_MAX_SHADER_VISIBLE_DESCRIPTOR_HEAP_SIZE_TIER_1);
+        if (instance->m_HeapLimit < maxCount)
+            maxCount = instance->m_HeapLimit;
+    }
+
+    instance->m_MaxPageCount = maxCount / instance->m_PageSize;
+    if (instance->m_MaxPageCount > MaxPageCount)
+        instance->m_MaxPageCount = MaxPageCount;
+
+    if (instance->m_MaxPageCount == 0)
     {
         instance->Release();
         __debugbreak();
     }
 
-    if (!instance->m_Pool.Init(pDesc->NumDescriptors))
+    if (instance->m_ShaderVisible)
+    {
+        auto hr = pDevice->CreateDescriptorHeap(
+            pDesc,
+            IID_PPV_ARGS(instance->m_pHeap.GetAddressOf()));
+
+        if (FAILED(hr))
+        {
+            instance->Release();
+            __debugbreak();
+        }
+
+        instance->m_HeapCPU   = instance->m_pHeap->GetCPUDescriptorHandleForHeapStart();
+        instance->m_HeapGPU   = instance->m_pHeap->GetGPUDescriptorHandleForHeapStart();
+        instance->m_HeapCount = pDesc->NumDescriptors;
+    }
+
+    auto pPage = instance->CreatePage(0);
+    if (pPage == nullptr)
     {
         instance->Release();
         __debugbreak();
     }
 
-    instance->m_DescriptorSize =
-        pDevice->GetDescriptorHandleIncrementSize(pDesc->Type);
+    instance->m_pPages[0] = pPage;
+    instance->m_PageCount.store(1, std::memory_order_release);
+
+    instance->m_Stats.PageCount = 1;
+    instance->m_Stats.HeapCount = instance->m_HeapCount;
 
     *ppPool = instance;
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include <DescriptorRing.h>
+#include <Logger.h>
+
+DescriptorRing::DescriptorRing()
+    : m_pPool(nullptr)
+    , m_Range()
+    , m_Ring()
+    , m_BaseCPU()
+    , m_BaseGPU()
+    , m_DescriptorSize(0)
+{
+}
+
+DescriptorRing::~DescriptorRing()
+{
+    Term();
+}
+
+bool DescriptorRing::Init(DescriptorPool* pPool, uint32_t countPerFrame, uint32_t frameCount)
+{
+    if (pPool == nullptr || !pPool->IsShaderVisible() || countPerFrame == 0 || frameCount == 0)
+    {
+        ELOG("Error : Invalid Argument.");
+        return false;
+    }
+
+    Term();
+
+    if (!pPool->AllocRange(countPerFrame * frameCount, m_Range))
+    {
+        ELOG("Error : DescriptorPool::AllocRange() Failed.");
+        return false;
+    }
+
+    m_pPool = pPool;
+    m_pPool->AddRef();
+
+    m_DescriptorSize = m_pPool->GetDescriptorSize();
+
+    return m_Ring.Init(countPerFrame, frameCount);
+}
+
+void DescriptorRing::Term()
+{
+    m_Ring.Term();
+
+    if (m_pPool != nullptr)
+    {
+        m_pPool->FreeRange(m_Range);
+        m_pPool->Release();
+        m_pPool = nullptr;
+    }
+
+    m_BaseCPU        = D3D12_CPU_DESCRIPTOR_HANDLE();
+    m_BaseGPU        = D3D12_GPU_DESCRIPTOR_HANDLE();
+    m_DescriptorSize = 0;
+}
+
+bool DescriptorRing::BeginFrame(uint32_t frameIndex, uint64_t completedValue)
+{
+    if (m_pPool == nullptr)
+    {
+        return false;
+    }
+
+    m_BaseCPU = m_pPool->GetRangeHandleCPU(m_Range);
+    m_BaseGPU = m_pPool->GetRangeHandleGPU(m_Range);
+    if (m_BaseGPU.ptr == 0)
+    {
+        return false;
+    }
+
+    return m_Ring.BeginFrame(frameIndex, completedValue);
+}
+
+void DescriptorRing::EndFrame(uint64_t fenceValue)
+{
+    m_Ring.EndFrame(fenceValue);
+}
+
+bool DescriptorRing::Alloc
+(
+    uint32_t                        count,
+    D3D12_CPU_DESCRIPTOR_HANDLE&    handleCPU,
+    D3D12_GPU_DESCRIPTOR_HANDLE&    handleGPU
+)
+{
+    uint32_t offset = 0;
+    if (!m_Ring.Alloc(count, 1, offset))
+    {
+        return false;
+    }
+
+    handleCPU.ptr = m_BaseCPU.ptr + SIZE_T(m_DescriptorSize) * offset;
+    handleGPU.ptr = m_BaseGPU.ptr + UINT64(m_DescriptorSize) * offset;
+
+    return true;
+}
+
+uint64_t DescriptorRing::GetFenceValue(uint32_t frameIndex) const
+{
+    return m_Ring.GetFenceValue(frameIndex);
+}
+
+uint32_t DescriptorRing::GetUsedCount() const
+{
+    return m_Ring.GetUsedCount();
+}
+
+uint32_t DescriptorRing::GetPeakCount() const
+{
+    return m_Ring.GetPeakCount();
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Fence.h"
+#include <chrono>
 
 Fence::Fence()
     : m_pFence(nullptr)
@@ -87,20 +88,24 @@ void Fence::Sync(ID3D12CommandQueue* pQueue)
     m_Counter++;
 }
 
-void Fence::Wait(UINT64 fenceValue, UINT timeout)
+uint64_t Fence::Wait(UINT64 fenceValue, UINT timeout)
 {
     if (fenceValue == 0)
-        return;
+        return 0;
 
-    if (m_pFence->GetCompletedValue() < fenceValue)
-    {
-        auto hr = m_pFence->SetEventOnCompletion(fenceValue, m_Event);
-        if (FAILED(hr))
-            __debugbreak();
+    if (m_pFence->GetCompletedValue() >= fenceValue)
+        return 0;
 
-        if (WAIT_OBJECT_0 != WaitForSingleObjectEx(m_Event, timeout, FALSE))
-            return;
-    }
+    const auto start = std::chrono::steady_clock::now();
+
+    auto hr = m_pFence->SetEventOnCompletion(fenceValue, m_Event);
+    if (FAILED(hr))
+        __debugbreak();
+
+    WaitForSingleObjectEx(m_Event, timeout, FALSE);
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
 }
 
 UINT64 Fence::Signal(ID3D12CommandQueue* pQueue)
@@ -109,4 +114,19 @@ UINT64 Fence::Signal(ID3D12CommandQueue* pQueue)
     pQueue->Signal(m_pFence.Get(), fenceValue);
     ++m_Counter;
     return fenceValue;
+}
+
+UINT64 Fence::GetCompletedValue() const
+{
+    return m_pFence->GetCompletedValue();
+}
+
+UINT64 Fence::GetNextValue() const
+{
+    return m_Counter;
+}
+
+ID3D12Fence* Fence::GetFence() const
+{
+    return m_pFence.Get();
 }
\ No newline at end of file
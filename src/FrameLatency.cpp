@@ -0,0 +1,128 @@
+#include <FrameLatency.h>
+
+FrameLatency::FrameLatency()
+    : m_Mode(LATENCY_MODE_FIXED)
+    , m_MaxDepth(0)
+    , m_Depth(0)
+    , m_Waited(false)
+    , m_FrameCount(0)
+    , m_StarvedCount(0)
+    , m_Cooldown(0)
+{
+}
+
+FrameLatency::~FrameLatency()
+{
+    Term();
+}
+
+bool FrameLatency::Init(uint32_t maxDepth, LATENCY_MODE mode, uint32_t depth)
+{
+    if (maxDepth == 0)
+    {
+        return false;
+    }
+
+    m_MaxDepth = maxDepth;
+    SetMode(mode, depth);
+
+    return true;
+}
+
+void FrameLatency::Term()
+{
+    m_Mode     = LATENCY_MODE_FIXED;
+    m_MaxDepth = 0;
+    m_Depth    = 0;
+    m_Cooldown = 0;
+    ResetWindow();
+}
+
+void FrameLatency::SetMode(LATENCY_MODE mode, uint32_t depth)
+{
+    if (m_MaxDepth == 0)
+    {
+        return;
+    }
+
+    if (depth < 1)
+    {
+        depth = 1;
+    }
+    else if (depth > m_MaxDepth)
+    {
+        depth = m_MaxDepth;
+    }
+
+    m_Mode     = mode;
+    m_Depth    = depth;
+    m_Cooldown = 0;
+    ResetWindow();
+}
+
+void FrameLatency::OnWait(uint64_t waitMicroseconds)
+{
+    m_Waited = (waitMicroseconds >= WaitThresholdMicroseconds);
+}
+
+void FrameLatency::OnSubmit(uint32_t pendingFrames)
+{
+    if (m_Mode != LATENCY_MODE_ADAPTIVE)
+    {
+        return;
+    }
+
+    // An empty GPU queue after a CPU wait: the GPU idles while this frame is
+    // recorded. Without the wait the CPU is the bottleneck, and more frames
+    // in flight would not help.
+    if (m_Waited && pendingFrames == 0)
+    {
+        m_StarvedCount++;
+    }
+
+    if (++m_FrameCount < WindowFrames)
+    {
+        return;
+    }
+
+    if (m_StarvedCount >= StarveLimit)
+    {
+        if (m_Depth < m_MaxDepth)
+        {
+            m_Depth++;
+        }
+        m_Cooldown = CooldownWindows;
+    }
+    else if (m_Cooldown > 0)
+    {
+        m_Cooldown--;
+    }
+    else if (m_Depth > 1)
+    {
+        m_Depth--;
+    }
+
+    ResetWindow();
+}
+
+uint32_t FrameLatency::GetDepth() const
+{
+    return m_Depth;
+}
+
+uint32_t FrameLatency::GetMaxDepth() const
+{
+    return m_MaxDepth;
+}
+
+LATENCY_MODE FrameLatency::GetMode() const
+{
+    return m_Mode;
+}
+
+void FrameLatency::ResetWindow()
+{
+    m_Waited       = false;
+    m_FrameCount   = 0;
+    m_StarvedCount = 0;
+}
\ No newline at end of file
@@ -1,53 +1,31 @@
 #include <FrameResource.h>
-#include <DescriptorPool.h>
 
 FrameResource::FrameResource
 (
     ID3D12Device* pDevice,
-    DescriptorPool** pPool,
     D3D12_COMMAND_LIST_TYPE type,
-    int count
-) : Fence(0)
+    uint32_t recordCount
+) : ObjectVersion(0)
+  , MaterialVersion(0)
+  , Pass(0)
+  , pInstanceBuffer(nullptr)
+  , InstanceOffset(0)
+  , InstanceCount(0)
+  , BufferTable()
+  , Fence(0)
 {
     auto hr = pDevice->CreateCommandAllocator(
         type, IID_PPV_ARGS(Allocator.GetAddressOf()));
     if (FAILED(hr))
         __debugbreak();
 
-    if (!Transform.Init(
-        pDevice,
-        pPool[DescriptorPool::POOL_TYPE_RES],
-        sizeof(TransformBuffer),
-        count))
+    RecordAllocators.resize(recordCount);
+    for (auto& pAllocator : RecordAllocators)
     {
-        __debugbreak();
-    }
-
-    if (!Light.Init(
-        pDevice,
-        pPool[DescriptorPool::POOL_TYPE_RES],
-        sizeof(LightBuffer),
-        count))
-    {
-        __debugbreak();
-    }
-
-    if (!Material.Init(
-        pDevice,
-        pPool[DescriptorPool::POOL_TYPE_RES],
-        sizeof(MaterialBuffer),
-        count))
-    {
-        __debugbreak();
-    }
-
-    if (!Pass.Init(
-        pDevice,
-        pPool[DescriptorPool::POOL_TYPE_RES],
-        sizeof(PassConstant),
-        count))
-    {
-        __debugbreak();
+        hr = pDevice->CreateCommandAllocator(
+            type, IID_PPV_ARGS(pAllocator.GetAddressOf()));
+        if (FAILED(hr))
+            __debugbreak();
     }
 }
 
@@ -0,0 +1,122 @@
+#include <FrameRing.h>
+
+FrameRing::FrameRing()
+    : m_PartitionSize(0)
+    , m_Partition(0)
+    , m_Head(0)
+    , m_Peak(0)
+    , m_Recording(false)
+{
+}
+
+FrameRing::~FrameRing()
+{
+    Term();
+}
+
+bool FrameRing::Init(uint32_t partitionSize, uint32_t partitionCount)
+{
+    if (partitionSize == 0 || partitionCount == 0)
+    {
+        return false;
+    }
+
+    m_FenceValues.assign(partitionCount, 0);
+    m_PartitionSize = partitionSize;
+    m_Partition     = 0;
+    m_Head          = 0;
+    m_Peak          = 0;
+    m_Recording     = false;
+
+    return true;
+}
+
+void FrameRing::Term()
+{
+    m_FenceValues.clear();
+    m_PartitionSize = 0;
+    m_Partition     = 0;
+    m_Head          = 0;
+    m_Peak          = 0;
+    m_Recording     = false;
+}
+
+bool FrameRing::BeginFrame(uint32_t partition, uint64_t completedValue)
+{
+    if (partition >= m_FenceValues.size())
+    {
+        return false;
+    }
+
+    if (m_FenceValues[partition] > completedValue)
+    {
+        return false;
+    }
+
+    m_Partition = partition;
+    m_Head      = 0;
+    m_Recording = true;
+
+    return true;
+}
+
+void FrameRing::EndFrame(uint64_t fenceValue)
+{
+    if (!m_Recording)
+    {
+        return;
+    }
+
+    m_FenceValues[m_Partition] = fenceValue;
+    m_Recording = false;
+}
+
+bool FrameRing::Alloc(uint32_t count, uint32_t alignment, uint32_t& offset)
+{
+    if (!m_Recording || count == 0)
+    {
+        return false;
+    }
+
+    const auto mask = (alignment > 1) ? alignment - 1 : 0;
+    const auto head = (m_Head + mask) & ~mask;
+    if (head > m_PartitionSize || count > m_PartitionSize - head)
+    {
+        return false;
+    }
+
+    offset = m_Partition * m_PartitionSize + head;
+    m_Head = head + count;
+
+    if (m_Head > m_Peak)
+    {
+        m_Peak = m_Head;
+    }
+
+    return true;
+}
+
+uint64_t FrameRing::GetFenceValue(uint32_t partition) const
+{
+    return (partition < m_FenceValues.size()) ? m_FenceValues[partition] : 0;
+}
+
+uint32_t FrameRing::GetUsedCount() const
+{
+    return m_Head;
+}
+
+uint32_t FrameRing::GetPeakCount() const
+{
+    return m_Peak;
+}
+
+uint32_t FrameRing::GetPartitionSize() const
+{
+    return m_PartitionSize;
+}
+
+uint32_t FrameRing::GetPartitionCount() const
+{
+    return uint32_t(m_FenceValues.size());
+}
\ No newline at end of file
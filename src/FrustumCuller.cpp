@@ -0,0 +1,180 @@
+#include <FrustumCuller.h>
+
+using namespace DirectX;
+
+FrustumCuller::FrustumCuller()
+    : m_Count(0)
+{
+    for (auto& plane : m_Planes)
+    {
+        plane = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+FrustumCuller::~FrustumCuller()
+{
+    Term();
+}
+
+void FrustumCuller::Resize(uint32_t count)
+{
+    const size_t padded = (size_t(count) + 3) & ~size_t(3);
+
+    m_CenterX.resize(padded, 0.0f);
+    m_CenterY.resize(padded, 0.0f);
+    m_CenterZ.resize(padded, 0.0f);
+    m_ExtentX.resize(padded, 0.0f);
+    m_ExtentY.resize(padded, 0.0f);
+    m_ExtentZ.resize(padded, 0.0f);
+    m_Count = count;
+}
+
+void FrustumCuller::Term()
+{
+    m_CenterX.clear();
+    m_CenterY.clear();
+    m_CenterZ.clear();
+    m_ExtentX.clear();
+    m_ExtentY.clear();
+    m_ExtentZ.clear();
+    m_Count = 0;
+}
+
+void FrustumCuller::SetBox(uint32_t index, const XMFLOAT3& center, const XMFLOAT3& extents)
+{
+    if (index >= m_Count)
+    {
+        return;
+    }
+
+    m_CenterX[index] = center.x;
+    m_CenterY[index] = center.y;
+    m_CenterZ[index] = center.z;
+    m_ExtentX[index] = extents.x;
+    m_ExtentY[index] = extents.y;
+    m_ExtentZ[index] = extents.z;
+}
+
+void FrustumCuller::SetBox(uint32_t index, const BoundingBox& local, FXMMATRIX world)
+{
+    XMFLOAT3 corners[BoundingBox::CORNER_COUNT];
+    local.GetCorners(corners);
+
+    auto minV = g_XMFltMax.v;
+    auto maxV = XMVectorNegate(g_XMFltMax.v);
+    for (const auto& corner : corners)
+    {
+        const auto p = XMVector3TransformCoord(XMLoadFloat3(&corner), world);
+        minV = XMVectorMin(minV, p);
+        maxV = XMVectorMax(maxV, p);
+    }
+
+    XMFLOAT3 center;
+    XMFLOAT3 extents;
+    XMStoreFloat3(&center,  XMVectorScale(XMVectorAdd(minV, maxV), 0.5f));
+    XMStoreFloat3(&extents, XMVectorScale(XMVectorSubtract(maxV, minV), 0.5f));
+    SetBox(index, center, extents);
+}
+
+void FrustumCuller::SetFrustum(FXMMATRIX viewProj)
+{
+    // clip = v * viewProj, so each clip coordinate is a column of viewProj.
+    const auto m = XMMatrixTranspose(viewProj);
+    const XMVECTOR planes[PlaneCount] = {
+        XMVectorAdd(m.r[3], m.r[0]),        // left
+        XMVectorSubtract(m.r[3], m.r[0]),   // right
+        XMVectorAdd(m.r[3], m.r[1]),        // bottom
+        XMVectorSubtract(m.r[3], m.r[1]),   // top
+        m.r[2],                             // near
+        XMVectorSubtract(m.r[3], m.r[2]),   // far
+    };
+
+    for (uint32_t i = 0; i < PlaneCount; ++i)
+    {
+        XMStoreFloat4(&m_Planes[i], XMPlaneNormalize(planes[i]));
+    }
+}
+
+uint32_t FrustumCuller::Cull(uint32_t begin, uint32_t end, uint32_t* pVisible) const
+{
+    if (end > m_Count)
+    {
+        end = m_Count;
+    }
+
+    if (begin >= end || pVisible == nullptr)
+    {
+        return 0;
+    }
+
+    // Plane components splatted once: normal, |normal| and distance.
+    XMVECTOR nx[PlaneCount], ny[PlaneCount], nz[PlaneCount];
+    XMVECTOR ax[PlaneCount], ay[PlaneCount], az[PlaneCount];
+    XMVECTOR nd[PlaneCount];
+    for (uint32_t p = 0; p < PlaneCount; ++p)
+    {
+        nx[p] = XMVectorReplicate(m_Planes[p].x);
+        ny[p] = XMVectorReplicate(m_Planes[p].y);
+        nz[p] = XMVectorReplicate(m_Planes[p].z);
+        nd[p] = XMVectorReplicate(m_Planes[p].w);
+        ax[p] = XMVectorAbs(nx[p]);
+        ay[p] = XMVectorAbs(ny[p]);
+        az[p] = XMVectorAbs(nz[p]);
+    }
+
+    const auto zero = XMVectorZero();
+    uint32_t count = 0;
+
+    // Start on a multiple of four; lanes outside [begin, end) are dropped.
+    for (auto i = begin & ~3u; i < end; i += 4)
+    {
+        const auto cx = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_CenterX[i]));
+        const auto cy = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_CenterY[i]));
+        const auto cz = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_CenterZ[i]));
+        const auto ex = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_ExtentX[i]));
+        const auto ey = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_ExtentY[i]));
+        const auto ez = XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&m_ExtentZ[i]));
+
+        auto inside = XMVectorTrueInt();
+        for (uint32_t p = 0; p < PlaneCount; ++p)
+        {
+            // Signed distance of the center plus the box's projected radius.
+            auto d = XMVectorMultiplyAdd(cx, nx[p], nd[p]);
+            d = XMVectorMultiplyAdd(cy, ny[p], d);
+            d = XMVectorMultiplyAdd(cz, nz[p], d);
+            d = XMVectorMultiplyAdd(ex, ax[p], d);
+            d = XMVectorMultiplyAdd(ey, ay[p], d);
+            d = XMVectorMultiplyAdd(ez, az[p], d);
+            inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(d, zero));
+        }
+
+        XMUINT4 mask;
+        XMStoreUInt4(&mask, inside);
+        const uint32_t lanes[4] = { mask.x, mask.y, mask.z, mask.w };
+        for (uint32_t lane = 0; lane < 4; ++lane)
+        {
+            const auto index = i + lane;
+            if (lanes[lane] != 0 && index >= begin && index < end)
+            {
+                pVisible[count++] = index;
+            }
+        }
+    }
+
+    return count;
+}
+
+XMFLOAT3 FrustumCuller::GetCenter(uint32_t index) const
+{
+    if (index >= m_Count)
+    {
+        return XMFLOAT3(0.0f, 0.0f, 0.0f);
+    }
+
+    return XMFLOAT3(m_CenterX[index], m_CenterY[index], m_CenterZ[index]);
+}
+
+uint32_t FrustumCuller::GetCount() const
+{
+    return m_Count;
+}
\ No newline at end of file
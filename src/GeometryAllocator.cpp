@@ -0,0 +1,151 @@
+#include <GeometryAllocator.h>
+#include <algorithm>
+#include <new>
+
+GeometryAllocator::GeometryAllocator()
+    : m_VertexCount(0)
+    , m_IndexCount(0)
+{
+}
+
+GeometryAllocator::~GeometryAllocator()
+{
+    Term();
+}
+
+bool GeometryAllocator::Init(uint32_t vertexCount, uint32_t indexCount)
+{
+    Term();
+
+    if (vertexCount == 0 || indexCount == 0)
+    {
+        return false;
+    }
+
+    m_VertexCount = vertexCount;
+    m_IndexCount  = indexCount;
+
+    return true;
+}
+
+void GeometryAllocator::Term()
+{
+    for (auto pPage : m_Pages)
+    {
+        delete pPage;
+    }
+    m_Pages.clear();
+
+    m_VertexCount = 0;
+    m_IndexCount  = 0;
+}
+
+bool GeometryAllocator::Alloc(uint32_t vertexCount, uint32_t indexCount, GeometryRange& range)
+{
+    if (vertexCount == 0 || indexCount == 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < m_Pages.size(); ++i)
+    {
+        auto pPage = m_Pages[i];
+
+        RangeAllocator::Allocation vertices;
+        if (!pPage->Vertices.Alloc(vertexCount, vertices))
+        {
+            continue;
+        }
+
+        RangeAllocator::Allocation indices;
+        if (!pPage->Indices.Alloc(indexCount, indices))
+        {
+            pPage->Vertices.Free(vertices);
+            continue;
+        }
+
+        range.Page     = uint32_t(i);
+        range.Vertices = vertices;
+        range.Indices  = indices;
+
+        return true;
+    }
+
+    return false;
+}
+
+void GeometryAllocator::Free(GeometryRange& range)
+{
+    if (!range.IsValid() || range.Page >= m_Pages.size())
+    {
+        return;
+    }
+
+    auto pPage = m_Pages[range.Page];
+    pPage->Vertices.Free(range.Vertices);
+    pPage->Indices.Free(range.Indices);
+
+    range = GeometryRange();
+}
+
+void GeometryAllocator::GetPageSizeFor
+(
+    uint32_t vertexCount,
+    uint32_t indexCount,
+    uint32_t& pageVertexCount,
+    uint32_t& pageIndexCount
+) const
+{
+    pageVertexCount = std::max(vertexCount, m_VertexCount);
+    pageIndexCount  = std::max(indexCount, m_IndexCount);
+}
+
+bool GeometryAllocator::AddPage(uint32_t vertexCount, uint32_t indexCount)
+{
+    if (vertexCount == 0 || indexCount == 0)
+    {
+        return false;
+    }
+
+    auto pPage = new (std::nothrow) Page();
+    if (pPage == nullptr)
+    {
+        return false;
+    }
+
+    if (!pPage->Vertices.Init(vertexCount) || !pPage->Indices.Init(indexCount))
+    {
+        delete pPage;
+        return false;
+    }
+
+    m_Pages.push_back(pPage);
+    return true;
+}
+
+uint32_t GeometryAllocator::GetPageCount() const
+{
+    return uint32_t(m_Pages.size());
+}
+
+uint32_t GeometryAllocator::GetUsedVertexCount() const
+{
+    uint32_t count = 0;
+    for (auto pPage : m_Pages)
+    {
+        count += pPage->Vertices.GetUsedCount();
+    }
+
+    return count;
+}
+
+uint32_t GeometryAllocator::GetUsedIndexCount() const
+{
+    uint32_t count = 0;
+    for (auto pPage : m_Pages)
+    {
+        count += pPage->Indices.GetUsedCount();
+    }
+
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <GeometryBuffer.h>
+#include <Logger.h>
+#include <new>
+
+GeometryBuffer::GeometryBuffer()
+    : m_pAllocator(nullptr)
+    , m_Stride(0)
+{
+}
+
+GeometryBuffer::~GeometryBuffer()
+{
+    Term();
+}
+
+bool GeometryBuffer::Init
+(
+    GpuAllocator* pAllocator,
+    uint32_t stride,
+    uint32_t vertexCount,
+    uint32_t indexCount
+)
+{
+    if (pAllocator == nullptr || stride == 0 || vertexCount == 0 || indexCount == 0)
+    {
+        ELOG("Error : Invalid Argument.");
+        return false;
+    }
+
+    Term();
+
+    if (!m_Ranges.Init(vertexCount, indexCount))
+    {
+        ELOG("Error : GeometryAllocator::Init() Failed.");
+        return false;
+    }
+
+    m_pAllocator = pAllocator;
+    m_Stride     = stride;
+
+    return true;
+}
+
+void GeometryBuffer::Term()
+{
+    for (auto pPage : m_Pages)
+    {
+        delete pPage;
+    }
+    m_Pages.clear();
+
+    m_Ranges.Term();
+
+    m_pAllocator = nullptr;
+    m_Stride     = 0;
+}
+
+bool GeometryBuffer::Alloc(uint32_t vertexCount, uint32_t indexCount, GeometryRange& range)
+{
+    if (m_pAllocator == nullptr || vertexCount == 0 || indexCount == 0)
+    {
+        return false;
+    }
+
+    if (m_Ranges.Alloc(vertexCount, indexCount, range))
+    {
+        return true;
+    }
+
+    uint32_t pageVertexCount;
+    uint32_t pageIndexCount;
+    m_Ranges.GetPageSizeFor(vertexCount, indexCount, pageVertexCount, pageIndexCount);
+
+    if (!AddPage(pageVertexCount, pageIndexCount))
+    {
+        return false;
+    }
+
+    return m_Ranges.Alloc(vertexCount, indexCount, range);
+}
+
+void GeometryBuffer::Free(GeometryRange& range)
+{
+    m_Ranges.Free(range);
+}
+
+bool GeometryBuffer::Upload
+(
+    UploadBatch* pBatch,
+    const GeometryRange& range,
+    const void* pVertices,
+    const uint32_t* pIndices
+)
+{
+    if (pBatch == nullptr || !range.IsValid() || range.Page >= m_Pages.size())
+    {
+        return false;
+    }
+
+    auto pPage = m_Pages[range.Page];
+
+    if (pVertices != nullptr && !pBatch->Upload(
+        pPage->VB.GetResource(),
+        UINT64(range.Vertices.Offset) * m_Stride,
+        pVertices,
+        UINT64(range.Vertices.Count) * m_Stride))
+    {
+        return false;
+    }
+
+    if (pIndices != nullptr && !pBatch->Upload(
+        pPage->IB.GetResource(),
+        UINT64(range.Indices.Offset) * sizeof(uint32_t),
+        pIndices,
+        UINT64(range.Indices.Count) * sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void GeometryBuffer::Bind(ID3D12GraphicsCommandList* pCmdList, uint32_t page) const
+{
+    if (page >= m_Pages.size())
+    {
+        return;
+    }
+
+    auto VBV = m_Pages[page]->VB.GetView();
+    auto IBV = m_Pages[page]->IB.GetView();
+    pCmdList->IASetVertexBuffers(0, 1, &VBV);
+    pCmdList->IASetIndexBuffer(&IBV);
+}
+
+uint32_t GeometryBuffer::GetPageCount() const
+{
+    return uint32_t(m_Pages.size());
+}
+
+uint32_t GeometryBuffer::GetUsedVertexCount() const
+{
+    return m_Ranges.GetUsedVertexCount();
+}
+
+uint32_t GeometryBuffer::GetUsedIndexCount() const
+{
+    return m_Ranges.GetUsedIndexCount();
+}
+
+bool GeometryBuffer::AddPage(uint32_t vertexCount, uint32_t indexCount)
+{
+    auto pPage = new (std::nothrow) Page();
+    if (pPage == nullptr)
+    {
+        ELOG("Error : Out of memory.");
+        return false;
+    }
+
+    if (!pPage->VB.Init(m_pAllocator, nullptr, size_t(vertexCount) * m_Stride, m_Stride)
+     || !pPage->IB.Init(m_pAllocator, nullptr, size_t(indexCount) * sizeof(uint32_t))
+     || !m_Ranges.AddPage(vertexCount, indexCount))
+    {
+        ELOG("Error : GeometryBuffer page creation failed. vertices = %u, indices = %u", vertexCount, indexCount);
+        delete pPage;
+        return false;
+    }
+
+    m_Pages.push_back(pPage);
+
+    DLOG("GeometryBuffer page %zu : vertices = %u, indices = %u", m_Pages.size() - 1, vertexCount, indexCount);
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include <GpuAllocator.h>
+#include <Logger.h>
+
+namespace {
+    const D3D12_HEAP_TYPE PoolHeapTypes[HEAP_POOL_COUNT] = {
+        D3D12_HEAP_TYPE_DEFAULT,
+        D3D12_HEAP_TYPE_DEFAULT,
+        D3D12_HEAP_TYPE_DEFAULT,
+        D3D12_HEAP_TYPE_UPLOAD
+    };
+
+    const D3D12_HEAP_FLAGS PoolHeapFlags[HEAP_POOL_COUNT] = {
+        D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS,
+        D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES,
+        D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES,
+        D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS
+    };
+}
+
+GpuAllocator::GpuAllocator()
+    : m_pDevice()
+    , m_Budget(0)
+{
+}
+
+GpuAllocator::~GpuAllocator()
+{
+    Term();
+}
+
+bool GpuAllocator::Init(ID3D12Device* pDevice, UINT64 budget, UINT64 blockSize)
+{
+    if (pDevice == nullptr)
+    {
+        ELOG("Error : Invalid Argument.");
+        return false;
+    }
+
+    Term();
+
+    for (int i = 0; i < HEAP_POOL_COUNT; ++i)
+    {
+        if (!m_Blocks[i].Init(blockSize, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT))
+        {
+            ELOG("Error : HeapBlockAllocator::Init() Failed. blockSize = %llu", blockSize);
+            return false;
+        }
+    }
+
+    m_pDevice = pDevice;
+    m_Budget  = budget;
+
+    return true;
+}
+
+void GpuAllocator::Term()
+{
+    for (int i = 0; i < HEAP_POOL_COUNT; ++i)
+    {
+        m_Blocks[i].Term();
+        m_Heaps[i].clear();
+    }
+
+    m_pDevice.Reset();
+    m_Budget = 0;
+}
+
+HRESULT GpuAllocator::CreateResource
+(
+    D3D12_HEAP_TYPE             heapType,
+    const D3D12_RESOURCE_DESC*  pDesc,
+    D3D12_RESOURCE_STATES       initialState,
+    const D3D12_CLEAR_VALUE*    pClearValue,
+    GpuAllocation&              allocation,
+    ID3D12Resource**            ppResource
+)
+{
+    if (m_pDevice == nullptr || pDesc == nullptr || ppResource == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    allocation = GpuAllocation();
+
+    HEAP_POOL pool;
+    const auto info = m_pDevice->GetResourceAllocationInfo(0, 1, pDesc);
+    if (info.SizeInBytes == UINT64(-1)
+     || info.Alignment > D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT
+     || !GetPool(heapType, pDesc, pool))
+    {
+        D3D12_HEAP_PROPERTIES prop = {};
+        prop.Type                 = heapType;
+        prop.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        prop.CreationNodeMask     = 1;
+        prop.VisibleNodeMask      = 1;
+
+        return m_pDevice->CreateCommittedResource(
+            &prop,
+            D3D12_HEAP_FLAG_NONE,
+            pDesc,
+            initialState,
+            pClearValue,
+            IID_PPV_ARGS(ppResource));
+    }
+
+    auto& blocks = m_Blocks[pool];
+    HeapBlockAllocator::Allocation block;
+
+    if (!blocks.Alloc(info.SizeInBytes, info.Alignment, block))
+    {
+        if (!AddHeap(pool, blocks.GetBlockSizeFor(info.SizeInBytes, info.Alignment))
+         || !blocks.Alloc(info.SizeInBytes, info.Alignment, block))
+        {
+            return E_OUTOFMEMORY;
+        }
+    }
+
+    auto hr = m_pDevice->CreatePlacedResource(
+        m_Heaps[pool][block.Block].Get(),
+        block.Offset,
+        pDesc,
+        initialState,
+        pClearValue,
+        IID_PPV_ARGS(ppResource));
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Device::CreatePlacedResource() Failed. retcode = 0x%x", hr);
+        blocks.Free(block);
+        return hr;
+    }
+
+    allocation.Pool  = pool;
+    allocation.Block = block;
+
+    return S_OK;
+}
+
+void GpuAllocator::Free(GpuAllocation& allocation)
+{
+    if (!allocation.IsValid())
+    {
+        allocation = GpuAllocation();
+        return;
+    }
+
+    auto& blocks = m_Blocks[allocation.Pool];
+    auto& heaps  = m_Heaps[allocation.Pool];
+
+    blocks.Free(allocation.Block);
+    blocks.ReleaseEmptyBlocks(SpareHeapCount, [&heaps](uint32_t index)
+    {
+        heaps[index].Reset();
+    });
+
+    allocation = GpuAllocation();
+}
+
+HeapBlockAllocator::Stats GpuAllocator::GetStats(HEAP_POOL pool) const
+{
+    return m_Blocks[pool].GetStats();
+}
+
+HeapBlockAllocator::Stats GpuAllocator::GetTotalStats() const
+{
+    HeapBlockAllocator::Stats total = {};
+    for (int i = 0; i < HEAP_POOL_COUNT; ++i)
+    {
+        const auto stats = m_Blocks[i].GetStats();
+        total.ReservedBytes   += stats.ReservedBytes;
+        total.UsedBytes       += stats.UsedBytes;
+        total.BlockCount      += stats.BlockCount;
+        total.AllocationCount += stats.AllocationCount;
+        total.FreeRangeCount  += stats.FreeRangeCount;
+
+        if (stats.LargestFreeBytes > total.LargestFreeBytes)
+        {
+            total.LargestFreeBytes = stats.LargestFreeBytes;
+        }
+    }
+
+    return total;
+}
+
+UINT64 GpuAllocator::GetBudget() const
+{
+    return m_Budget;
+}
+
+bool GpuAllocator::GetPool(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC* pDesc, HEAP_POOL& pool)
+{
+    const bool isBuffer = (pDesc->Dimension == D3D12_RESOURCE_DIMENSION_BUFFER);
+
+    if (heapType == D3D12_HEAP_TYPE_UPLOAD)
+    {
+        pool = HEAP_POOL_UPLOAD;
+        return isBuffer;
+    }
+
+    if (heapType != D3D12_HEAP_TYPE_DEFAULT)
+    {
+        return false;
+    }
+
+    if (isBuffer)
+    {
+        pool = HEAP_POOL_BUFFER;
+    }
+    else if (pDesc->Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+    {
+        pool = HEAP_POOL_TARGET;
+    }
+    else
+    {
+        pool = HEAP_POOL_TEXTURE;
+    }
+
+    return true;
+}
+
+bool GpuAllocator::AddHeap(HEAP_POOL pool, UINT64 size)
+{
+    if (m_Budget != 0 && GetTotalStats().ReservedBytes + size > m_Budget)
+    {
+        ELOG("Error : GPU heap budget exceeded. budget = %llu, request = %llu", m_Budget, size);
+        return false;
+    }
+
+    D3D12_HEAP_DESC desc = {};
+    desc.SizeInBytes                     = size;
+    desc.Properties.Type                 = PoolHeapTypes[pool];
+    desc.Properties.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    desc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    desc.Properties.CreationNodeMask     = 1;
+    desc.Properties.VisibleNodeMask      = 1;
+    desc.Alignment                       = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    desc.Flags                           = PoolHeapFlags[pool];
+
+    ComPtr<ID3D12Heap> pHeap;
+    auto hr = m_pDevice->CreateHeap(&desc, IID_PPV_ARGS(pHeap.GetAddressOf()));
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Device::CreateHeap() Failed. retcode = 0x%x", hr);
+        return false;
+    }
+
+    const auto index = m_Blocks[pool].AddBlock(size);
+    if (index == HeapBlockAllocator::InvalidBlock)
+    {
+        return false;
+    }
+
+    auto& heaps = m_Heaps[pool];
+    if (index >= heaps.size())
+    {
+        heaps.resize(index + 1);
+    }
+    heaps[index] = pHeap;
+
+    DLOG("GpuAllocator : heap added. pool = %d, size = %llu", int(pool), size);
+
+    return true;
+}
\ No newline at end of file
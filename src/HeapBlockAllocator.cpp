@@ -0,0 +1,221 @@
+#include <HeapBlockAllocator.h>
+#include <cassert>
+#include <new>
+
+HeapBlockAllocator::HeapBlockAllocator()
+    : m_BlockSize(0)
+    , m_Granularity(0)
+    , m_AllocationCount(0)
+{
+}
+
+HeapBlockAllocator::~HeapBlockAllocator()
+{
+    Term();
+}
+
+bool HeapBlockAllocator::Init(uint64_t blockSize, uint64_t granularity)
+{
+    Term();
+
+    if (granularity == 0 || (granularity & (granularity - 1)) != 0 || blockSize < granularity)
+    {
+        return false;
+    }
+
+    m_BlockSize   = blockSize;
+    m_Granularity = granularity;
+
+    return true;
+}
+
+void HeapBlockAllocator::Term()
+{
+    for (auto& block : m_Blocks)
+    {
+        delete block.pRanges;
+    }
+    m_Blocks.clear();
+    m_FreeSlots.clear();
+
+    m_BlockSize       = 0;
+    m_Granularity     = 0;
+    m_AllocationCount = 0;
+}
+
+bool HeapBlockAllocator::Alloc(uint64_t size, uint64_t alignment, Allocation& allocation)
+{
+    if (size == 0 || m_Granularity == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        return false;
+    }
+
+    const auto units = GetUnitCount(size, alignment);
+    if (units > UINT32_MAX)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < uint32_t(m_Blocks.size()); ++i)
+    {
+        auto& block = m_Blocks[i];
+        if (block.pRanges == nullptr)
+        {
+            continue;
+        }
+
+        RangeAllocator::Allocation range;
+        if (!block.pRanges->Alloc(uint32_t(units), range))
+        {
+            continue;
+        }
+
+        // Alignment above the granularity is met by over-allocating and
+        // placing the resource at the first aligned offset of the range.
+        uint64_t offset = uint64_t(range.Offset) * m_Granularity;
+        if (alignment > m_Granularity)
+        {
+            offset = (offset + alignment - 1) & ~(alignment - 1);
+        }
+
+        allocation.Block  = i;
+        allocation.Offset = offset;
+        allocation.Size   = size;
+        allocation.Range  = range;
+
+        block.AllocationCount++;
+        m_AllocationCount++;
+
+        return true;
+    }
+
+    return false;
+}
+
+void HeapBlockAllocator::Free(Allocation& allocation)
+{
+    if (!allocation.IsValid() || allocation.Block >= m_Blocks.size())
+    {
+        return;
+    }
+
+    auto& block = m_Blocks[allocation.Block];
+    assert(block.pRanges != nullptr && block.AllocationCount > 0);
+
+    block.pRanges->Free(allocation.Range);
+    block.AllocationCount--;
+    m_AllocationCount--;
+
+    allocation = Allocation();
+}
+
+uint64_t HeapBlockAllocator::GetBlockSizeFor(uint64_t size, uint64_t alignment) const
+{
+    if (m_Granularity == 0)
+    {
+        return 0;
+    }
+
+    const auto needed = GetUnitCount(size, alignment) * m_Granularity;
+    return (needed > m_BlockSize) ? needed : m_BlockSize;
+}
+
+uint32_t HeapBlockAllocator::AddBlock(uint64_t size)
+{
+    if (m_Granularity == 0 || size < m_Granularity || size / m_Granularity > UINT32_MAX)
+    {
+        return InvalidBlock;
+    }
+
+    auto pRanges = new (std::nothrow) RangeAllocator();
+    if (pRanges == nullptr)
+    {
+        return InvalidBlock;
+    }
+
+    if (!pRanges->Init(uint32_t(size / m_Granularity)))
+    {
+        delete pRanges;
+        return InvalidBlock;
+    }
+
+    uint32_t index;
+    if (!m_FreeSlots.empty())
+    {
+        index = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        index = uint32_t(m_Blocks.size());
+        m_Blocks.push_back(Block());
+    }
+
+    auto& block = m_Blocks[index];
+    block.pRanges         = pRanges;
+    block.Size            = uint64_t(pRanges->GetSize()) * m_Granularity;
+    block.AllocationCount = 0;
+
+    return index;
+}
+
+HeapBlockAllocator::Stats HeapBlockAllocator::GetStats() const
+{
+    Stats stats = {};
+    stats.AllocationCount = m_AllocationCount;
+
+    for (auto& block : m_Blocks)
+    {
+        if (block.pRanges == nullptr)
+        {
+            continue;
+        }
+
+        const auto largest = uint64_t(block.pRanges->GetLargestFreeRange()) * m_Granularity;
+
+        stats.ReservedBytes  += block.Size;
+        stats.UsedBytes      += uint64_t(block.pRanges->GetUsedCount()) * m_Granularity;
+        stats.FreeRangeCount += block.pRanges->GetFreeRangeCount();
+        stats.BlockCount++;
+
+        if (largest > stats.LargestFreeBytes)
+        {
+            stats.LargestFreeBytes = largest;
+        }
+    }
+
+    return stats;
+}
+
+uint64_t HeapBlockAllocator::GetBlockSize() const
+{
+    return m_BlockSize;
+}
+
+uint64_t HeapBlockAllocator::GetGranularity() const
+{
+    return m_Granularity;
+}
+
+uint64_t HeapBlockAllocator::GetUnitCount(uint64_t size, uint64_t alignment) const
+{
+    auto units = (size + m_Granularity - 1) / m_Granularity;
+    if (alignment > m_Granularity)
+    {
+        units += alignment / m_Granularity - 1;
+    }
+
+    return units;
+}
+
+void HeapBlockAllocator::RemoveBlock(uint32_t index)
+{
+    auto& block = m_Blocks[index];
+    assert(block.AllocationCount == 0);
+
+    delete block.pRanges;
+    block.pRanges = nullptr;
+    block.Size    = 0;
+
+    m_FreeSlots.push_back(index);
+}
\ No newline at end of file
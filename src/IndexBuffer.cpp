@@ -2,6 +2,7 @@
 
 IndexBuffer::IndexBuffer()
     : m_pIB(nullptr)
+    , m_pAllocator(nullptr)
 {
     memset(&m_View, 0, sizeof(m_View));
 }
@@ -13,23 +14,14 @@ IndexBuffer::~IndexBuffer()
 
 bool IndexBuffer::Init
 (
-    ID3D12Device* pDevice,
-    ID3D12CommandQueue* pQueue,
-    CommandList* pCmdList,
-    Fence* pFence,
+    GpuAllocator* pAllocator,
+    UploadBatch* pBatch,
     size_t size,
     const uint32_t* pInitData
 )
 {
-    // UPLOAD     
-    ComPtr<ID3D12Resource> uploadBuffer;
-
-    D3D12_HEAP_PROPERTIES prop = {};
-    prop.Type                 = D3D12_HEAP_TYPE_UPLOAD;
-    prop.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    prop.CreationNodeMask     = 1;
-    prop.VisibleNodeMask      = 1;
+    if (pAllocator == nullptr || size == 0)
+        return false;
 
     D3D12_RESOURCE_DESC desc = {};
     desc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
@@ -44,74 +36,29 @@ bool IndexBuffer::Init
     desc.Layout             = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
     desc.Flags              = D3D12_RESOURCE_FLAG_NONE;
 
-    auto hr = pDevice->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(uploadBuffer.GetAddressOf()));
-    if (FAILED(hr))
-        return false;
-
-    if (pInitData != nullptr)
-    {
-        void* ptr;
-
-        if (FAILED(uploadBuffer->Map(0, nullptr, &ptr)))
-            return false;
-
-        if (ptr == nullptr)
-            return false;
-
-        memcpy(ptr, pInitData, size);
-
-        uploadBuffer->Unmap(0, nullptr);
-    }
-
-    // DEFAULT  
-    prop.Type = D3D12_HEAP_TYPE_DEFAULT;
-    hr = pDevice->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
+    // DEFAULT 힙 생성
+    auto hr = pAllocator->CreateResource(
+        D3D12_HEAP_TYPE_DEFAULT,
         &desc,
         D3D12_RESOURCE_STATE_COMMON,
         nullptr,
+        m_Allocation,
         IID_PPV_ARGS(m_pIB.GetAddressOf()));
     if (FAILED(hr))
         return false;
 
+    m_pAllocator = pAllocator;
+
     m_View.BufferLocation = m_pIB->GetGPUVirtualAddress();
     m_View.Format         = DXGI_FORMAT_R32_UINT;
     m_View.SizeInBytes    = UINT(size);
 
-    // UPLOAD    
-    auto pCmd = pCmdList->Reset();
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource   = m_pIB.Get();
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COMMON;
-    barrier.Transition.StateAfter  = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    pCmd->ResourceBarrier(1, &barrier);
-
-    pCmd->CopyResource(m_pIB.Get(), uploadBuffer.Get());
-
-    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource   = m_pIB.Get();
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.StateAfter  = D3D12_RESOURCE_STATE_COMMON;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    pCmd->ResourceBarrier(1, &barrier);
-
-    pCmd->Close();
-
-    ID3D12CommandList* pLists[] = { pCmd };
-    pQueue->ExecuteCommandLists(1, pLists);
-    pFence->Sync(pQueue);
+    // 업로드 배치에 복사 기록 (배치 제출 시 한 번에 실행)
+    if (pInitData != nullptr)
+    {
+        if (pBatch == nullptr || !pBatch->Upload(m_pIB.Get(), 0, pInitData, UINT64(size)))
+            return false;
+    }
 
     return true;
 }
@@ -119,6 +66,13 @@ bool IndexBuffer::Init
 void IndexBuffer::Term()
 {
     m_pIB.Reset();
+
+    if (m_pAllocator != nullptr)
+    {
+        m_pAllocator->Free(m_Allocation);
+        m_pAllocator = nullptr;
+    }
+
     memset(&m_View, 0, sizeof(m_View));
 }
 
@@ -139,6 +93,11 @@ void IndexBuffer::Unmap()
     m_pIB->Unmap(0, nullptr);
 }
 
+ID3D12Resource* IndexBuffer::GetResource() const
+{
+    return m_pIB.Get();
+}
+
 D3D12_INDEX_BUFFER_VIEW IndexBuffer::GetView() const
 {
     return m_View;
@@ -0,0 +1,289 @@
+#include <JobSystem.h>
+#include <Logger.h>
+#include <new>
+
+namespace {
+    // Which system and deque the current thread belongs to.
+    thread_local const JobSystem*   t_pSystem = nullptr;
+    thread_local uint32_t           t_Index   = 0;
+}
+
+JobSystem::JobSystem()
+    : m_InjectedCount(0)
+    , m_WakeEpoch(0)
+    , m_SleepingCount(0)
+    , m_Stop(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+    Term();
+}
+
+bool JobSystem::Init(uint32_t workerCount)
+{
+    Term();
+
+    if (workerCount == 0)
+    {
+        const auto hardware = std::thread::hardware_concurrency();
+        workerCount = (hardware > 1) ? hardware - 1 : 0;
+    }
+
+    if (!m_JobPool.Init(MaxJobCount))
+    {
+        ELOG("Error : LockFreePool::Init() Failed.");
+        return false;
+    }
+
+    for (auto i = 0u; i < workerCount + 1; ++i)
+    {
+        auto pDeque = new (std::nothrow) WorkStealingDeque<Job>();
+        if (pDeque == nullptr || !pDeque->Init(DequeCapacity))
+        {
+            ELOG("Error : Out of memory.");
+            delete pDeque;
+            Term();
+            return false;
+        }
+
+        m_Deques.push_back(pDeque);
+    }
+
+    t_pSystem = this;
+    t_Index   = 0;
+
+    m_Stop.store(false, std::memory_order_release);
+    m_Workers.reserve(workerCount);
+    for (auto i = 1u; i <= workerCount; ++i)
+    {
+        m_Workers.emplace_back(&JobSystem::WorkerMain, this, i);
+    }
+
+    DLOG("JobSystem : %u workers", workerCount);
+
+    return true;
+}
+
+void JobSystem::Term()
+{
+    if (!m_Workers.empty())
+    {
+        m_Stop.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> guard(m_SleepMutex);
+            m_WakeEpoch++;
+        }
+        m_WakeCond.notify_all();
+
+        for (auto& worker : m_Workers)
+        {
+            worker.join();
+        }
+        m_Workers.clear();
+    }
+
+    for (auto pDeque : m_Deques)
+    {
+        delete pDeque;
+    }
+    m_Deques.clear();
+    m_Injected.clear();
+    m_InjectedCount.store(0, std::memory_order_relaxed);
+    m_JobPool.Term();
+
+    if (t_pSystem == this)
+    {
+        t_pSystem = nullptr;
+    }
+}
+
+void JobSystem::Run(JobFunc&& func, JobCounter* pCounter)
+{
+    Job* pJob = m_Workers.empty() ? nullptr : m_JobPool.Alloc();
+    if (pJob == nullptr)
+    {
+        func();
+        return;
+    }
+
+    pJob->Func     = std::move(func);
+    pJob->pCounter = pCounter;
+
+    if (pCounter != nullptr)
+    {
+        pCounter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const auto index = GetThreadIndex();
+    if (index != InvalidThread)
+    {
+        if (!m_Deques[index]->Push(pJob))
+        {
+            Execute(pJob);
+            return;
+        }
+    }
+    else
+    {
+        std::lock_guard<std::mutex> guard(m_InjectMutex);
+        m_Injected.push_back(pJob);
+        m_InjectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Wake();
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    const auto index = GetThreadIndex();
+
+    while (!counter.IsDone())
+    {
+        auto pJob = FindJob(index);
+        if (pJob != nullptr)
+        {
+            Execute(pJob);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+uint32_t JobSystem::GetThreadCount() const
+{
+    return uint32_t(m_Workers.size()) + 1;
+}
+
+void JobSystem::WorkerMain(uint32_t index)
+{
+    t_pSystem = this;
+    t_Index   = index;
+
+    while (!m_Stop.load(std::memory_order_acquire))
+    {
+        auto pJob = FindJob(index);
+        for (auto i = 0u; pJob == nullptr && i < IdleSpinCount; ++i)
+        {
+            std::this_thread::yield();
+            pJob = FindJob(index);
+        }
+
+        if (pJob == nullptr)
+        {
+            pJob = Sleep(index);
+        }
+
+        if (pJob != nullptr)
+        {
+            Execute(pJob);
+        }
+    }
+}
+
+uint32_t JobSystem::GetThreadIndex() const
+{
+    return (t_pSystem == this) ? t_Index : InvalidThread;
+}
+
+JobSystem::Job* JobSystem::FindJob(uint32_t index)
+{
+    if (index != InvalidThread)
+    {
+        auto pJob = m_Deques[index]->Pop();
+        if (pJob != nullptr)
+        {
+            return pJob;
+        }
+    }
+
+    if (m_InjectedCount.load(std::memory_order_relaxed) > 0)
+    {
+        std::lock_guard<std::mutex> guard(m_InjectMutex);
+        if (!m_Injected.empty())
+        {
+            auto pJob = m_Injected.front();
+            m_Injected.pop_front();
+            m_InjectedCount.fetch_sub(1, std::memory_order_relaxed);
+            return pJob;
+        }
+    }
+
+    // Start at a different victim per thread so thieves spread out.
+    const auto count = uint32_t(m_Deques.size());
+    const auto start = (index != InvalidThread) ? index + 1 : 0;
+    for (auto i = 0u; i < count; ++i)
+    {
+        const auto victim = (start + i) % count;
+        if (victim == index)
+        {
+            continue;
+        }
+
+        auto pJob = m_Deques[victim]->Steal();
+        if (pJob != nullptr)
+        {
+            return pJob;
+        }
+    }
+
+    return nullptr;
+}
+
+JobSystem::Job* JobSystem::Sleep(uint32_t index)
+{
+    std::unique_lock<std::mutex> lock(m_SleepMutex);
+    const auto epoch = m_WakeEpoch;
+    m_SleepingCount.fetch_add(1, std::memory_order_seq_cst);
+    lock.unlock();
+
+    // A job queued before the count went up was not seen by Wake(), so look
+    // once more before going to sleep.
+    auto pJob = FindJob(index);
+    if (pJob == nullptr)
+    {
+        lock.lock();
+        m_WakeCond.wait(lock, [this, epoch]()
+        {
+            return m_WakeEpoch != epoch || m_Stop.load(std::memory_order_acquire);
+        });
+    }
+
+    m_SleepingCount.fetch_sub(1, std::memory_order_relaxed);
+    return pJob;
+}
+
+void JobSystem::Wake()
+{
+    // Orders the push before reading the sleeper count; pairs with Sleep().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_SleepingCount.load(std::memory_order_seq_cst) == 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_SleepMutex);
+        m_WakeEpoch++;
+    }
+    m_WakeCond.notify_one();
+}
+
+void JobSystem::Execute(Job* pJob)
+{
+    pJob->Func();
+
+    auto pCounter = pJob->pCounter;
+
+    // LockFreePool::Free() does not run destructors.
+    pJob->~Job();
+    m_JobPool.Free(pJob);
+
+    if (pCounter != nullptr)
+    {
+        pCounter->m_Pending.fetch_sub(1, std::memory_order_release);
+    }
+}
\ No newline at end of file
@@ -4,6 +4,13 @@
 
 namespace {
     const wchar_t* DummyTag = L"";
+
+    // Texture usages in texture table order.
+    const Material::TEXTURE_USAGE TableUsages[Material::TextureTableSize] = {
+        Material::TEXTURE_USAGE_DIFFUSE,
+        Material::TEXTURE_USAGE_NORMAL,
+        Material::TEXTURE_USAGE_SPECULAR
+    };
 }
 
 Material::Material()
@@ -20,12 +27,13 @@ Material::~Material()
 bool Material::Init
 (
     ID3D12Device*   pDevice,
+    GpuAllocator*   pAllocator,
     DescriptorPool* pPool,
     size_t          bufferSize,
     size_t          count
 )
 {
-    if (pDevice == nullptr || pPool == nullptr || count == 0)
+    if (pDevice == nullptr || pAllocator == nullptr || pPool == nullptr || count == 0)
     {
         ELOG("Error : Invalid Argument.");
         return false;
@@ -41,6 +49,13 @@ bool Material::Init
 
     m_Subset.resize(count);
 
+    m_TableCache.Init(MaxUnusedTableCount);
+    for (size_t i = 0; i < m_Subset.size(); ++i)
+    {
+        m_Subset[i].TableEntry = TextureTableCache::InvalidIndex;
+        m_Subset[i].TableDirty = true;
+    }
+
     auto pTexture = new (std::nothrow) Texture();
     if (pTexture == nullptr)
     {
@@ -58,7 +73,7 @@ bool Material::Init
     desc.SampleDesc.Count   = 1;
     desc.SampleDesc.Quality = 0;
 
-    if (!pTexture->Init(pDevice, pPool, &desc, false))
+    if (!pTexture->Init(pDevice, pAllocator, pPool, &desc, false))
     {
         ELOG("Error : Texture::Init() Failed.");
         pTexture->Term();
@@ -80,7 +95,7 @@ bool Material::Init
                 return false;
             }
 
-            if (!pBuffer->Init(pDevice, pPool, bufferSize, 1))
+            if (!pBuffer->Init(pDevice, pAllocator, pPool, bufferSize, 1))
             {
                 ELOG("Error : ConstantBuffer::Init() Failed.");
                 return false;
@@ -88,7 +103,7 @@ bool Material::Init
 
             m_Subset[i].pCostantBuffer = pBuffer;
             for (auto j = 0; j < TEXTURE_USAGE_COUNT; ++j)
-                m_Subset[i].TextureHandle[j].ptr = 0;
+                m_Subset[i].TextureHandle[j] = DescriptorId();
         }
     }
     else
@@ -97,7 +112,7 @@ bool Material::Init
         {
             m_Subset[i].pCostantBuffer = nullptr;
             for (auto j = 0; j < TEXTURE_USAGE_COUNT; ++j)
-                m_Subset[i].TextureHandle[j].ptr = 0;
+                m_Subset[i].TextureHandle[j] = DescriptorId();
         }
     }
 
@@ -126,6 +141,11 @@ void Material::Term()
         }
     }
 
+    m_TableCache.Clear([this](DescriptorRange& range)
+    {
+        m_pPool->FreeRange(range);
+    });
+
     m_pTexture.clear();
     m_Subset.clear();
 
@@ -142,6 +162,69 @@ void Material::Term()
     }
 }
 
+void Material::Retire(RetireQueue& queue, uint64_t retireValue)
+{
+    if (m_pPool == nullptr)
+    {
+        Term();
+        return;
+    }
+
+    std::vector<Texture*>           textures;
+    std::vector<ConstantBuffer*>    buffers;
+    std::vector<DescriptorRange>    ranges;
+
+    for (auto& itr : m_pTexture)
+    {
+        if (itr.second != nullptr)
+            textures.push_back(itr.second);
+    }
+    m_pTexture.clear();
+
+    for (auto& subset : m_Subset)
+    {
+        if (subset.pCostantBuffer != nullptr)
+            buffers.push_back(subset.pCostantBuffer);
+
+        subset.pCostantBuffer = nullptr;
+    }
+
+    m_TableCache.Clear([&ranges](DescriptorRange& range)
+    {
+        ranges.push_back(range);
+    });
+
+    // The queued release holds a reference so that the ranges can be
+    // returned to the pool.
+    auto pPool = m_pPool;
+    pPool->AddRef();
+
+    queue.Enqueue(retireValue, [textures, buffers, ranges, pPool]() mutable
+    {
+        for (auto pTexture : textures)
+        {
+            pTexture->Term();
+            delete pTexture;
+        }
+
+        for (auto pBuffer : buffers)
+        {
+            pBuffer->Term();
+            delete pBuffer;
+        }
+
+        for (auto& range : ranges)
+        {
+            pPool->FreeRange(range);
+        }
+
+        pPool->Release();
+    });
+
+    // The queued release owns them now.
+    Term();
+}
+
 bool Material::SetTexture
 (
     size_t                          index,
@@ -157,13 +240,13 @@ bool Material::SetTexture
 
     if (PathFileExistsW(path.c_str()) == FALSE || (fileAttr & FILE_ATTRIBUTE_DIRECTORY))
     {
-        m_Subset[index].TextureHandle[usage] = m_pTexture[DummyTag]->GetHandleGPU();
+        SetTextureHandle(index, usage, m_pTexture[DummyTag]);
         return true;
     }
 
     if (m_pTexture.find(path) != m_pTexture.end())
     {
-        m_Subset[index].TextureHandle[usage] = m_pTexture[path]->GetHandleGPU();
+        SetTextureHandle(index, usage, m_pTexture[path]);
         return true;
     }
 
@@ -184,7 +267,7 @@ bool Material::SetTexture
     }
 
     m_pTexture[path] = pTexture;
-    m_Subset[index].TextureHandle[usage] = pTexture->GetHandleGPU();
+    SetTextureHandle(index, usage, pTexture);
 
     return true;
 }
@@ -204,7 +287,7 @@ bool Material::SetTexture
 
     if (m_pTexture.find(path) != m_pTexture.end())
     {
-        m_Subset[index].TextureHandle[usage] = m_pTexture[path]->GetHandleGPU();
+        SetTextureHandle(index, usage, m_pTexture[path]);
         return true;
     }
 
@@ -224,7 +307,7 @@ bool Material::SetTexture
     }
 
     m_pTexture[path] = pTexture;
-    m_Subset[index].TextureHandle[usage] = pTexture->GetHandleGPU();
+    SetTextureHandle(index, usage, pTexture);
 
     return true;
 }
@@ -256,7 +339,119 @@ D3D12_GPU_DESCRIPTOR_HANDLE Material::GetTextureHandle(size_t index, TEXTURE_USA
         return D3D12_GPU_DESCRIPTOR_HANDLE();
     }
 
-    return m_Subset[index].TextureHandle[usage];
+    // Resolved on every call: the GPU handle changes when the pool rehomes
+    // its shader-visible heap.
+    auto pHandle = m_pPool->GetHandle(m_Subset[index].TextureHandle[usage]);
+    if (pHandle == nullptr)
+    {
+        return D3D12_GPU_DESCRIPTOR_HANDLE();
+    }
+
+    return pHandle->HandleGPU;
+}
+
+uint32_t Material::GetTextureIndex(size_t index, TEXTURE_USAGE usage) const
+{
+    auto id = (index < GetCount()) ? m_Subset[index].TextureHandle[usage] : DescriptorId();
+    if (!id.IsValid())
+    {
+        return m_pTexture.at(DummyTag)->GetHeapIndex();
+    }
+
+    // Ids index the pool's pages, which sit at the start of the shader-visible heap.
+    return id.GetIndex();
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE Material::GetTextureTable(size_t index) const
+{
+    if (index >= GetCount())
+    {
+        return D3D12_GPU_DESCRIPTOR_HANDLE();
+    }
+
+    auto pRange = m_TableCache.Get(m_Subset[index].TableEntry);
+    if (pRange == nullptr)
+    {
+        return D3D12_GPU_DESCRIPTOR_HANDLE();
+    }
+
+    return m_pPool->GetRangeHandleGPU(*pRange);
+}
+
+void Material::CommitTextureTables(uint64_t retireValue, uint64_t completedValue)
+{
+    if (m_pPool == nullptr)
+        return;
+
+    std::vector<DescriptorRange>             newRanges;
+    std::vector<D3D12_CPU_DESCRIPTOR_HANDLE> srcHandles;
+
+    const auto pDummy = m_pTexture[DummyTag];
+
+    for (auto& subset : m_Subset)
+    {
+        if (!subset.TableDirty)
+            continue;
+
+        // Unset usages fall back to the dummy texture, like SetTexture() does
+        // for missing files.
+        TextureTableCache::Key key;
+        for (auto i = 0u; i < TextureTableSize; ++i)
+        {
+            auto id = subset.TextureHandle[TableUsages[i]];
+            key[i] = id.IsValid() ? id.Value : pDummy->GetHandleId().Value;
+        }
+
+        auto entry = m_TableCache.Acquire(key);
+        if (entry == TextureTableCache::InvalidIndex)
+        {
+            DescriptorRange range;
+            if (!m_pPool->AllocRange(TextureTableSize, range))
+            {
+                ELOG("Error : DescriptorPool::AllocRange() Failed.");
+                continue;
+            }
+
+            for (auto i = 0u; i < TextureTableSize; ++i)
+            {
+                DescriptorId id;
+                id.Value = key[i];
+
+                auto pHandle = m_pPool->GetHandle(id);
+                srcHandles.push_back((pHandle != nullptr) ? pHandle->HandleCPU : pDummy->GetHandleCPU());
+            }
+
+            newRanges.push_back(range);
+            entry = m_TableCache.Insert(key, range);
+        }
+
+        // Released after the acquire so an unchanged key is never evicted in between.
+        m_TableCache.Release(subset.TableEntry, retireValue);
+
+        subset.TableEntry = entry;
+        subset.TableDirty = false;
+    }
+
+    if (!newRanges.empty())
+    {
+        m_pPool->CopyToRanges(newRanges.data(), uint32_t(newRanges.size()), srcHandles.data());
+    }
+
+    m_TableCache.Trim(completedValue, [this](DescriptorRange& range)
+    {
+        m_pPool->FreeRange(range);
+    });
+}
+
+void Material::SetTextureHandle(size_t index, TEXTURE_USAGE usage, const Texture* pTexture)
+{
+    m_Subset[index].TextureHandle[usage] = pTexture->GetHandleId();
+
+    for (auto tableUsage : TableUsages)
+    {
+        if (tableUsage == usage)
+            m_Subset[index].TableDirty = true;
+    }
 }
 
 size_t Material::GetCount() const
@@ -0,0 +1,75 @@
+#include <MemoryUtil.h>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define STREAM_COPY_SSE2    1
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define STREAM_COPY_AVX     1
+#include <immintrin.h>
+#endif
+#endif
+
+namespace {
+    constexpr size_t LineSize      = 64;
+    constexpr size_t StreamMinSize = 4096;          // below this, memcpy wins (see StreamCopyBench)
+}
+
+void StreamCopy(void* pDst, const void* pSrc, size_t size)
+{
+#if STREAM_COPY_SSE2
+    if (size < StreamMinSize)
+    {
+        memcpy(pDst, pSrc, size);
+        return;
+    }
+
+    auto dst = static_cast<uint8_t*>(pDst);
+    auto src = static_cast<const uint8_t*>(pSrc);
+
+    // Bring the destination to a line boundary so every streamed line is full.
+    const auto head = (LineSize - (reinterpret_cast<uintptr_t>(dst) & (LineSize - 1))) & (LineSize - 1);
+    if (head != 0)
+    {
+        memcpy(dst, src, head);
+        dst  += head;
+        src  += head;
+        size -= head;
+    }
+
+    const auto lines = size / LineSize;
+    for (size_t i = 0; i < lines; ++i)
+    {
+#if STREAM_COPY_AVX
+        const auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst),      a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 32), b);
+#else
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+        const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst),      a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+#endif
+        dst += LineSize;
+        src += LineSize;
+    }
+
+    // Order the streaming stores before anything that publishes the data,
+    // e.g. a fence signal or command list submission.
+    _mm_sfence();
+
+    const auto tail = size - lines * LineSize;
+    if (tail != 0)
+    {
+        memcpy(dst, src, tail);
+    }
+#else
+    memcpy(pDst, pSrc, size);
+#endif
+}
\ No newline at end of file
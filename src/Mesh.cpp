@@ -3,8 +3,8 @@
 float Mesh::Scale = 1.0f;
 
 Mesh::Mesh()
-    : m_MaterialId(UINT32_MAX)
-    , m_IndexCount(0)
+    : m_pGeometry(nullptr)
+    , m_MaterialId(UINT32_MAX)
 {
 }
 
@@ -15,63 +15,70 @@ Mesh::~Mesh()
 
 bool Mesh::Init
 (
-    ID3D12Device* pDevice,
-    ID3D12CommandQueue* pQueue,
-    CommandList* pCmdList,
-    Fence* pFence,
+    GeometryBuffer* pGeometry,
+    UploadBatch* pBatch,
     const ResMesh& resource
 )
 {
-    if (pDevice == nullptr)
+    if (pGeometry == nullptr)
         return false;
 
-    if (!m_VB.Init(
-        pDevice,
-        pQueue,
-        pCmdList,
-        pFence,
-        sizeof(MeshVertex) * resource.Vertices.size(),
-        resource.Vertices.data()))
+    Term();
+
+    if (!pGeometry->Alloc(
+        uint32_t(resource.Vertices.size()),
+        uint32_t(resource.Indices.size()),
+        m_Range))
     {
         return false;
     }
 
-    if (!m_IB.Init(
-        pDevice,
-        pQueue,
-        pCmdList,
-        pFence,
-        sizeof(uint32_t) * resource.Indices.size(),
-        resource.Indices.data()))
+    m_pGeometry = pGeometry;
+
+    if (!pGeometry->Upload(pBatch, m_Range, resource.Vertices.data(), resource.Indices.data()))
     {
+        Term();
         return false;
     }
 
     m_MaterialId = resource.MaterialId;
-    m_IndexCount = uint32_t(resource.Indices.size());
+    m_Bounds     = resource.Bounds;
 
     return true;
 }
 
 void Mesh::Term()
 {
-    m_VB.Term();
-    m_IB.Term();
+    if (m_pGeometry != nullptr)
+    {
+        m_pGeometry->Free(m_Range);
+        m_pGeometry = nullptr;
+    }
+
     m_MaterialId = UINT32_MAX;
-    m_IndexCount = 0;
 }
 
-void Mesh::Draw(ID3D12GraphicsCommandList* pCmdList)
+void Mesh::Draw(ID3D12GraphicsCommandList* pCmdList, uint32_t instanceCount)
 {
-    auto VBV = m_VB.GetView();
-    auto IBV = m_IB.GetView();
-    pCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    pCmdList->IASetVertexBuffers(0, 1, &VBV);
-    pCmdList->IASetIndexBuffer(&IBV);
-    pCmdList->DrawIndexedInstanced(m_IndexCount, 1, 0, 0, 0);
+    pCmdList->DrawIndexedInstanced(
+        m_Range.GetIndexCount(),
+        instanceCount,
+        m_Range.GetFirstIndex(),
+        INT(m_Range.GetBaseVertex()),
+        0);
 }
 
 uint32_t Mesh::GetMaterialId() const
 {
     return m_MaterialId;
+}
+
+uint32_t Mesh::GetPage() const
+{
+    return m_Range.Page;
+}
+
+const DirectX::BoundingBox& Mesh::GetBounds() const
+{
+    return m_Bounds;
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <RadixSort.h>
+#include <cassert>
+
+RadixSorter::RadixSorter()
+{
+}
+
+RadixSorter::~RadixSorter()
+{
+    Term();
+}
+
+void RadixSorter::Sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values)
+{
+    assert(keys.size() == values.size());
+
+    const auto count = uint32_t(keys.size());
+    if (count < 2)
+    {
+        return;
+    }
+
+    uint32_t histograms[PassCount][RadixSize] = {};
+    for (const auto key : keys)
+    {
+        for (uint32_t pass = 0; pass < PassCount; ++pass)
+        {
+            histograms[pass][(key >> (pass * RadixBits)) & (RadixSize - 1)]++;
+        }
+    }
+
+    m_TempKeys.resize(count);
+    m_TempValues.resize(count);
+
+    for (uint32_t pass = 0; pass < PassCount; ++pass)
+    {
+        const auto shift = pass * RadixBits;
+        auto& offsets = histograms[pass];
+
+        // All keys share this byte; the pass would not move anything.
+        if (offsets[(keys[0] >> shift) & (RadixSize - 1)] == count)
+        {
+            continue;
+        }
+
+        uint32_t sum = 0;
+        for (auto& offset : offsets)
+        {
+            const auto bucket = offset;
+            offset = sum;
+            sum += bucket;
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto dst = offsets[(keys[i] >> shift) & (RadixSize - 1)]++;
+            m_TempKeys[dst]   = keys[i];
+            m_TempValues[dst] = values[i];
+        }
+
+        keys.swap(m_TempKeys);
+        values.swap(m_TempValues);
+    }
+}
+
+void RadixSorter::Term()
+{
+    m_TempKeys.clear();
+    m_TempKeys.shrink_to_fit();
+    m_TempValues.clear();
+    m_TempValues.shrink_to_fit();
+}
\ No newline at end of file
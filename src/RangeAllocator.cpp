@@ -0,0 +1,371 @@
+#include <RangeAllocator.h>
+#include <cassert>
+
+RangeAllocator::RangeAllocator()
+    : m_ClassMask(0)
+    , m_LastNode(InvalidNode)
+    , m_Size(0)
+    , m_UsedCount(0)
+    , m_FreeRangeCount(0)
+{
+    for (auto i = 0u; i < ClassCount; ++i)
+    {
+        m_FreeHead[i] = InvalidNode;
+    }
+}
+
+RangeAllocator::~RangeAllocator()
+{
+    Term();
+}
+
+bool RangeAllocator::Init(uint32_t size)
+{
+    Term();
+
+    if (size == 0)
+    {
+        return true;
+    }
+
+    return Grow(size);
+}
+
+void RangeAllocator::Term()
+{
+    m_Nodes.clear();
+    m_UnusedNodes.clear();
+
+    for (auto i = 0u; i < ClassCount; ++i)
+    {
+        m_FreeHead[i] = InvalidNode;
+    }
+
+    m_ClassMask      = 0;
+    m_LastNode       = InvalidNode;
+    m_Size           = 0;
+    m_UsedCount      = 0;
+    m_FreeRangeCount = 0;
+}
+
+bool RangeAllocator::Grow(uint32_t size)
+{
+    if (size <= m_Size)
+    {
+        return size == m_Size;
+    }
+
+    const auto delta = size - m_Size;
+
+    if (m_LastNode != InvalidNode && m_Nodes[m_LastNode].IsFree)
+    {
+        RemoveFree(m_LastNode);
+        m_Nodes[m_LastNode].Size += delta;
+        InsertFree(m_LastNode);
+    }
+    else
+    {
+        auto node = NewNode();
+        auto& n = m_Nodes[node];
+        n.Offset   = m_Size;
+        n.Size     = delta;
+        n.PrevPhys = m_LastNode;
+        n.NextPhys = InvalidNode;
+
+        if (m_LastNode != InvalidNode)
+        {
+            m_Nodes[m_LastNode].NextPhys = node;
+        }
+
+        m_LastNode = node;
+        InsertFree(node);
+    }
+
+    m_Size = size;
+    return true;
+}
+
+bool RangeAllocator::Alloc(uint32_t count, Allocation& allocation)
+{
+    if (count == 0 || count > GetFreeCount())
+    {
+        return false;
+    }
+
+    const auto cls = GetClass(count);
+    auto node = FindInClass(cls, count, MaxClassScanCount);
+
+    // Any range of a larger class is at least 2^(cls + 1) > count.
+    if (node == InvalidNode)
+    {
+        auto mask = (cls + 1 < ClassCount) ? m_ClassMask & ~((2u << cls) - 1) : 0;
+        if (mask != 0)
+        {
+            auto larger = cls + 1;
+            while ((mask & (1u << larger)) == 0)
+            {
+                ++larger;
+            }
+
+            node = m_FreeHead[larger];
+        }
+    }
+
+    // Only the own class is left; a range there may still fit.
+    if (node == InvalidNode)
+    {
+        node = FindInClass(cls, count, uint32_t(-1));
+        if (node == InvalidNode)
+        {
+            return false;
+        }
+    }
+
+    RemoveFree(node);
+
+    if (m_Nodes[node].Size > count)
+    {
+        auto rest = NewNode();
+
+        // NewNode() may reallocate m_Nodes, so references are taken afterwards.
+        auto& n = m_Nodes[node];
+        auto& r = m_Nodes[rest];
+        r.Offset   = n.Offset + count;
+        r.Size     = n.Size - count;
+        r.PrevPhys = node;
+        r.NextPhys = n.NextPhys;
+
+        if (n.NextPhys != InvalidNode)
+        {
+            m_Nodes[n.NextPhys].PrevPhys = rest;
+        }
+        else
+        {
+            m_LastNode = rest;
+        }
+
+        n.NextPhys = rest;
+        n.Size     = count;
+
+        InsertFree(rest);
+    }
+
+    m_UsedCount += count;
+
+    allocation.Offset = m_Nodes[node].Offset;
+    allocation.Count  = count;
+    allocation.Node   = node;
+
+    return true;
+}
+
+void RangeAllocator::Free(Allocation& allocation)
+{
+    if (!allocation.IsValid())
+    {
+        return;
+    }
+
+    auto node = allocation.Node;
+    assert(node < m_Nodes.size() && !m_Nodes[node].IsFree);
+    assert(m_Nodes[node].Offset == allocation.Offset);
+
+    m_UsedCount -= m_Nodes[node].Size;
+
+    auto next = m_Nodes[node].NextPhys;
+    if (next != InvalidNode && m_Nodes[next].IsFree)
+    {
+        RemoveFree(next);
+
+        m_Nodes[node].Size    += m_Nodes[next].Size;
+        m_Nodes[node].NextPhys = m_Nodes[next].NextPhys;
+
+        if (m_Nodes[next].NextPhys != InvalidNode)
+        {
+            m_Nodes[m_Nodes[next].NextPhys].PrevPhys = node;
+        }
+        else
+        {
+            m_LastNode = node;
+        }
+
+        ReleaseNode(next);
+    }
+
+    auto prev = m_Nodes[node].PrevPhys;
+    if (prev != InvalidNode && m_Nodes[prev].IsFree)
+    {
+        RemoveFree(prev);
+
+        m_Nodes[prev].Size    += m_Nodes[node].Size;
+        m_Nodes[prev].NextPhys = m_Nodes[node].NextPhys;
+
+        if (m_Nodes[node].NextPhys != InvalidNode)
+        {
+            m_Nodes[m_Nodes[node].NextPhys].PrevPhys = prev;
+        }
+        else
+        {
+            m_LastNode = prev;
+        }
+
+        ReleaseNode(node);
+        node = prev;
+    }
+
+    InsertFree(node);
+
+    allocation = Allocation();
+}
+
+uint32_t RangeAllocator::GetSize() const
+{
+    return m_Size;
+}
+
+uint32_t RangeAllocator::GetUsedCount() const
+{
+    return m_UsedCount;
+}
+
+uint32_t RangeAllocator::GetFreeCount() const
+{
+    return m_Size - m_UsedCount;
+}
+
+uint32_t RangeAllocator::GetFreeRangeCount() const
+{
+    return m_FreeRangeCount;
+}
+
+uint32_t RangeAllocator::GetLargestFreeRange() const
+{
+    if (m_ClassMask == 0)
+    {
+        return 0;
+    }
+
+    auto cls = ClassCount - 1;
+    while ((m_ClassMask & (1u << cls)) == 0)
+    {
+        --cls;
+    }
+
+    uint32_t largest = 0;
+    for (auto i = m_FreeHead[cls]; i != InvalidNode; i = m_Nodes[i].NextFree)
+    {
+        if (m_Nodes[i].Size > largest)
+        {
+            largest = m_Nodes[i].Size;
+        }
+    }
+
+    return largest;
+}
+
+uint32_t RangeAllocator::GetClass(uint32_t size)
+{
+    uint32_t cls = 0;
+    while (size >>= 1)
+    {
+        ++cls;
+    }
+
+    return cls;
+}
+
+uint32_t RangeAllocator::FindInClass(uint32_t cls, uint32_t count, uint32_t maxScanCount) const
+{
+    auto scanCount = 0u;
+    for (auto i = m_FreeHead[cls]; i != InvalidNode && scanCount < maxScanCount; i = m_Nodes[i].NextFree)
+    {
+        if (m_Nodes[i].Size >= count)
+        {
+            return i;
+        }
+
+        scanCount++;
+    }
+
+    return InvalidNode;
+}
+
+uint32_t RangeAllocator::NewNode()
+{
+    uint32_t node;
+    if (!m_UnusedNodes.empty())
+    {
+        node = m_UnusedNodes.back();
+        m_UnusedNodes.pop_back();
+    }
+    else
+    {
+        node = uint32_t(m_Nodes.size());
+        m_Nodes.push_back(Node());
+    }
+
+    auto& n = m_Nodes[node];
+    n.Offset   = 0;
+    n.Size     = 0;
+    n.PrevPhys = InvalidNode;
+    n.NextPhys = InvalidNode;
+    n.PrevFree = InvalidNode;
+    n.NextFree = InvalidNode;
+    n.IsFree   = false;
+
+    return node;
+}
+
+void RangeAllocator::ReleaseNode(uint32_t node)
+{
+    m_UnusedNodes.push_back(node);
+}
+
+void RangeAllocator::InsertFree(uint32_t node)
+{
+    auto& n = m_Nodes[node];
+    const auto cls = GetClass(n.Size);
+
+    n.IsFree   = true;
+    n.PrevFree = InvalidNode;
+    n.NextFree = m_FreeHead[cls];
+
+    if (n.NextFree != InvalidNode)
+    {
+        m_Nodes[n.NextFree].PrevFree = node;
+    }
+
+    m_FreeHead[cls] = node;
+    m_ClassMask |= (1u << cls);
+    m_FreeRangeCount++;
+}
+
+void RangeAllocator::RemoveFree(uint32_t node)
+{
+    auto& n = m_Nodes[node];
+    const auto cls = GetClass(n.Size);
+
+    if (n.PrevFree != InvalidNode)
+    {
+        m_Nodes[n.PrevFree].NextFree = n.NextFree;
+    }
+    else
+    {
+        m_FreeHead[cls] = n.NextFree;
+    }
+
+    if (n.NextFree != InvalidNode)
+    {
+        m_Nodes[n.NextFree].PrevFree = n.PrevFree;
+    }
+
+    if (m_FreeHead[cls] == InvalidNode)
+    {
+        m_ClassMask &= ~(1u << cls);
+    }
+
+    n.IsFree   = false;
+    n.PrevFree = InvalidNode;
+    n.NextFree = InvalidNode;
+    m_FreeRangeCount--;
+}
\ No newline at end of file
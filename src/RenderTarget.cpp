@@ -3,7 +3,8 @@
 
 RenderTarget::RenderTarget()
     : m_pTarget(nullptr)
-    , m_pHandleRTV(nullptr)
+    , m_pAllocator(nullptr)
+    , m_HandleRTVId()
     , m_pPoolRTV(nullptr)
 {
 }
@@ -16,32 +17,27 @@ RenderTarget::~RenderTarget()
 void RenderTarget::Init
 (
     ID3D12Device*   pDevice,
+    GpuAllocator*   pAllocator,
     DescriptorPool* pPoolRTV,
     uint32_t        width,
     uint32_t        height,
     DXGI_FORMAT     format
 )
 {
-    if (pDevice == nullptr || pPoolRTV == nullptr || width == 0 || height == 0)
+    if (pDevice == nullptr || pAllocator == nullptr || pPoolRTV == nullptr || width == 0 || height == 0)
         __debugbreak();
 
-    assert(m_pHandleRTV == nullptr);
+    assert(!m_HandleRTVId.IsValid());
     assert(m_pPoolRTV == nullptr);
 
     m_pPoolRTV = pPoolRTV;
     m_pPoolRTV->AddRef();
 
-    m_pHandleRTV = m_pPoolRTV->AllocHandle();
-    if (m_pHandleRTV == nullptr)
+    m_HandleRTVId = m_pPoolRTV->AllocId();
+    auto pHandle = m_pPoolRTV->GetHandle(m_HandleRTVId);
+    if (pHandle == nullptr)
         __debugbreak();
 
-    D3D12_HEAP_PROPERTIES prop = {};
-    prop.Type                 = D3D12_HEAP_TYPE_DEFAULT;
-    prop.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    prop.CreationNodeMask     = 1;
-    prop.VisibleNodeMask      = 1;
-
     D3D12_RESOURCE_DESC desc = {};
     desc.Dimension          = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
     desc.Alignment          = 0;
@@ -62,16 +58,18 @@ void RenderTarget::Init
     clearValue.Color[2] = 1.0f;
     clearValue.Color[3] = 1.0f;
 
-    auto hr = pDevice->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
+    auto hr = pAllocator->CreateResource(
+        D3D12_HEAP_TYPE_DEFAULT,
         &desc,
         D3D12_RESOURCE_STATE_RENDER_TARGET,
         &clearValue,
+        m_Allocation,
         IID_PPV_ARGS(m_pTarget.GetAddressOf()));
     if (FAILED(hr))
         __debugbreak();
 
+    m_pAllocator = pAllocator;
+
     m_ViewDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2D;
     m_ViewDesc.Format = format;
     m_ViewDesc.Texture2D.MipSlice = 0;
@@ -80,7 +78,7 @@ void RenderTarget::Init
     pDevice->CreateRenderTargetView(
         m_pTarget.Get(),
         &m_ViewDesc,
-        m_pHandleRTV->HandleCPU);
+        pHandle->HandleCPU);
 }
 
 void RenderTarget::InitFromBackBuffer
@@ -94,14 +92,15 @@ void RenderTarget::InitFromBackBuffer
     if (pDevice == nullptr || pPoolRTV == nullptr || pSwapChain == nullptr)
         __debugbreak();
 
-    assert(m_pHandleRTV == nullptr);
+    assert(!m_HandleRTVId.IsValid());
     assert(m_pPoolRTV == nullptr);
 
     m_pPoolRTV = pPoolRTV;
     m_pPoolRTV->AddRef();
 
-    m_pHandleRTV = m_pPoolRTV->AllocHandle();
-    if (m_pHandleRTV == nullptr)
+    m_HandleRTVId = m_pPoolRTV->AllocId();
+    auto pHandle = m_pPoolRTV->GetHandle(m_HandleRTVId);
+    if (pHandle == nullptr)
         __debugbreak();
 
     auto hr = pSwapChain->GetBuffer(index, IID_PPV_ARGS(m_pTarget.GetAddressOf()));
@@ -121,17 +120,22 @@ void RenderTarget::InitFromBackBuffer
     pDevice->CreateRenderTargetView(
         m_pTarget.Get(),
         &m_ViewDesc,
-        m_pHandleRTV->HandleCPU);
+        pHandle->HandleCPU);
 }
 
 void RenderTarget::Term()
 {
     m_pTarget.Reset();
 
-    if (m_pPoolRTV != nullptr && m_pHandleRTV != nullptr)
+    if (m_pAllocator != nullptr)
+    {
+        m_pAllocator->Free(m_Allocation);
+        m_pAllocator = nullptr;
+    }
+
+    if (m_pPoolRTV != nullptr && m_HandleRTVId.IsValid())
     {
-        m_pPoolRTV->FreeHandle(m_pHandleRTV);
-        m_pHandleRTV = nullptr;
+        m_pPoolRTV->FreeId(m_HandleRTVId);
     }
 
     if (m_pPoolRTV != nullptr)
@@ -143,7 +147,10 @@ void RenderTarget::Term()
 
 DescriptorHandle* RenderTarget::GetHandleRTV() const
 {
-    return m_pHandleRTV;
+    if (m_pPoolRTV == nullptr)
+        return nullptr;
+
+    return m_pPoolRTV->GetHandle(m_HandleRTVId);
 }
 
 ID3D12Resource* RenderTarget::GetResource() const
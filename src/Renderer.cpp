@@ -7,12 +7,23 @@
 #include <WinPixUtil.h>
 #include <FileUtil.h>
 #include <Logger.h>
+#include <MemoryUtil.h>
+#include <algorithm>
+#include <chrono>
 
 D3D_FEATURE_LEVEL IRenderer::FeatureLevel = D3D_FEATURE_LEVEL_12_0;
 DXGI_FORMAT IRenderer::BackBufferFormat   = DXGI_FORMAT_R8G8B8A8_UNORM;
 UINT IRenderer::Msaa4xQuality             = 0;
 DirectX::XMFLOAT3 IRenderer::EyePos = DirectX::XMFLOAT3(0.0f, 0.4f, -2.0f);
 
+namespace {
+    uint64_t GetElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+    {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+}
+
 Renderer::Renderer(HINSTANCE hInst, HWND hWnd, uint32_t width, uint32_t height)
     : m_hInst(hInst)
     , m_hWnd(hWnd)
@@ -20,13 +31,18 @@ Renderer::Renderer(HINSTANCE hInst, HWND hWnd, uint32_t width, uint32_t height)
     , m_Height(height)
     , m_pDevice(nullptr)
     , m_FrameIndex(0)
-    , m_CurrFrameResIndex(0)
     , m_RotateAngle(0.0f)
+    , m_Bindless(false)
+    , m_Version(0)
+    , m_MaterialVersion(0)
+    , m_CurrFrameResIndex(0)
+    , m_SyncInterval(1)
+    , m_RecordThreadCount(1)
 {
-    // ʼ  ʱȭ
+    // 필수적인 요소 초기화
     InitD3DComponent();
 
-    // ߰  ʱȭ
+    // 추가적인 요소 초기화
     InitD3DAsset();
 }
 
@@ -36,22 +52,23 @@ Renderer::~Renderer()
 
 bool Renderer::Load(const wchar_t* filePath)
 {
+    const auto start = std::chrono::steady_clock::now();
+
     std::wstring path = filePath;
     std::wstring dir = GetDirectoryPath(path.c_str());
 
-    std::vector<ResMesh>        resMesh;
     std::vector<ResMaterial>    resMaterial;
+    std::vector<Mesh*>          meshes;
 
-    if (!LoadMesh(path.c_str(), resMesh, resMaterial))
+    // Meshes are staged into one copy queue batch as they are parsed. The
+    // direct queue waits on it on the GPU, so nothing here blocks on the copy.
+    if (!m_GeometryBatch.Begin())
     {
-        ELOG("Error : Load Mesh Failed. filepath = %ls", path.c_str());
+        ELOG("Error : UploadBatch::Begin() Failed.");
         return false;
     }
 
-    m_pMesh.clear();
-    m_pMesh.reserve(resMesh.size());
-
-    for (size_t i = 0; i < resMesh.size(); ++i)
+    auto onMesh = [this, &meshes](size_t, ResMesh& resource)
     {
         auto mesh = new (std::nothrow) Mesh();
 
@@ -61,25 +78,54 @@ bool Renderer::Load(const wchar_t* filePath)
             return false;
         }
 
-        if (!mesh->Init(m_pDevice.Get(), m_pQueue.Get(), &m_CommandList, &m_Fence, resMesh[i]))
+        if (!mesh->Init(&m_Geometry, &m_GeometryBatch, resource))
         {
             ELOG("Error : Mesh Initialize Failed.");
             delete mesh;
             return false;
         }
 
-        m_pMesh.push_back(mesh);
+        meshes.push_back(mesh);
+        return true;
+    };
+
+    const bool loaded = LoadMesh(path.c_str(), onMesh, resMaterial, &m_Jobs);
+
+    m_GeometryBatch.End(m_pQueue.Get());
+
+    // The geometry copy is still running on the copy queue here.
+    const auto meshTime = GetElapsedMicroseconds(start);
+
+    // The scene loaded before stays in use until the meshes are in. The
+    // partial ones may be the target of the batch just submitted.
+    if (!loaded)
+    {
+        ELOG("Error : Load Mesh Failed. filepath = %ls", path.c_str());
+        RetireMeshes(meshes);
+        return false;
     }
 
+    // Frames in flight may still draw the previous scene, so its meshes and
+    // materials are released once they complete.
+    RetireMeshes(m_pMesh);
+    m_pMesh.swap(meshes);
     m_pMesh.shrink_to_fit();
 
+    m_Material.Retire(m_RetireQueue, m_Fence.GetNextValue());
+
     if (!m_Material.Init(
         m_pDevice.Get(),
+        &m_GpuAllocator,
         m_pPool[DescriptorPool::POOL_TYPE_RES],
         sizeof(MaterialBuffer),
         resMaterial.size()))
     {
+        // The previous materials are gone, so the render items of the
+        // previous scene are dropped along with the new meshes.
         ELOG("Error : Material::Init() Failed.");
+        m_Material.Term();
+        RetireMeshes(m_pMesh);
+        m_RenderItems.clear();
         return false;
     }
 
@@ -163,6 +209,10 @@ bool Renderer::Load(const wchar_t* filePath)
             //pShdConfig->SpecularMapUsable = 1;
         }
 
+        ptr->DiffuseMapIndex  = m_Material.GetTextureIndex(i, TU_DIFFUSE);
+        ptr->NormalMapIndex   = m_Material.GetTextureIndex(i, TU_NORMAL);
+        ptr->SpecularMapIndex = m_Material.GetTextureIndex(i, TU_SPECULAR);
+
         if(resMaterial[i].TextureData.DiffuseTex != nullptr)
             free(resMaterial[i].TextureData.DiffuseTex);
 
@@ -175,9 +225,20 @@ bool Renderer::Load(const wchar_t* filePath)
 
     auto future = batch.End(m_pQueue.Get());
     future.wait();
-    
+
+    m_MaterialVersion = ++m_Version;
+
     BuildRenderItems();
-    BuildFrameResources();
+
+    m_Stats.LoadTime     = GetElapsedMicroseconds(start);
+    m_Stats.LoadMeshTime = meshTime;
+
+    DLOG("Renderer : loaded %ls in %llu us (meshes %llu us, %zu meshes, %zu materials)",
+        path.c_str(),
+        (unsigned long long)m_Stats.LoadTime,
+        (unsigned long long)m_Stats.LoadMeshTime,
+        m_pMesh.size(),
+        resMaterial.size());
 
     return true;
 }
@@ -190,14 +251,16 @@ void Renderer::Resize(uint32_t width, uint32_t height)
     m_Width  = width;
     m_Height = height;
 
-    m_Fence.Sync(m_pQueue.Get());
+    // ResizeBuffers() requires the back buffers to be idle, so the last
+    // submitted frame is waited on. Nothing else needs the GPU to drain.
+    m_Fence.Wait(m_Fence.GetNextValue() - 1, INFINITE);
     //auto pCmd = m_CommandList.Reset();
 
     for(int i = 0; i < FrameCount; ++i)
         m_ColorTarget[i].Term(); 
-    m_DepthTarget.Term();
+    m_DepthTarget.Retire(m_RetireQueue, m_Fence.GetNextValue());
 
-    // swap chain 
+    // swap chain 조정
     auto hr = m_pSwapChain->ResizeBuffers(
         FrameCount,
         m_Width,
@@ -209,7 +272,7 @@ void Renderer::Resize(uint32_t width, uint32_t height)
 
     m_FrameIndex = 0;
 
-    // RTV, depth/stencil buffer 
+    // RTV, depth/stencil buffer 생성
     for (int i = 0; i < FrameCount; ++i)
     {
         m_ColorTarget[i].InitFromBackBuffer(
@@ -221,6 +284,7 @@ void Renderer::Resize(uint32_t width, uint32_t height)
 
     m_DepthTarget.Init(
         m_pDevice.Get(),
+        &m_GpuAllocator,
         m_pPool[DescriptorPool::POOL_TYPE_DSV],
         m_Width,
         m_Height,
@@ -233,7 +297,7 @@ void Renderer::Resize(uint32_t width, uint32_t height)
 
     //m_Fence.Sync(m_pQueue.Get());
 
-    // viewport, scissor ũ 
+    // viewport, scissor 크기 조정
     m_Viewport.TopLeftX = 0.0f;
     m_Viewport.TopLeftY = 0.0f;
     m_Viewport.Width    = float(m_Width);
@@ -253,9 +317,14 @@ void Renderer::Render()
     Draw();
 }
 
+void Renderer::SetFrameLatency(LATENCY_MODE mode, uint32_t framesInFlight)
+{
+    m_Latency.SetMode(mode, framesInFlight);
+}
+
 bool Renderer::InitD3DComponent()
 {
-    // WICTextureLoader  뵵
+    // WICTextureLoader 사용 용도
 #if (_WIN32_WINNT >= 0x0A00 /*_WIN32_WINNT_WIN10*/)
     Microsoft::WRL::Wrappers::RoInitializeWrapper initialize(RO_INIT_MULTITHREADED);
     if (FAILED(initialize))
@@ -266,10 +335,13 @@ bool Renderer::InitD3DComponent()
         __debugbreak(); 
 #endif
 
+    if (!m_Jobs.Init())
+        __debugbreak();
+
     HRESULT hr;
     
 #if defined(DEBUG) || defined(_DEBUG)
-    // debug layer Ȱȭ
+    // debug layer 활성화
     ComPtr<ID3D12Debug> pDebug;
     hr = D3D12GetDebugInterface(IID_PPV_ARGS(pDebug.GetAddressOf()));
     if (SUCCEEDED(hr))
@@ -277,12 +349,12 @@ bool Renderer::InitD3DComponent()
         pDebug->EnableDebugLayer();
     }
 
-    // PIX attach 뵵 
+    // PIX attach 용도 설정
     if (GetModuleHandle(L"WinPixGpuCapturer.dll") == 0)
         LoadLibrary(GetLatestWinPixGpuCapturerPath().c_str());
 #endif
 
-    // device 
+    // device 생성
     const D3D_FEATURE_LEVEL FeatureLevels[] =
     {
         D3D_FEATURE_LEVEL_10_0,
@@ -311,10 +383,13 @@ bool Renderer::InitD3DComponent()
     if (m_pDevice == nullptr)
         __debugbreak();
 
-    // fence 
+    if (!m_GpuAllocator.Init(m_pDevice.Get()))
+        __debugbreak();
+
+    // fence 생성
     m_Fence.Init(m_pDevice.Get());
 
-    // command queue 
+    // command queue 생성
     D3D12_COMMAND_QUEUE_DESC cmdQueueDesc = {};
     cmdQueueDesc.Type     = D3D12_COMMAND_LIST_TYPE_DIRECT;
     cmdQueueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
@@ -325,13 +400,19 @@ bool Renderer::InitD3DComponent()
     if (FAILED(hr))
         __debugbreak();
 
-    // command list, command allocator  ( )
+    if (!m_GeometryBatch.Init(m_pDevice.Get()))
+        __debugbreak();
+
+    if (!m_Geometry.Init(&m_GpuAllocator, sizeof(MeshVertex)))
+        __debugbreak();
+
+    // command list, command allocator 생성 (제거 예정)
     m_CommandList.Init(
         m_pDevice.Get(), 
         D3D12_COMMAND_LIST_TYPE_DIRECT, 
         FrameCount);
 
-    // command allocator, command list 
+    // command allocator, command list 생성
     hr = m_pDevice->CreateCommandAllocator(
         D3D12_COMMAND_LIST_TYPE_DIRECT,
         IID_PPV_ARGS(m_pDirCmdAllocator.GetAddressOf()));
@@ -349,7 +430,34 @@ bool Renderer::InitD3DComponent()
 
     m_pCmdList->Close();
 
-    // 4X MSAA ǰ   
+    hr = m_pDevice->CreateCommandList(
+        1,
+        D3D12_COMMAND_LIST_TYPE_DIRECT,
+        m_pDirCmdAllocator.Get(),
+        nullptr,
+        IID_PPV_ARGS(m_pEndCmdList.GetAddressOf()));
+    if (FAILED(hr))
+        __debugbreak();
+
+    m_pEndCmdList->Close();
+
+    m_RecordThreadCount = std::min(m_Jobs.GetThreadCount(), uint32_t(MaxRecordThreads));
+    m_pRecordCmdLists.resize(m_RecordThreadCount);
+    for (auto& pCmdList : m_pRecordCmdLists)
+    {
+        hr = m_pDevice->CreateCommandList(
+            1,
+            D3D12_COMMAND_LIST_TYPE_DIRECT,
+            m_pDirCmdAllocator.Get(),
+            nullptr,
+            IID_PPV_ARGS(pCmdList.GetAddressOf()));
+        if (FAILED(hr))
+            __debugbreak();
+
+        pCmdList->Close();
+    }
+
+    // 4X MSAA 품질 수준 지원 점검
     D3D12_FEATURE_DATA_MULTISAMPLE_QUALITY_LEVELS msQualityLevels;
     msQualityLevels.Format           = BackBufferFormat;
     msQualityLevels.SampleCount      = 4;
@@ -366,17 +474,21 @@ bool Renderer::InitD3DComponent()
     Msaa4xQuality = msQualityLevels.NumQualityLevels;
     assert(Msaa4xQuality > 0 && "Unexpected MSAA quality level.");
 
-    // ü 
+    // 스왑체인 생성
     CreateSwapChain();
 
-    // ũ  
+    // 디스크립터 힙 생성
     D3D12_DESCRIPTOR_HEAP_DESC dhDesc = {};
 
     dhDesc.NodeMask       = 1;
     dhDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
     dhDesc.NumDescriptors = 512;
     dhDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    DescriptorPool::Create(m_pDevice.Get(), &dhDesc, &m_pPool[DescriptorPool::POOL_TYPE_RES]);
+    DescriptorPool::Create(
+        m_pDevice.Get(),
+        &dhDesc,
+        &m_pPool[DescriptorPool::POOL_TYPE_RES],
+        DescriptorPool::ALLOC_MODE_LOCK_FREE);
 
     dhDesc.Type           = D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER;
     dhDesc.NumDescriptors = 256;
@@ -393,7 +505,21 @@ bool Renderer::InitD3DComponent()
     dhDesc.Flags          = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
     DescriptorPool::Create(m_pDevice.Get(), &dhDesc, &m_pPool[DescriptorPool::POOL_TYPE_DSV]);
 
-    // RTV 
+    if (!m_DescriptorRing.Init(
+        m_pPool[DescriptorPool::POOL_TYPE_RES],
+        TransientDescriptorCount,
+        FrameResourceCount))
+        __debugbreak();
+
+    if (!m_UploadRing.Init(m_pDevice.Get(), UploadRingSize, FrameResourceCount))
+        __debugbreak();
+
+    // The rings keep a partition for every frame resource, so the depth can
+    // change at run time without reallocating them.
+    if (!m_Latency.Init(FrameResourceCount, LATENCY_MODE_FIXED, FrameResourceCount))
+        __debugbreak();
+
+    // RTV 생성
     for (int i = 0; i < FrameCount; ++i)
     {
         m_ColorTarget[i].InitFromBackBuffer(
@@ -405,6 +531,7 @@ bool Renderer::InitD3DComponent()
 
     m_DepthTarget.Init(
         m_pDevice.Get(),
+        &m_GpuAllocator,
         m_pPool[DescriptorPool::POOL_TYPE_DSV],
         m_Width,
         m_Height,
@@ -427,67 +554,69 @@ bool Renderer::InitD3DComponent()
 
 bool Renderer::InitD3DAsset()
 {
-    // root signature 
+    // An unbounded SRV range needs resource binding tier 2.
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options = {};
+        auto hr = m_pDevice->CheckFeatureSupport(
+            D3D12_FEATURE_D3D12_OPTIONS,
+            &options,
+            sizeof(options));
+
+        m_Bindless = SUCCEEDED(hr)
+            && options.ResourceBindingTier >= D3D12_RESOURCE_BINDING_TIER_2;
+    }
+
+    // root signature 생성
     {
         auto flag = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
         flag |= D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS;
         flag |= D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS;
         flag |= D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
 
-        D3D12_DESCRIPTOR_RANGE range[3] = {};
-        range[0].RangeType                         = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-        range[0].NumDescriptors                    = 1;
-        range[0].BaseShaderRegister                = 0;
-        range[0].RegisterSpace                     = 0;
-        range[0].OffsetInDescriptorsFromTableStart = 0;
-
-        range[1].RangeType                         = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-        range[1].NumDescriptors                    = 1;
-        range[1].BaseShaderRegister                = 1;
-        range[1].RegisterSpace                     = 0;
-        range[1].OffsetInDescriptorsFromTableStart = 0;
-
-        range[2].RangeType                         = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-        range[2].NumDescriptors                    = 1;
-        range[2].BaseShaderRegister                = 2;
-        range[2].RegisterSpace                     = 0;
-        range[2].OffsetInDescriptorsFromTableStart = 0;
-
-        D3D12_ROOT_PARAMETER param[7] = {};
-        param[0].ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
-        param[0].Descriptor.ShaderRegister = 0;
-        param[0].Descriptor.RegisterSpace  = 0;
-        param[0].ShaderVisibility          = D3D12_SHADER_VISIBILITY_VERTEX;
+        // Textures live in space1: either the whole resource heap as one
+        // unbounded range (bindless), or the material's t0 diffuse, t1 normal,
+        // t2 specular table.
+        D3D12_DESCRIPTOR_RANGE range = {};
+        range.RangeType                         = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        range.NumDescriptors                    = m_Bindless ? UINT_MAX : Material::TextureTableSize;
+        range.BaseShaderRegister                = 0;
+        range.RegisterSpace                     = 1;
+        range.OffsetInDescriptorsFromTableStart = 0;
+
+        // t0 objects, t1 materials, t2 instances: one table rebuilt in the
+        // descriptor ring every frame, as the buffers change per frame.
+        D3D12_DESCRIPTOR_RANGE bufferRange = {};
+        bufferRange.RangeType                         = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+        bufferRange.NumDescriptors                    = BufferTableSize;
+        bufferRange.BaseShaderRegister                = 0;
+        bufferRange.RegisterSpace                     = 0;
+        bufferRange.OffsetInDescriptorsFromTableStart = 0;
+
+        // b0 FirstInstance, b1 pass constants, the buffer table and the
+        // texture table. Per-object data is indexed with
+        // Instances[FirstInstance + SV_InstanceID], so a draw only sets
+        // FirstInstance (plus the texture table without bindless).
+        D3D12_ROOT_PARAMETER param[4] = {};
+        param[0].ParameterType            = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+        param[0].Constants.ShaderRegister = 0;
+        param[0].Constants.RegisterSpace  = 0;
+        param[0].Constants.Num32BitValues = 1;
+        param[0].ShaderVisibility         = D3D12_SHADER_VISIBILITY_VERTEX;
 
         param[1].ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
         param[1].Descriptor.ShaderRegister = 1;
         param[1].Descriptor.RegisterSpace  = 0;
-        param[1].ShaderVisibility          = D3D12_SHADER_VISIBILITY_PIXEL;
+        param[1].ShaderVisibility          = D3D12_SHADER_VISIBILITY_ALL;
 
-        param[2].ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
-        param[2].Descriptor.ShaderRegister = 2;
-        param[2].Descriptor.RegisterSpace  = 0;
-        param[2].ShaderVisibility          = D3D12_SHADER_VISIBILITY_PIXEL;
+        param[2].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        param[2].DescriptorTable.NumDescriptorRanges = 1;
+        param[2].DescriptorTable.pDescriptorRanges   = &bufferRange;
+        param[2].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_ALL;
 
-        param[3].ParameterType             = D3D12_ROOT_PARAMETER_TYPE_CBV;
-        param[3].Descriptor.ShaderRegister = 3;
-        param[3].Descriptor.RegisterSpace  = 0;
-        param[3].ShaderVisibility          = D3D12_SHADER_VISIBILITY_PIXEL;
-
-        param[4].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-        param[4].DescriptorTable.NumDescriptorRanges = 1;
-        param[4].DescriptorTable.pDescriptorRanges   = &range[0];
-        param[4].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_PIXEL;
-
-        param[5].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-        param[5].DescriptorTable.NumDescriptorRanges = 1;
-        param[5].DescriptorTable.pDescriptorRanges   = &range[1];
-        param[5].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_PIXEL;
-
-        param[6].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-        param[6].DescriptorTable.NumDescriptorRanges = 1;
-        param[6].DescriptorTable.pDescriptorRanges   = &range[2];
-        param[6].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_PIXEL;
+        param[3].ParameterType                       = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+        param[3].DescriptorTable.NumDescriptorRanges = 1;
+        param[3].DescriptorTable.pDescriptorRanges   = &range;
+        param[3].ShaderVisibility                    = D3D12_SHADER_VISIBILITY_PIXEL;
 
         D3D12_STATIC_SAMPLER_DESC sampler = {};
         sampler.Filter           = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
@@ -536,13 +665,15 @@ bool Renderer::InitD3DAsset()
         }
     }
 
-    // pipeline state 
+    // pipeline state 생성
     {
         std::wstring vsPath;
         std::wstring psPath;
 
         vsPath = L"bin/CMake/Debug/SimpleVS.cso";
-        psPath = L"bin/CMake/Debug/SimplePS.cso";
+        psPath = m_Bindless
+            ? L"bin/CMake/Debug/SimplePS_Bindless.cso"
+            : L"bin/CMake/Debug/SimplePS.cso";
 
         ComPtr<ID3DBlob> pVSBlob;
         ComPtr<ID3DBlob> pPSBlob;
@@ -583,6 +714,18 @@ bool Renderer::InitD3DAsset()
             ELOG("Error : ID3D12Device::CreateGraphicsPipelineState() Failed. retcode = 0x%x", hr);
             return false;
         }
+
+        // Blend pass: the shader outputs straight alpha. Blended items are
+        // depth tested against the opaque ones but do not write depth.
+        desc.BlendState                       = DirectX::CommonStates::NonPremultiplied;
+        desc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+
+        hr = m_pDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(m_pBlendPSO.GetAddressOf()));
+        if (FAILED(hr))
+        {
+            ELOG("Error : ID3D12Device::CreateGraphicsPipelineState() Failed. retcode = 0x%x", hr);
+            return false;
+        }
     }
     
     auto eyePos    = DirectX::XMVectorSet(EyePos.x, EyePos.y, EyePos.z, 0.0f);
@@ -619,14 +762,30 @@ bool Renderer::InitD3DAsset()
 void Renderer::TermD3D()
 {
     m_Fence.Sync(m_pQueue.Get());
+    m_RetireQueue.Flush();
     m_Fence.Term();
 
+    m_DescriptorRing.Term();
+    m_UploadRing.Term();
+    m_Latency.Term();
+
+    for (auto pFrameRes : m_FrameResources)
+    {
+        delete pFrameRes;
+    }
+    m_FrameResources.clear();
+    m_CurrFrameRes = nullptr;
+
     for (int i = 0u; i < FrameCount; ++i)
     {
         m_ColorTarget[i].Term();
     }
 
     m_DepthTarget.Term();
+    ReleaseMeshes();
+    m_Geometry.Term();
+    m_GeometryBatch.Term();
+    m_Material.Term();
     m_CommandList.Term();
 
     for (int i = 0; i < DescriptorPool::POOL_COUNT; ++i)
@@ -638,9 +797,14 @@ void Renderer::TermD3D()
         }
     }
 
+    // Every placed resource has been released above.
+    m_GpuAllocator.Term();
+
     m_pSwapChain.Reset();
     m_pQueue.Reset();
     m_pDevice.Reset();
+
+    m_Jobs.Term();
 }
 
 void Renderer::CreateSwapChain()
@@ -687,15 +851,35 @@ void Renderer::CreateSwapChain()
     pSwapChain.Reset();
 }
 
-void Renderer::BuildRenderItems()
+void Renderer::ReleaseMeshes()
 {
-    auto eyePos    = DirectX::XMLoadFloat3(&EyePos);
-    auto targetPos = DirectX::XMVectorSet(0.0f, 0.4f, 0.0f, 0.0f);
-    auto upward    = DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+    for (auto pMesh : m_pMesh)
+    {
+        delete pMesh;
+    }
+    m_pMesh.clear();
+}
 
-    constexpr auto fovY = DirectX::XMConvertToRadians(37.5f);
-    auto aspect = static_cast<float>(m_Width) / static_cast<float>(m_Height);
+void Renderer::RetireMeshes(std::vector<Mesh*>& meshes)
+{
+    if (meshes.empty())
+        return;
 
+    // Frames in flight may still draw these; their geometry ranges are
+    // returned once the work submitted so far completes.
+    m_RetireQueue.Enqueue(m_Fence.GetNextValue(), [retired = std::move(meshes)]()
+    {
+        for (auto pMesh : retired)
+        {
+            delete pMesh;
+        }
+    });
+
+    meshes.clear();
+}
+
+void Renderer::BuildRenderItems()
+{
     const DirectX::XMMATRIX S1 = DirectX::XMMatrixScaling(Mesh::Scale, Mesh::Scale, Mesh::Scale);
     //const DirectX::XMMATRIX R = DirectX::XMMatrixRotationY(m_RotateAngle);
 
@@ -703,127 +887,435 @@ void Renderer::BuildRenderItems()
     const DirectX::XMVECTOR dirLightDir = DirectX::XMLoadFloat3(&Light.DirLight.Direction);
     const DirectX::XMMATRIX S2 = DirectX::XMMatrixShadow(shadowPlane, dirLightDir);
 
+    m_RenderItems.clear();
+
+    const auto version = ++m_Version;
     int dataIdx = 0;
 
     // mesh
     for (int i = 0; i < m_pMesh.size(); ++i)
     {
+        const auto pMaterial = m_Material.GetBufferPtr<MaterialBuffer>(m_pMesh[i]->GetMaterialId());
+
         RenderItem rItem;
         rItem.IsShadow = false;
+        rItem.Pass     = GetRenderPass(pMaterial->Alpha);
         rItem.MeshIdx  = i;
         rItem.DataIdx  = dataIdx++;
-        rItem.Transform.World = S1;
-        rItem.Transform.View  = DirectX::XMMatrixLookAtRH(eyePos, targetPos, upward);
-        rItem.Transform.Proj  = DirectX::XMMatrixPerspectiveFovRH(fovY, aspect, 1.0f, 1000.0f);
+        rItem.Object.World = S1;
+        rItem.Version[RENDER_ITEM_FIELD_WORLD]    = version;
+        rItem.Version[RENDER_ITEM_FIELD_MATERIAL] = version;
         m_RenderItems.push_back(rItem);
     }
 
-    // shadow
+    // shadow; flattened onto the ground plane and drawn opaque
     for (int i = 0; i < m_pMesh.size(); ++i)
     {
         RenderItem rItem;
         rItem.IsShadow = true;
+        rItem.Pass     = RENDER_PASS_OPAQUE;
         rItem.MeshIdx  = i;
         rItem.DataIdx  = dataIdx++;
-        rItem.Transform.World = S1 * S2;
-        rItem.Transform.View  = DirectX::XMMatrixLookAtRH(eyePos, targetPos, upward);
-        rItem.Transform.Proj  = DirectX::XMMatrixPerspectiveFovRH(fovY, aspect, 1.0f, 1000.0f);
+        rItem.Object.World = S1 * S2;
+        rItem.Version[RENDER_ITEM_FIELD_WORLD]    = version;
+        rItem.Version[RENDER_ITEM_FIELD_MATERIAL] = version;
         m_RenderItems.push_back(rItem);
     }
 }
 
 void Renderer::BuildFrameResources()
 {
+    // 이전 프레임 리소스의 커맨드 할당자는 GPU가 사용 중일 수 있음
+    // Each one is deleted once the last frame that used it completes.
+    for (auto pFrameRes : m_FrameResources)
+    {
+        m_RetireQueue.Enqueue(pFrameRes->Fence, [pFrameRes]() { delete pFrameRes; });
+    }
     m_FrameResources.clear();
+    m_CurrFrameRes = nullptr;
+
     for (int i = 0; i < FrameResourceCount; ++i)
     {
         FrameResource* res = new FrameResource(
             m_pDevice.Get(),
-            m_pPool,
             D3D12_COMMAND_LIST_TYPE_DIRECT,
-            m_RenderItems.size() == 0 ? 1 : m_RenderItems.size());
+            m_RecordThreadCount);
         m_FrameResources.push_back(res);
     }
 }
 
 void Renderer::Update()
 {
-    m_CurrFrameResIndex = (m_CurrFrameResIndex + 1) % FrameResourceCount;
+    // Only the first GetDepth() frame resources are cycled. Waiting on the
+    // one reused here bounds how far the CPU runs ahead of the GPU.
+    m_CurrFrameResIndex = (m_CurrFrameResIndex + 1) % int(m_Latency.GetDepth());
     m_CurrFrameRes = m_FrameResources[m_CurrFrameResIndex];
 
-    m_Fence.Wait(m_CurrFrameRes->Fence, INFINITE);
+    m_Stats.CpuWait = m_Fence.Wait(m_CurrFrameRes->Fence, INFINITE);
+    m_Latency.OnWait(m_Stats.CpuWait);
+    m_RetireQueue.Collect(m_Fence.GetCompletedValue());
+
+    // The wait above retired this frame's partition of the upload ring.
+    if (!m_UploadRing.BeginFrame(m_CurrFrameResIndex, m_Fence.GetCompletedValue()))
+        ELOG("Error : UploadRing::BeginFrame() Failed.");
+
+    m_Version++;
+    m_Stats.UploadBytes = 0;
 
-    for (int i = 0; i < m_RenderItems.size(); ++i)
+    const auto heapStats = m_GpuAllocator.GetTotalStats();
+    m_Stats.HeapBudget        = m_GpuAllocator.GetBudget();
+    m_Stats.HeapReserved      = heapStats.ReservedBytes;
+    m_Stats.HeapUsed          = heapStats.UsedBytes;
+    m_Stats.HeapFragmentation = heapStats.GetFragmentation();
+
+    const DirectX::XMMATRIX S1 = DirectX::XMMatrixScaling(Mesh::Scale, Mesh::Scale, Mesh::Scale);
+    const DirectX::XMMATRIX R = DirectX::XMMatrixRotationY(m_RotateAngle);
+
+    m_Culler.Resize(uint32_t(m_RenderItems.size()));
+
+    // Items only write to themselves, so they are updated in parallel.
+    m_Jobs.ParallelFor(uint32_t(m_RenderItems.size()), UpdateGrainSize, [&](uint32_t begin, uint32_t end)
     {
-        auto& rItem = m_RenderItems[i];
-        //rItem.Transform = Transform;
+        for (auto i = begin; i < end; ++i)
+        {
+            auto& rItem = m_RenderItems[i];
+            //rItem.Transform = Transform;
+
+            DirectX::XMMATRIX world;
+            if (!rItem.IsShadow)
+            {
+                world = S1 * R;
+            }
+            else
+            {
+                const DirectX::XMVECTOR shadowPlane = DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+                const DirectX::XMVECTOR dirLightDir = DirectX::XMLoadFloat3(&Light.DirLight.Direction);
+                const DirectX::XMMATRIX S2 = DirectX::XMMatrixShadow(shadowPlane, dirLightDir);
+                world = S1 * S2 * R;
+            }
+
+            if (memcmp(&rItem.Object.World, &world, sizeof(world)) != 0)
+            {
+                rItem.Object.World = world;
+                rItem.Version[RENDER_ITEM_FIELD_WORLD] = m_Version;
+            }
+
+            m_Culler.SetBox(i, m_pMesh[rItem.MeshIdx]->GetBounds(), world);
+
+            const uint32_t materialIndex = m_pMesh[rItem.MeshIdx]->GetMaterialId();
+            const uint32_t flags         = rItem.IsShadow ? OBJECT_FLAG_SHADOW : OBJECT_FLAG_NONE;
+            if (rItem.Object.MaterialIndex != materialIndex || rItem.Object.Flags != flags)
+            {
+                rItem.Object.MaterialIndex = materialIndex;
+                rItem.Object.Flags         = flags;
+                rItem.Version[RENDER_ITEM_FIELD_MATERIAL] = m_Version;
+            }
+        }
+    });
 
-        const DirectX::XMMATRIX S1 = DirectX::XMMatrixScaling(Mesh::Scale, Mesh::Scale, Mesh::Scale);
-        const DirectX::XMMATRIX R = DirectX::XMMatrixRotationY(m_RotateAngle);
+    m_RotateAngle += 0.010f;
 
-        if (!rItem.IsShadow)
+    CullRenderItems();
+    SortRenderItems();
+    BuildDrawBatches();
+    UpdateObject();
+    UpdateMaterial();
+    UpdatePass();
+}
+
+void Renderer::UpdateObject()
+{
+    auto& buffer = m_CurrFrameRes->Object;
+
+    const auto size = UINT64(sizeof(ObjectBuffer) * m_RenderItems.size());
+    if (size == 0)
+        return;
+
+    // The fence wait in Update() means the GPU is done with this buffer.
+    if (buffer.GetSize() < size)
+    {
+        if (!buffer.Init(m_pDevice.Get(), size))
         {
-            rItem.Transform.World = S1 * R;
+            ELOG("Error : UploadBuffer::Init() Failed.");
+            return;
         }
-        else
+
+        m_CurrFrameRes->ObjectVersion = 0;
+    }
+
+    // Only fields changed since this frame resource was last used are copied.
+    const auto synced = m_CurrFrameRes->ObjectVersion;
+    auto pDst = buffer.GetPtr<ObjectBuffer>();
+    for (const auto& rItem : m_RenderItems)
+    {
+        auto& dst = pDst[rItem.DataIdx];
+
+        if (rItem.Version[RENDER_ITEM_FIELD_WORLD] > synced)
         {
-            const DirectX::XMVECTOR shadowPlane = DirectX::XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-            const DirectX::XMVECTOR dirLightDir = DirectX::XMLoadFloat3(&Light.DirLight.Direction);
-            const DirectX::XMMATRIX S2 = DirectX::XMMatrixShadow(shadowPlane, dirLightDir);
-            rItem.Transform.World = S1 * S2 * R;
+            StreamCopy(&dst.World, &rItem.Object.World, sizeof(dst.World));
+            m_Stats.UploadBytes += sizeof(dst.World);
         }
 
-        rItem.Light     = rItem.IsShadow ? rItem.Light : Light;
-        rItem.Material  = *(m_Material.GetBufferPtr<MaterialBuffer>(rItem.MeshIdx));
-        rItem.Pass      = Pass;
+        if (rItem.Version[RENDER_ITEM_FIELD_MATERIAL] > synced)
+        {
+            dst.MaterialIndex = rItem.Object.MaterialIndex;
+            dst.Flags         = rItem.Object.Flags;
+            m_Stats.UploadBytes += sizeof(dst.MaterialIndex) + sizeof(dst.Flags);
+        }
     }
 
-    m_RotateAngle += 0.010f;
+    m_CurrFrameRes->ObjectVersion = m_Version;
+}
 
-    UpdateTransform();
-    UpdateLight();
-    UpdateMaterial();
-    UpdatePass();
+void Renderer::UpdateMaterial()
+{
+    auto& buffer = m_CurrFrameRes->Material;
+
+    // Once per material rather than once per item.
+    const auto count = m_Material.GetCount();
+    const auto size  = UINT64(sizeof(MaterialBuffer) * count);
+    if (size == 0)
+        return;
+
+    if (buffer.GetSize() < size)
+    {
+        if (!buffer.Init(m_pDevice.Get(), size))
+        {
+            ELOG("Error : UploadBuffer::Init() Failed.");
+            return;
+        }
+
+        m_CurrFrameRes->MaterialVersion = 0;
+    }
+
+    if (m_MaterialVersion <= m_CurrFrameRes->MaterialVersion)
+        return;
+
+    auto pDst = buffer.GetPtr<MaterialBuffer>();
+    for (size_t i = 0; i < count; ++i)
+    {
+        pDst[i] = *m_Material.GetBufferPtr<MaterialBuffer>(i);
+    }
+
+    m_Stats.UploadBytes += size;
+    m_CurrFrameRes->MaterialVersion = m_Version;
 }
 
-void Renderer::UpdateTransform()
+void Renderer::UpdatePass()
 {
-    for (int i = 0; i < m_RenderItems.size(); ++i)
+    m_CurrFrameRes->Pass = 0;
+
+    Pass.ViewProj = DirectX::XMMatrixMultiply(Transform.View, Transform.Proj);
+    Pass.Lights   = Light;
+
+    UploadRing::Allocation allocation;
+    if (!m_UploadRing.Alloc(sizeof(PassConstant), allocation))
+        return;
+
+    StreamCopy(allocation.pCPU, &Pass, sizeof(PassConstant));
+    m_CurrFrameRes->Pass = allocation.Address;
+    m_Stats.UploadBytes += sizeof(PassConstant);
+}
+
+void Renderer::CullRenderItems()
+{
+    const auto count = uint32_t(m_RenderItems.size());
+
+    m_Culler.SetFrustum(DirectX::XMMatrixMultiply(Transform.View, Transform.Proj));
+    m_VisibleItems.resize(count);
+
+    // Each chunk writes its visible indices from its own begin, then the
+    // chunks are packed together in order.
+    const auto chunkCount = (count + CullGrainSize - 1) / CullGrainSize;
+    std::vector<uint32_t> visibleCounts(chunkCount);
+
+    m_Jobs.ParallelFor(count, CullGrainSize, [&](uint32_t begin, uint32_t end)
+    {
+        visibleCounts[begin / CullGrainSize] = m_Culler.Cull(begin, end, &m_VisibleItems[begin]);
+    });
+
+    uint32_t visible = 0;
+    for (uint32_t i = 0; i < chunkCount; ++i)
     {
-        const auto& rItem = m_RenderItems[i];
-        m_CurrFrameRes->Transform.CopyData(rItem.DataIdx, rItem.Transform);
+        const auto begin = i * CullGrainSize;
+        if (begin != visible)
+        {
+            memmove(&m_VisibleItems[visible], &m_VisibleItems[begin], sizeof(uint32_t) * visibleCounts[i]);
+        }
+        visible += visibleCounts[i];
     }
+
+    m_VisibleItems.resize(visible);
+
+    m_Stats.VisibleItems = visible;
+    m_Stats.CulledItems  = count - visible;
+}
+
+void Renderer::SortRenderItems()
+{
+    const auto count = uint32_t(m_VisibleItems.size());
+    m_SortKeys.resize(count);
+
+    // Depth is the distance of the item's world box center along the view
+    // direction. The view is right-handed and looks down -z, so it is the
+    // negated view space z. The PSO follows the pass, which leads the key, so
+    // the PSO field is left 0.
+    const DirectX::XMMATRIX view = Transform.View;
+    m_Jobs.ParallelFor(count, CullGrainSize, [&](uint32_t begin, uint32_t end)
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto  index   = m_VisibleItems[i];
+            const auto& rItem   = m_RenderItems[index];
+            const auto  center  = m_Culler.GetCenter(index);
+            const auto  viewPos = DirectX::XMVector3Transform(DirectX::XMLoadFloat3(&center), view);
+
+            m_SortKeys[i] = MakeSortKey(
+                rItem.Pass,
+                0,
+                m_pMesh[rItem.MeshIdx]->GetMaterialId(),
+                uint32_t(rItem.MeshIdx),
+                -DirectX::XMVectorGetZ(viewPos));
+        }
+    });
+
+    m_Sorter.Sort(m_SortKeys, m_VisibleItems);
 }
 
-void Renderer::UpdateLight()
+void Renderer::BuildDrawBatches()
 {
-    for (int i = 0; i < m_RenderItems.size(); ++i)
+    m_Batches.clear();
+    m_CurrFrameRes->pInstanceBuffer = nullptr;
+    m_CurrFrameRes->InstanceCount   = 0;
+
+    const auto count = uint32_t(m_VisibleItems.size());
+    if (count == 0)
+        return;
+
+    // The keys hold material and mesh above depth, so opaque items sharing a
+    // mesh end up next to each other. Blended items are only merged when they
+    // already are, which keeps them back to front.
+    UploadRing::Allocation allocation;
+    if (!m_UploadRing.Alloc(sizeof(uint32_t) * count, allocation))
     {
-        const auto& rItem = m_RenderItems[i];
-        m_CurrFrameRes->Light.CopyData(rItem.DataIdx, rItem.Light);
+        ELOG("Error : UploadRing::Alloc() Failed. instances = %u", count);
+        return;
     }
+
+    // Written front to back only, as the upload heap is write-combined.
+    auto pInstances = static_cast<uint32_t*>(allocation.pCPU);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const auto& rItem = m_RenderItems[m_VisibleItems[i]];
+        pInstances[i] = uint32_t(rItem.DataIdx);
+
+        if (m_Batches.empty()
+         || m_Batches.back().MeshIdx != rItem.MeshIdx
+         || m_Batches.back().Pass    != rItem.Pass)
+        {
+            DrawBatch batch = {};
+            batch.Pass          = rItem.Pass;
+            batch.MeshIdx       = rItem.MeshIdx;
+            batch.FirstInstance = i;
+            m_Batches.push_back(batch);
+        }
+
+        m_Batches.back().InstanceCount++;
+    }
+
+    m_CurrFrameRes->pInstanceBuffer = allocation.pResource;
+    m_CurrFrameRes->InstanceOffset  = allocation.Offset;
+    m_CurrFrameRes->InstanceCount   = count;
+    m_Stats.UploadBytes += sizeof(uint32_t) * count;
 }
 
-void Renderer::UpdateMaterial()
+void Renderer::CommitDescriptors()
 {
-    for (int i = 0; i < m_RenderItems.size(); ++i)
+    // Tables dropped here may still be read by frames up to the one about to
+    // be recorded, which signals GetNextValue(). Bindless draws index the heap
+    // and need no tables.
+    if (!m_Bindless)
+        m_Material.CommitTextureTables(m_Fence.GetNextValue(), m_Fence.GetCompletedValue());
+
+    const DescriptorPool::POOL_TYPE types[] = {
+        DescriptorPool::POOL_TYPE_RES,
+        DescriptorPool::POOL_TYPE_SMP
+    };
+
+    for (auto type : types)
     {
-        const auto& rItem = m_RenderItems[i];
-        m_CurrFrameRes->Material.CopyData(rItem.DataIdx, rItem.Material);
+        auto pPool = m_pPool[type];
+
+        // Pages outgrew the shader-visible heap. The heap grows in power-of-two
+        // steps, so this happens O(log n) times over the pool's life. The old
+        // heap is retired until the frames in flight complete.
+        if (pPool->NeedsRehome())
+        {
+            if (!pPool->Rehome(0, &m_RetireQueue, m_Fence.GetNextValue()))
+                ELOG("Error : DescriptorPool::Rehome() Failed.");
+        }
+
+        pPool->Commit();
     }
 }
 
-void Renderer::UpdatePass()
+void Renderer::BuildBufferTable()
 {
-    for (int i = 0; i < m_RenderItems.size(); ++i)
+    m_CurrFrameRes->BufferTable = D3D12_GPU_DESCRIPTOR_HANDLE();
+
+    // Nothing is drawn without visible items.
+    if (m_CurrFrameRes->pInstanceBuffer == nullptr)
+        return;
+
+    D3D12_CPU_DESCRIPTOR_HANDLE handleCPU;
+    D3D12_GPU_DESCRIPTOR_HANDLE handleGPU;
+    if (!m_DescriptorRing.Alloc(BufferTableSize, handleCPU, handleGPU))
     {
-        const auto& rItem = m_RenderItems[i];
-        m_CurrFrameRes->Pass.CopyData(rItem.DataIdx, rItem.Pass);
+        ELOG("Error : DescriptorRing::Alloc() Failed.");
+        return;
     }
+
+    const auto descriptorSize = m_pPool[DescriptorPool::POOL_TYPE_RES]->GetDescriptorSize();
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
+    desc.Format                  = DXGI_FORMAT_UNKNOWN;
+    desc.ViewDimension           = D3D12_SRV_DIMENSION_BUFFER;
+    desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    desc.Buffer.Flags            = D3D12_BUFFER_SRV_FLAG_NONE;
+
+    // The views go straight into the shader-visible heap; they only have to
+    // last until this frame's fence value completes.
+    desc.Buffer.FirstElement        = 0;
+    desc.Buffer.NumElements         = UINT(m_RenderItems.size());
+    desc.Buffer.StructureByteStride = sizeof(ObjectBuffer);
+    m_pDevice->CreateShaderResourceView(m_CurrFrameRes->Object.GetResource(), &desc, handleCPU);
+
+    handleCPU.ptr += descriptorSize;
+    desc.Buffer.NumElements         = std::max(UINT(m_Material.GetCount()), 1u);
+    desc.Buffer.StructureByteStride = sizeof(MaterialBuffer);
+    m_pDevice->CreateShaderResourceView(m_CurrFrameRes->Material.GetResource(), &desc, handleCPU);
+
+    handleCPU.ptr += descriptorSize;
+    desc.Buffer.FirstElement        = m_CurrFrameRes->InstanceOffset / sizeof(uint32_t);
+    desc.Buffer.NumElements         = m_CurrFrameRes->InstanceCount;
+    desc.Buffer.StructureByteStride = sizeof(uint32_t);
+    m_pDevice->CreateShaderResourceView(m_CurrFrameRes->pInstanceBuffer, &desc, handleCPU);
+
+    m_CurrFrameRes->BufferTable = handleGPU;
 }
 
 void Renderer::Draw()
 {
+    CommitDescriptors();
+
+    // Update() has already waited on this frame resource's fence, so its
+    // partition of the ring is retired. Begun after CommitDescriptors(), as
+    // a rehome moves the ring inside the shader-visible heap.
+    if (!m_DescriptorRing.BeginFrame(m_CurrFrameResIndex, m_Fence.GetCompletedValue()))
+        ELOG("Error : DescriptorRing::BeginFrame() Failed.");
+
+    BuildBufferTable();
+
     auto pCmdAllocator = m_CurrFrameRes->Allocator;
     auto hr = pCmdAllocator->Reset();
     if (FAILED(hr))
@@ -846,25 +1338,19 @@ void Renderer::Draw()
     auto handleRTV = m_ColorTarget[m_FrameIndex].GetHandleRTV();
     auto handleDSV = m_DepthTarget.GetHandleDSV();
 
-    m_pCmdList->OMSetRenderTargets(1, &handleRTV->HandleCPU, FALSE, &handleDSV->HandleCPU);
-
     float clearColor[] = { 0.0f, 0.439f, 0.439f, 1.0f };    // 0.0, 0.52, 0.52
     m_pCmdList->ClearRenderTargetView(handleRTV->HandleCPU, clearColor, 0, nullptr);
     m_pCmdList->ClearDepthStencilView(handleDSV->HandleCPU, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
 
-    {
-        ID3D12DescriptorHeap* const pHeaps[] = {
-            m_pPool[DescriptorPool::POOL_TYPE_RES]->GetHeap()
-        };
+    m_pCmdList->Close();
 
-        m_pCmdList->SetGraphicsRootSignature(m_pRootSig.Get());
-        m_pCmdList->SetDescriptorHeaps(1, pHeaps);
-        m_pCmdList->SetPipelineState(m_pPSO.Get());
-        m_pCmdList->RSSetViewports(1, &m_Viewport);
-        m_pCmdList->RSSetScissorRects(1, &m_Scissor);
+    const auto recordCount = RecordRenderItems();
 
-        DrawRenderItems();
-    }
+    // The frame allocator is free again: m_pCmdList is closed and the
+    // render items went to their own allocators.
+    hr = m_pEndCmdList->Reset(pCmdAllocator.Get(), nullptr);
+    if (FAILED(hr))
+        __debugbreak();
 
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
@@ -873,52 +1359,128 @@ void Renderer::Draw()
     barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
     barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
 
-    m_pCmdList->ResourceBarrier(1, &barrier);
+    m_pEndCmdList->ResourceBarrier(1, &barrier);
 
-    m_pCmdList->Close();
+    m_pEndCmdList->Close();
+
+    ID3D12CommandList* pLists[MaxRecordThreads + 2];
+    uint32_t listCount = 0;
+    pLists[listCount++] = m_pCmdList.Get();
+    for (uint32_t i = 0; i < recordCount; ++i)
+    {
+        pLists[listCount++] = m_pRecordCmdLists[i].Get();
+    }
+    pLists[listCount++] = m_pEndCmdList.Get();
+
+    m_pQueue->ExecuteCommandLists(listCount, pLists);
 
-    ID3D12CommandList* pLists[] = { m_pCmdList.Get() };
-    m_pQueue->ExecuteCommandLists(1, pLists);
+    // Earlier frames the GPU has not finished; none means it went idle
+    // waiting for this one.
+    const auto pendingFrames = uint32_t(m_Fence.GetNextValue() - 1 - m_Fence.GetCompletedValue());
+    m_Stats.PipelineDepth  = pendingFrames + 1;
+    m_Stats.FramesInFlight = m_Latency.GetDepth();
+    m_Latency.OnSubmit(pendingFrames);
 
-    m_pSwapChain->Present(1, 0);
+    m_pSwapChain->Present(m_SyncInterval, 0);
     m_FrameIndex = m_pSwapChain->GetCurrentBackBufferIndex();
     m_CurrFrameRes->Fence = m_Fence.Signal(m_pQueue.Get());
+    m_DescriptorRing.EndFrame(m_CurrFrameRes->Fence);
+    m_UploadRing.EndFrame(m_CurrFrameRes->Fence);
 }
 
-void Renderer::DrawRenderItems()
+uint32_t Renderer::RecordRenderItems()
 {
-    const auto pTransform = m_CurrFrameRes->Transform.GetAddress();
-    const auto pLight     = m_CurrFrameRes->Light.GetAddress();
-    const auto pMaterial  = m_CurrFrameRes->Material.GetAddress();
-    const auto pPass      = m_CurrFrameRes->Pass.GetAddress();
-
-    for (int i = 0; i < m_RenderItems.size(); ++i)
-    {
-        const auto& rItem = m_RenderItems[i];
-        const int id = m_pMesh[rItem.MeshIdx]->GetMaterialId();
-        const int dataIdx = rItem.DataIdx;
-
-        const UINT64 transformSize = m_CurrFrameRes->Transform.GetElementSize();
-        const UINT64 lightSize     = m_CurrFrameRes->Light.GetElementSize();
-        const UINT64 materialSize  = m_CurrFrameRes->Material.GetElementSize();
-        const UINT64 passSize      = m_CurrFrameRes->Pass.GetElementSize();
-
-        m_pCmdList->SetGraphicsRootConstantBufferView(0, pTransform + dataIdx * transformSize);
-        m_pCmdList->SetGraphicsRootConstantBufferView(1, pLight + dataIdx * lightSize);
-        m_pCmdList->SetGraphicsRootConstantBufferView(2, pMaterial + dataIdx * materialSize);
-        m_pCmdList->SetGraphicsRootConstantBufferView(3, pPass + dataIdx * passSize);
-        m_pCmdList->SetGraphicsRootDescriptorTable(4, m_Material.GetTextureHandle(id, TU_DIFFUSE));
-        m_pCmdList->SetGraphicsRootDescriptorTable(5, m_Material.GetTextureHandle(id, TU_NORMAL));
-        m_pCmdList->SetGraphicsRootDescriptorTable(6, m_Material.GetTextureHandle(id, TU_SPECULAR));
-        m_pMesh[rItem.MeshIdx]->Draw(m_pCmdList.Get());
-    }
+    const auto batchCount = uint32_t(m_Batches.size());
+    m_Stats.DrawCalls = batchCount;
+
+    // The chunks only read renderer state, which nothing writes until
+    // RecordChunks() returns.
+    return RecordChunks(m_Jobs, this, batchCount, m_RecordThreadCount, MinRecordDraws);
 }
 
-void Renderer::Present(uint32_t interval)
+void Renderer::RecordChunk(uint32_t index, uint32_t begin, uint32_t end)
 {
-    m_pSwapChain->Present(interval, 0);
-    m_Fence.Wait(m_pQueue.Get(), INFINITE);
-    m_FrameIndex = m_pSwapChain->GetCurrentBackBufferIndex();
+    auto pAllocator = m_CurrFrameRes->RecordAllocators[index].Get();
+    auto pCmdList   = m_pRecordCmdLists[index].Get();
+
+    auto hr = pAllocator->Reset();
+    if (FAILED(hr))
+        __debugbreak();
+
+    hr = pCmdList->Reset(pAllocator, nullptr);
+    if (FAILED(hr))
+        __debugbreak();
+
+    // Pipeline state does not carry over between command lists.
+    auto handleRTV = m_ColorTarget[m_FrameIndex].GetHandleRTV();
+    auto handleDSV = m_DepthTarget.GetHandleDSV();
+
+    ID3D12DescriptorHeap* const pHeaps[] = {
+        m_pPool[DescriptorPool::POOL_TYPE_RES]->GetHeap()
+    };
+
+    pCmdList->OMSetRenderTargets(1, &handleRTV->HandleCPU, FALSE, &handleDSV->HandleCPU);
+    pCmdList->SetGraphicsRootSignature(m_pRootSig.Get());
+    pCmdList->SetDescriptorHeaps(1, pHeaps);
+    pCmdList->SetPipelineState(m_pPSO.Get());
+    pCmdList->RSSetViewports(1, &m_Viewport);
+    pCmdList->RSSetScissorRects(1, &m_Scissor);
+
+    DrawRenderItems(pCmdList, begin, end);
+
+    pCmdList->Close();
+}
+
+// begin and end index m_Batches.
+void Renderer::DrawRenderItems(ID3D12GraphicsCommandList* pCmdList, uint32_t begin, uint32_t end)
+{
+    if (begin == end || m_CurrFrameRes->BufferTable.ptr == 0)
+        return;
+
+    pCmdList->SetGraphicsRootConstantBufferView(1, m_CurrFrameRes->Pass);
+    pCmdList->SetGraphicsRootDescriptorTable(2, m_CurrFrameRes->BufferTable);
+
+    if (m_Bindless)
+    {
+        auto pHeap = m_pPool[DescriptorPool::POOL_TYPE_RES]->GetHeap();
+        pCmdList->SetGraphicsRootDescriptorTable(3, pHeap->GetGPUDescriptorHandleForHeapStart());
+    }
+
+    pCmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    // Meshes share geometry pages, so the IA is rebound only when the page
+    // changes. Items are sorted by material, so tables change rarely too.
+    // RecordChunk() binds the opaque PSO; the blend pass follows all of it.
+    uint32_t    boundPage     = UINT32_MAX;
+    uint32_t    boundMaterial = UINT32_MAX;
+    RENDER_PASS boundPass     = RENDER_PASS_OPAQUE;
+
+    for (auto i = begin; i < end; ++i)
+    {
+        const auto& batch = m_Batches[i];
+        const auto pMesh  = m_pMesh[batch.MeshIdx];
+
+        if (batch.Pass != boundPass)
+        {
+            boundPass = batch.Pass;
+            pCmdList->SetPipelineState((boundPass == RENDER_PASS_BLEND) ? m_pBlendPSO.Get() : m_pPSO.Get());
+        }
+
+        if (pMesh->GetPage() != boundPage)
+        {
+            boundPage = pMesh->GetPage();
+            m_Geometry.Bind(pCmdList, boundPage);
+        }
+
+        pCmdList->SetGraphicsRoot32BitConstant(0, batch.FirstInstance, 0);
+        if (!m_Bindless && pMesh->GetMaterialId() != boundMaterial)
+        {
+            boundMaterial = pMesh->GetMaterialId();
+            pCmdList->SetGraphicsRootDescriptorTable(3, m_Material.GetTextureTable(boundMaterial));
+        }
+
+        pMesh->Draw(pCmdList, batch.InstanceCount);
+    }
 }
 
 extern "C" DLL_API IRenderer * CreateRenderer
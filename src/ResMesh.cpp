@@ -1,11 +1,13 @@
 #include <AssimpUtil.h>
 #include <ResMesh.h>
 #include <Mesh.h>
+#include <JobSystem.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <assimp/cimport.h>
 #include <codecvt>
+#include <memory>
 #include <cassert>
 #include <limits>
 
@@ -42,13 +44,18 @@ namespace {
 
         bool Load(
             const wchar_t* filename,
-            std::vector<ResMesh>& meshes,
-            std::vector<ResMaterial>& materials);
-
-        void Normalize(std::vector<ResMesh>& meshes);
+            const MeshCallback& onMesh,
+            std::vector<ResMaterial>& materials,
+            JobSystem* pJobs);
 
     private:
         const aiScene* m_pScene = nullptr;
+        DirectX::XMFLOAT3 m_Min;
+        DirectX::XMFLOAT3 m_Max;
+
+        void ResetBounds();
+        void ExtendBounds(const ResMesh& mesh);
+        void Normalize();
 
         void ParseMesh(ResMesh& dstMesh, const aiMesh* pSrcMesh);
         void ParseMaterial(ResMaterial& dstMaterial, const aiScene* pScene, const aiMaterial* pSrcMaterial);
@@ -56,6 +63,8 @@ namespace {
 
     MeshLoader::MeshLoader()
         : m_pScene(nullptr)
+        , m_Min(FLT_MAX, FLT_MAX, FLT_MAX)
+        , m_Max(FLT_MIN, FLT_MIN, FLT_MIN)
     {
     }
 
@@ -66,11 +75,12 @@ namespace {
     bool MeshLoader::Load
     (
         const wchar_t*              filename,
-        std::vector<ResMesh>&       meshes,
-        std::vector<ResMaterial>&   materials
+        const MeshCallback&         onMesh,
+        std::vector<ResMaterial>&   materials,
+        JobSystem*                  pJobs
     )
     {
-        if (filename == nullptr)
+        if (filename == nullptr || !onMesh)
         {
             return false;
         }
@@ -95,18 +105,70 @@ namespace {
             return false;
         }
 
-        meshes.clear();
-        meshes.resize(m_pScene->mNumMeshes);
+        ResetBounds();
 
-        for (size_t i = 0; i < meshes.size(); ++i)
+        // Mesh i + slotCount is parsed into the slot of mesh i once onMesh
+        // is done with it, so the jobs run ahead of the consumer by at most
+        // one mesh per thread.
+        const size_t meshCount = m_pScene->mNumMeshes;
+        const size_t slotCount = (pJobs != nullptr) ? size_t(pJobs->GetThreadCount()) + 1 : 1;
+        std::vector<ResMesh> slots(slotCount);
+        std::unique_ptr<JobCounter[]> counters(new JobCounter[slotCount]);
+
+        auto parse = [&](size_t index)
         {
-            const auto pMesh = m_pScene->mMeshes[i];
-            ParseMesh(meshes[i], pMesh);
+            auto& slot = slots[index % slotCount];
+            const auto pSrcMesh = m_pScene->mMeshes[index];
+            slot = ResMesh();
+
+            if (pJobs == nullptr)
+            {
+                ParseMesh(slot, pSrcMesh);
+                return;
+            }
+
+            pJobs->Run([this, &slot, pSrcMesh]()
+            {
+                ParseMesh(slot, pSrcMesh);
+            }, &counters[index % slotCount]);
+        };
+
+        for (size_t i = 0; i < slotCount && i < meshCount; ++i)
+        {
+            parse(i);
         }
 
-        // ǥ -1.0 ~ 1.0 ȭ
-        // TODO: ޽   װ ִµ  ʿ
-        Normalize(meshes);
+        for (size_t i = 0; i < meshCount; ++i)
+        {
+            auto& current = slots[i % slotCount];
+            if (pJobs != nullptr)
+            {
+                pJobs->Wait(counters[i % slotCount]);
+            }
+
+            ExtendBounds(current);
+            if (!onMesh(i, current))
+            {
+                // Jobs still parsing read the scene.
+                for (size_t j = 0; pJobs != nullptr && j < slotCount; ++j)
+                {
+                    pJobs->Wait(counters[j]);
+                }
+
+                importer.FreeScene();
+                m_pScene = nullptr;
+                return false;
+            }
+
+            if (i + slotCount < meshCount)
+            {
+                parse(i + slotCount);
+            }
+        }
+
+        // 좌표 -1.0 ~ 1.0로 정규화
+        // TODO: 메쉬 볼륨이 망가지는 버그가 있는데 수정 필요함
+        Normalize();
 
         materials.clear();
         materials.resize(m_pScene->mNumMaterials);
@@ -123,29 +185,33 @@ namespace {
         return true;
     }
 
-    void MeshLoader::Normalize(std::vector<ResMesh>& meshes)
+    void MeshLoader::ResetBounds()
     {
-        float xmax, ymax, zmax;
-        float xmin, ymin, zmin;
-
-        xmax = ymax = zmax = FLT_MIN;
-        xmin = ymin = zmin = FLT_MAX;
+        m_Min = DirectX::XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+        m_Max = DirectX::XMFLOAT3(FLT_MIN, FLT_MIN, FLT_MIN);
+    }
 
-        for (auto& mesh : meshes)
+    void MeshLoader::ExtendBounds(const ResMesh& mesh)
+    {
+        if (mesh.Vertices.empty())
         {
-            for (int i = 0; i < mesh.Vertices.size(); ++i)
-            {
-                const MeshVertex vertex = mesh.Vertices[i];
-                xmax = std::max(xmax, vertex.Position.x);
-                xmin = std::min(xmin, vertex.Position.x);
-                ymax = std::max(ymax, vertex.Position.y);
-                ymin = std::min(ymin, vertex.Position.y);
-                zmax = std::max(zmax, vertex.Position.z);
-                zmin = std::min(zmin, vertex.Position.z);
-            }
+            return;
         }
 
-        Mesh::Scale = 1.0f / std::max(xmax - xmin, std::max(ymax - ymin, zmax - zmin));
+        // The mesh's own bounds already span its vertices.
+        const auto& center  = mesh.Bounds.Center;
+        const auto& extents = mesh.Bounds.Extents;
+        m_Max.x = std::max(m_Max.x, center.x + extents.x);
+        m_Min.x = std::min(m_Min.x, center.x - extents.x);
+        m_Max.y = std::max(m_Max.y, center.y + extents.y);
+        m_Min.y = std::min(m_Min.y, center.y - extents.y);
+        m_Max.z = std::max(m_Max.z, center.z + extents.z);
+        m_Min.z = std::min(m_Min.z, center.z - extents.z);
+    }
+
+    void MeshLoader::Normalize()
+    {
+        Mesh::Scale = 1.0f / std::max(m_Max.x - m_Min.x, std::max(m_Max.y - m_Min.y, m_Max.z - m_Min.z));
     }
 
     void MeshLoader::ParseMesh(ResMesh& dstMesh, const aiMesh* pSrcMesh)
@@ -171,6 +237,21 @@ namespace {
             );
         }
 
+        if (dstMesh.Vertices.empty())
+        {
+            dstMesh.Bounds = DirectX::BoundingBox(
+                DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f),
+                DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f));
+        }
+        else
+        {
+            DirectX::BoundingBox::CreateFromPoints(
+                dstMesh.Bounds,
+                dstMesh.Vertices.size(),
+                &dstMesh.Vertices[0].Position,
+                sizeof(MeshVertex));
+        }
+
         dstMesh.Indices.resize(pSrcMesh->mNumFaces * 3);
 
         for (auto i = 0; i < pSrcMesh->mNumFaces; ++i)
@@ -235,6 +316,18 @@ namespace {
             }
         }
 
+        {
+            auto opacity = 1.0f;
+            if (pSrcMaterial->Get(AI_MATKEY_OPACITY, opacity) == AI_SUCCESS)
+            {
+                dstMaterial.Alpha = opacity;
+            }
+            else
+            {
+                dstMaterial.Alpha = 1.0f;
+            }
+        }
+
         {
             auto shininess = 0.0f;
             if (pSrcMaterial->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS)
@@ -385,7 +478,27 @@ bool LoadMesh
     std::vector<ResMesh>& meshes,
     std::vector<ResMaterial>& materials
 )
+{
+    meshes.clear();
+
+    auto onMesh = [&meshes](size_t, ResMesh& mesh)
+    {
+        meshes.push_back(std::move(mesh));
+        return true;
+    };
+
+    MeshLoader loader;
+    return loader.Load(filename, onMesh, materials, nullptr);
+}
+
+bool LoadMesh
+(
+    const wchar_t* filename,
+    const MeshCallback& onMesh,
+    std::vector<ResMaterial>& materials,
+    JobSystem* pJobs
+)
 {
     MeshLoader loader;
-    return loader.Load(filename, meshes, materials);
+    return loader.Load(filename, onMesh, materials, pJobs);
 }
\ No newline at end of file
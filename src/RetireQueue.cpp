@@ -0,0 +1,59 @@
+#include <RetireQueue.h>
+
+RetireQueue::RetireQueue()
+{
+}
+
+RetireQueue::~RetireQueue()
+{
+    Flush();
+}
+
+void RetireQueue::Enqueue(uint64_t fenceValue, ReleaseFunc&& release)
+{
+    if (!release)
+    {
+        return;
+    }
+
+    if (!m_Entries.empty() && fenceValue < m_Entries.back().FenceValue)
+    {
+        fenceValue = m_Entries.back().FenceValue;
+    }
+
+    Entry entry;
+    entry.FenceValue = fenceValue;
+    entry.Release    = std::move(release);
+    m_Entries.push_back(std::move(entry));
+}
+
+uint32_t RetireQueue::Collect(uint64_t completedValue)
+{
+    uint32_t count = 0;
+    while (!m_Entries.empty() && m_Entries.front().FenceValue <= completedValue)
+    {
+        // Popped first so that a release may enqueue more work.
+        auto release = std::move(m_Entries.front().Release);
+        m_Entries.pop_front();
+
+        release();
+        count++;
+    }
+
+    return count;
+}
+
+void RetireQueue::Flush()
+{
+    Collect(UINT64_MAX);
+}
+
+size_t RetireQueue::GetPendingCount() const
+{
+    return m_Entries.size();
+}
+
+uint64_t RetireQueue::GetLastFenceValue() const
+{
+    return m_Entries.empty() ? 0 : m_Entries.back().FenceValue;
+}
\ No newline at end of file
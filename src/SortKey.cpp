@@ -0,0 +1,57 @@
+#include <SortKey.h>
+#include <cstring>
+
+namespace {
+    // Sort key layout, high bits first. Opaque items are grouped by state
+    // to cut rebinds and drawn front to back within a state to cut overdraw.
+    // Blended items must be drawn back to front, so depth leads for them.
+    //   opaque : pass 2 | pso 6 | material 16 | mesh 20 | depth 20
+    //   blend  : pass 2 | far-to-near depth 20 | pso 6 | material 16 | mesh 20
+    const uint32_t KeyPassBits     = 2;
+    const uint32_t KeyPsoBits      = 6;
+    const uint32_t KeyMaterialBits = 16;
+    const uint32_t KeyMeshBits     = 20;
+    const uint32_t KeyDepthBits    = 20;
+
+    uint64_t KeyField(uint32_t value, uint32_t bits)
+    {
+        return uint64_t(value) & ((uint64_t(1) << bits) - 1);
+    }
+}
+
+// The bits of a positive float order like the float, so its top bits
+// are a quantized depth with precision relative to the distance.
+uint32_t QuantizeDepth(float depth)
+{
+    if (!(depth > 0.0f))
+    {
+        return 0;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &depth, sizeof(bits));
+    return bits >> (31 - KeyDepthBits);
+}
+
+uint64_t MakeSortKey(RENDER_PASS pass, uint32_t pso, uint32_t material, uint32_t mesh, float depth)
+{
+    const auto quantized = QuantizeDepth(depth);
+    uint64_t key = KeyField(pass, KeyPassBits);
+
+    if (pass == RENDER_PASS_BLEND)
+    {
+        key = (key << KeyDepthBits) | KeyField(~quantized, KeyDepthBits);
+        key = (key << KeyPsoBits) | KeyField(pso, KeyPsoBits);
+        key = (key << KeyMaterialBits) | KeyField(material, KeyMaterialBits);
+        key = (key << KeyMeshBits) | KeyField(mesh, KeyMeshBits);
+    }
+    else
+    {
+        key = (key << KeyPsoBits) | KeyField(pso, KeyPsoBits);
+        key = (key << KeyMaterialBits) | KeyField(material, KeyMaterialBits);
+        key = (key << KeyMeshBits) | KeyField(mesh, KeyMeshBits);
+        key = (key << KeyDepthBits) | KeyField(quantized, KeyDepthBits);
+    }
+
+    return key;
+}
\ No newline at end of file
@@ -6,7 +6,8 @@
 
 Texture::Texture()
     : m_pTex(nullptr)
-    , m_pHandle(nullptr)
+    , m_pAllocator(nullptr)
+    , m_HandleId()
     , m_pPool(nullptr)
 {
 }
@@ -31,13 +32,14 @@ bool Texture::Init
     }
 
     assert(m_pPool == nullptr);
-    assert(m_pHandle == nullptr);
+    assert(!m_HandleId.IsValid());
 
     m_pPool = pPool;
     m_pPool->AddRef();
 
-    m_pHandle = pPool->AllocHandle();
-    if (m_pHandle == nullptr)
+    m_HandleId = pPool->AllocId();
+    auto pHandle = pPool->GetHandle(m_HandleId);
+    if (pHandle == nullptr)
     {
         return false;
     }
@@ -55,7 +57,8 @@ bool Texture::Init
     }
 
     auto viewDesc = GetViewDesc(isCube);
-    pDevice->CreateShaderResourceView(m_pTex.Get(), &viewDesc, m_pHandle->HandleCPU);
+    pDevice->CreateShaderResourceView(m_pTex.Get(), &viewDesc, pHandle->HandleCPU);
+    pPool->MarkDirty(m_HandleId);
 
     return true;
 }
@@ -76,13 +79,14 @@ bool Texture::Init
     }
 
     assert(m_pPool == nullptr);
-    assert(m_pHandle == nullptr);
+    assert(!m_HandleId.IsValid());
 
     m_pPool = pPool;
     m_pPool->AddRef();
 
-    m_pHandle = pPool->AllocHandle();
-    if (m_pHandle == nullptr)
+    m_HandleId = pPool->AllocId();
+    auto pHandle = pPool->GetHandle(m_HandleId);
+    if (pHandle == nullptr)
     {
         return false;
     }
@@ -101,7 +105,8 @@ bool Texture::Init
     }
 
     auto viewDesc = GetViewDesc(isCube);
-    pDevice->CreateShaderResourceView(m_pTex.Get(), &viewDesc, m_pHandle->HandleCPU);
+    pDevice->CreateShaderResourceView(m_pTex.Get(), &viewDesc, pHandle->HandleCPU);
+    pPool->MarkDirty(m_HandleId);
 
     return true;
 }
@@ -109,51 +114,49 @@ bool Texture::Init
 bool Texture::Init
 (
     ID3D12Device*               pDevice,
+    GpuAllocator*               pAllocator,
     DescriptorPool*             pPool,
     const D3D12_RESOURCE_DESC*  pDesc,
     bool                        isCube
 )
 {
-    if (pDevice == nullptr || pPool == nullptr || pDesc == nullptr)
+    if (pDevice == nullptr || pAllocator == nullptr || pPool == nullptr || pDesc == nullptr)
     {
         return false;
     }
 
     assert(m_pPool == nullptr);
-    assert(m_pHandle == nullptr);
+    assert(!m_HandleId.IsValid());
 
     m_pPool = pPool;
     m_pPool->AddRef();
 
-    m_pHandle = pPool->AllocHandle();
-    if (m_pHandle == nullptr)
+    m_HandleId = pPool->AllocId();
+    auto pHandle = pPool->GetHandle(m_HandleId);
+    if (pHandle == nullptr)
     {
         return false;
     }
 
-    D3D12_HEAP_PROPERTIES prop = {};
-    prop.Type                 = D3D12_HEAP_TYPE_DEFAULT;
-    prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-    prop.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-    prop.CreationNodeMask     = 0;
-    prop.VisibleNodeMask      = 0;
-
-    auto hr = pDevice->CreateCommittedResource(
-        &prop,
-        D3D12_HEAP_FLAG_NONE,
+    auto hr = pAllocator->CreateResource(
+        D3D12_HEAP_TYPE_DEFAULT,
         pDesc,
         D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
         nullptr,
+        m_Allocation,
         IID_PPV_ARGS(m_pTex.GetAddressOf())
     );
     if (FAILED(hr))
     {
-        ELOG("Error : ID3D12Device::CreateCommittedResource() Failed. retcode = 0x%x", hr);
+        ELOG("Error : GpuAllocator::CreateResource() Failed. retcode = 0x%x", hr);
         return false;
     }
 
+    m_pAllocator = pAllocator;
+
     auto viewDesc = GetViewDesc(isCube);
-    pDevice->CreateShaderResourceView(m_pTex.Get(), &viewDesc, m_pHandle->HandleCPU);
+    pDevice->CreateShaderResourceView(m_pTex.Get(), &viewDesc, pHandle->HandleCPU);
+    pPool->MarkDirty(m_HandleId);
 
     return true;
 }
@@ -162,10 +165,15 @@ void Texture::Term()
 {
     m_pTex.Reset();
 
-    if (m_pHandle != nullptr && m_pPool != nullptr)
+    if (m_pAllocator != nullptr)
+    {
+        m_pAllocator->Free(m_Allocation);
+        m_pAllocator = nullptr;
+    }
+
+    if (m_HandleId.IsValid() && m_pPool != nullptr)
     {
-        m_pPool->FreeHandle(m_pHandle);
-        m_pHandle = nullptr;
+        m_pPool->FreeId(m_HandleId);
     }
 
     if (m_pPool != nullptr)
@@ -177,9 +185,10 @@ void Texture::Term()
 
 D3D12_CPU_DESCRIPTOR_HANDLE Texture::GetHandleCPU() const
 {
-    if (m_pHandle != nullptr)
+    auto pHandle = (m_pPool != nullptr) ? m_pPool->GetHandle(m_HandleId) : nullptr;
+    if (pHandle != nullptr)
     {
-        return m_pHandle->HandleCPU;
+        return pHandle->HandleCPU;
     }
 
     return D3D12_CPU_DESCRIPTOR_HANDLE();
@@ -187,14 +196,25 @@ D3D12_CPU_DESCRIPTOR_HANDLE Texture::GetHandleCPU() const
 
 D3D12_GPU_DESCRIPTOR_HANDLE Texture::GetHandleGPU() const
 {
-    if (m_pHandle != nullptr)
+    auto pHandle = (m_pPool != nullptr) ? m_pPool->GetHandle(m_HandleId) : nullptr;
+    if (pHandle != nullptr)
     {
-        return m_pHandle->HandleGPU;
+        return pHandle->HandleGPU;
     }
 
     return D3D12_GPU_DESCRIPTOR_HANDLE();
 }
 
+uint32_t Texture::GetHeapIndex() const
+{
+    return m_HandleId.GetIndex();
+}
+
+DescriptorId Texture::GetHandleId() const
+{
+    return m_HandleId;
+}
+
 D3D12_SHADER_RESOURCE_VIEW_DESC Texture::GetViewDesc(bool isCube)
 {
     auto desc = m_pTex->GetDesc();
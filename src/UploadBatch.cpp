@@ -0,0 +1,248 @@
+#include <UploadBatch.h>
+#include <MemoryUtil.h>
+#include <Logger.h>
+#include <new>
+
+namespace {
+    // Keeps staged copies on 16 bytes for StreamCopy().
+    constexpr UINT64 StagingAlignment = 16;
+}
+
+UploadBatch::UploadBatch()
+    : m_pDevice()
+    , m_pQueue()
+    , m_pCmd(nullptr)
+    , m_ChunkSize(0)
+    , m_LastFenceValue(0)
+    , m_StagedSize(0)
+{
+}
+
+UploadBatch::~UploadBatch()
+{
+    Term();
+}
+
+bool UploadBatch::Init(ID3D12Device* pDevice, UINT64 chunkSize)
+{
+    if (pDevice == nullptr || chunkSize == 0)
+    {
+        ELOG("Error : Invalid Argument.");
+        return false;
+    }
+
+    Term();
+
+    D3D12_COMMAND_QUEUE_DESC desc = {};
+    desc.Type     = D3D12_COMMAND_LIST_TYPE_COPY;
+    desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+    desc.Flags    = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    desc.NodeMask = 0;
+
+    auto hr = pDevice->CreateCommandQueue(&desc, IID_PPV_ARGS(m_pQueue.GetAddressOf()));
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Device::CreateCommandQueue() Failed. retcode = 0x%x", hr);
+        return false;
+    }
+
+    m_CommandList.Init(pDevice, D3D12_COMMAND_LIST_TYPE_COPY, 1);
+    m_Fence.Init(pDevice);
+
+    m_pDevice   = pDevice;
+    m_ChunkSize = chunkSize;
+
+    return true;
+}
+
+void UploadBatch::Term()
+{
+    if (m_pQueue != nullptr)
+    {
+        Flush();
+    }
+
+    for (auto chunks : { &m_Active, &m_Pending, &m_Free })
+    {
+        for (auto& chunk : *chunks)
+        {
+            delete chunk.pBuffer;
+        }
+        chunks->clear();
+    }
+
+    m_Fence.Term();
+    m_CommandList.Term();
+    m_pQueue.Reset();
+    m_pDevice.Reset();
+
+    m_pCmd           = nullptr;
+    m_ChunkSize      = 0;
+    m_LastFenceValue = 0;
+    m_StagedSize     = 0;
+}
+
+bool UploadBatch::Begin()
+{
+    if (m_pQueue == nullptr || m_pCmd != nullptr)
+    {
+        return false;
+    }
+
+    // The single allocator may still be in use by the previous batch.
+    m_Fence.Wait(m_LastFenceValue, INFINITE);
+    Recycle(m_Fence.GetCompletedValue());
+
+    m_pCmd = m_CommandList.Reset();
+    if (m_pCmd == nullptr)
+    {
+        ELOG("Error : CommandList::Reset() Failed.");
+        return false;
+    }
+
+    m_StagedSize = 0;
+
+    return true;
+}
+
+bool UploadBatch::Upload(ID3D12Resource* pDst, UINT64 dstOffset, const void* pData, UINT64 size)
+{
+    if (m_pCmd == nullptr || pDst == nullptr || pData == nullptr || size == 0)
+    {
+        return false;
+    }
+
+    UploadBuffer* pBuffer = nullptr;
+    UINT64 offset = 0;
+    if (!Alloc(size, pBuffer, offset))
+    {
+        return false;
+    }
+
+    StreamCopy(pBuffer->GetPtr<uint8_t>() + offset, pData, size_t(size));
+    m_pCmd->CopyBufferRegion(pDst, dstOffset, pBuffer->GetResource(), offset, size);
+
+    m_StagedSize += size;
+
+    return true;
+}
+
+UINT64 UploadBatch::End(ID3D12CommandQueue* pWaitQueue)
+{
+    if (m_pCmd == nullptr)
+    {
+        return 0;
+    }
+
+    m_pCmd->Close();
+
+    ID3D12CommandList* pLists[] = { m_pCmd };
+    m_pCmd = nullptr;
+
+    m_pQueue->ExecuteCommandLists(1, pLists);
+
+    m_LastFenceValue = m_Fence.Signal(m_pQueue.Get());
+
+    for (auto& chunk : m_Active)
+    {
+        chunk.FenceValue = m_LastFenceValue;
+        m_Pending.push_back(chunk);
+    }
+    m_Active.clear();
+
+    if (pWaitQueue != nullptr)
+    {
+        pWaitQueue->Wait(m_Fence.GetFence(), m_LastFenceValue);
+    }
+
+    return m_LastFenceValue;
+}
+
+void UploadBatch::Flush()
+{
+    m_Fence.Wait(m_LastFenceValue, INFINITE);
+    Recycle(m_Fence.GetCompletedValue());
+}
+
+UINT64 UploadBatch::GetStagedSize() const
+{
+    return m_StagedSize;
+}
+
+bool UploadBatch::Alloc(UINT64 size, UploadBuffer*& pBuffer, UINT64& offset)
+{
+    if (!m_Active.empty())
+    {
+        auto& chunk = m_Active.back();
+        const auto aligned = (chunk.Offset + StagingAlignment - 1) & ~(StagingAlignment - 1);
+        if (aligned + size <= chunk.pBuffer->GetSize())
+        {
+            pBuffer      = chunk.pBuffer;
+            offset       = aligned;
+            chunk.Offset = aligned + size;
+            return true;
+        }
+    }
+
+    Chunk chunk = {};
+
+    for (size_t i = 0; i < m_Free.size(); ++i)
+    {
+        if (m_Free[i].pBuffer->GetSize() >= size)
+        {
+            chunk = m_Free[i];
+            m_Free.erase(m_Free.begin() + i);
+            break;
+        }
+    }
+
+    if (chunk.pBuffer == nullptr)
+    {
+        chunk.pBuffer = new (std::nothrow) UploadBuffer();
+        if (chunk.pBuffer == nullptr)
+        {
+            ELOG("Error : Out of memory.");
+            return false;
+        }
+
+        if (!chunk.pBuffer->Init(m_pDevice.Get(), (size > m_ChunkSize) ? size : m_ChunkSize))
+        {
+            delete chunk.pBuffer;
+            return false;
+        }
+    }
+
+    chunk.Offset     = size;
+    chunk.FenceValue = 0;
+    m_Active.push_back(chunk);
+
+    pBuffer = chunk.pBuffer;
+    offset  = 0;
+
+    return true;
+}
+
+void UploadBatch::Recycle(UINT64 completedValue)
+{
+    for (size_t i = 0; i < m_Pending.size();)
+    {
+        if (m_Pending[i].FenceValue > completedValue)
+        {
+            ++i;
+            continue;
+        }
+
+        // Oversized one-off chunks and anything beyond a small reserve go.
+        auto chunk = m_Pending[i];
+        m_Pending.erase(m_Pending.begin() + i);
+
+        if (m_Free.size() < MaxFreeChunkCount && chunk.pBuffer->GetSize() == m_ChunkSize)
+        {
+            m_Free.push_back(chunk);
+        }
+        else
+        {
+            delete chunk.pBuffer;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include <UploadBuffer.h>
+#include <Logger.h>
+
+UploadBuffer::UploadBuffer()
+    : m_pBuffer()
+    , m_pMappedPtr(nullptr)
+    , m_Size(0)
+{
+}
+
+UploadBuffer::~UploadBuffer()
+{
+    Term();
+}
+
+bool UploadBuffer::Init(ID3D12Device* pDevice, UINT64 size)
+{
+    if (pDevice == nullptr || size == 0)
+    {
+        ELOG("Error : Invalid Argument.");
+        return false;
+    }
+
+    Term();
+
+    D3D12_HEAP_PROPERTIES prop = {};
+    prop.Type                 = D3D12_HEAP_TYPE_UPLOAD;
+    prop.CPUPageProperty      = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    prop.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    prop.CreationNodeMask     = 1;
+    prop.VisibleNodeMask      = 1;
+
+    D3D12_RESOURCE_DESC desc = {};
+    desc.Dimension          = D3D12_RESOURCE_DIMENSION_BUFFER;
+    desc.Alignment          = 0;
+    desc.Width              = size;
+    desc.Height             = 1;
+    desc.DepthOrArraySize   = 1;
+    desc.MipLevels          = 1;
+    desc.Format             = DXGI_FORMAT_UNKNOWN;
+    desc.SampleDesc.Count   = 1;
+    desc.SampleDesc.Quality = 0;
+    desc.Layout             = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    desc.Flags              = D3D12_RESOURCE_FLAG_NONE;
+
+    auto hr = pDevice->CreateCommittedResource(
+        &prop,
+        D3D12_HEAP_FLAG_NONE,
+        &desc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(m_pBuffer.GetAddressOf()));
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Device::CreateCommittedResource() Failed. retcode = 0x%x", hr);
+        return false;
+    }
+
+    hr = m_pBuffer->Map(0, nullptr, &m_pMappedPtr);
+    if (FAILED(hr))
+    {
+        ELOG("Error : ID3D12Resource::Map() Failed. retcode = 0x%x", hr);
+        m_pBuffer.Reset();
+        return false;
+    }
+
+    m_Size = size;
+
+    return true;
+}
+
+void UploadBuffer::Term()
+{
+    if (m_pBuffer != nullptr)
+    {
+        m_pBuffer->Unmap(0, nullptr);
+        m_pBuffer.Reset();
+    }
+
+    m_pMappedPtr = nullptr;
+    m_Size       = 0;
+}
+
+ID3D12Resource* UploadBuffer::GetResource() const
+{
+    return m_pBuffer.Get();
+}
+
+D3D12_GPU_VIRTUAL_ADDRESS UploadBuffer::GetAddress() const
+{
+    return (m_pBuffer != nullptr) ? m_pBuffer->GetGPUVirtualAddress() : 0;
+}
+
+UINT64 UploadBuffer::GetSize() const
+{
+    return m_Size;
+}
+
+void* UploadBuffer::GetPtr() const
+{
+    return m_pMappedPtr;
+}
\ No newline at end of file
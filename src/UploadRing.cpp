@@ -0,0 +1,150 @@
+#include <UploadRing.h>
+#include <Logger.h>
+
+UploadRing::UploadRing()
+    : m_pDevice()
+    , m_Buffer()
+    , m_pMappedPtr(nullptr)
+    , m_Address(0)
+    , m_Ring()
+    , m_FrameCount(0)
+    , m_FrameIndex(0)
+{
+}
+
+UploadRing::~UploadRing()
+{
+    Term();
+}
+
+bool UploadRing::Init(ID3D12Device* pDevice, uint32_t sizePerFrame, uint32_t frameCount)
+{
+    if (pDevice == nullptr || sizePerFrame == 0 || frameCount == 0)
+    {
+        ELOG("Error : Invalid Argument.");
+        return false;
+    }
+
+    Term();
+
+    m_pDevice    = pDevice;
+    m_FrameCount = frameCount;
+
+    return CreateBuffer(sizePerFrame);
+}
+
+void UploadRing::Term()
+{
+    m_Buffer.Term();
+    m_Retired.clear();
+    m_Ring.Term();
+    m_pDevice.Reset();
+
+    m_pMappedPtr = nullptr;
+    m_Address    = 0;
+    m_FrameCount = 0;
+    m_FrameIndex = 0;
+}
+
+bool UploadRing::BeginFrame(uint32_t frameIndex, uint64_t completedValue)
+{
+    for (size_t i = 0; i < m_Retired.size();)
+    {
+        if (m_Retired[i].FenceValue <= completedValue)
+        {
+            m_Retired[i] = m_Retired.back();
+            m_Retired.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    m_FrameIndex = frameIndex;
+    return m_Ring.BeginFrame(frameIndex, completedValue);
+}
+
+void UploadRing::EndFrame(uint64_t fenceValue)
+{
+    // Buffers retired during this frame were still used by it.
+    for (auto& retired : m_Retired)
+    {
+        if (retired.FenceValue == PendingFence)
+            retired.FenceValue = fenceValue;
+    }
+
+    m_Ring.EndFrame(fenceValue);
+}
+
+bool UploadRing::Alloc(uint32_t size, Allocation& allocation, uint32_t alignment)
+{
+    uint32_t offset = 0;
+    if (!m_Ring.Alloc(size, alignment, offset))
+    {
+        if (!Grow(size, alignment) || !m_Ring.Alloc(size, alignment, offset))
+        {
+            return false;
+        }
+    }
+
+    allocation.pCPU      = m_pMappedPtr + offset;
+    allocation.Address   = m_Address + offset;
+    allocation.pResource = m_Buffer.GetResource();
+    allocation.Offset    = offset;
+
+    return true;
+}
+
+uint32_t UploadRing::GetUsedSize() const
+{
+    return m_Ring.GetUsedCount();
+}
+
+uint32_t UploadRing::GetSizePerFrame() const
+{
+    return m_Ring.GetPartitionSize();
+}
+
+bool UploadRing::CreateBuffer(uint32_t sizePerFrame)
+{
+    if (m_Buffer.GetResource() != nullptr)
+    {
+        RetiredBuffer retired;
+        retired.pBuffer    = m_Buffer.GetResource();
+        retired.FenceValue = PendingFence;
+        m_Retired.push_back(retired);
+    }
+
+    if (!m_Buffer.Init(m_pDevice.Get(), UINT64(sizePerFrame) * m_FrameCount))
+    {
+        m_Ring.Term();
+        m_pMappedPtr = nullptr;
+        m_Address    = 0;
+        return false;
+    }
+
+    m_pMappedPtr = m_Buffer.GetPtr<uint8_t>();
+    m_Address    = m_Buffer.GetAddress();
+
+    // Nothing in flight uses the new buffer, so every partition starts out free.
+    return m_Ring.Init(sizePerFrame, m_FrameCount);
+}
+
+bool UploadRing::Grow(uint32_t size, uint32_t alignment)
+{
+    auto newSize = m_Ring.GetPartitionSize() * 2;
+    while (newSize < size + alignment)
+    {
+        newSize *= 2;
+    }
+
+    if (!CreateBuffer(newSize))
+    {
+        return false;
+    }
+
+    DLOG("UploadRing : grown to %u bytes per frame", newSize);
+
+    return m_Ring.BeginFrame(m_FrameIndex, 0);
+}
\ No newline at end of file
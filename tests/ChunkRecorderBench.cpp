@@ -0,0 +1,167 @@
+#include <TestUtil.h>
+#include <ChunkRecorder.h>
+#include <JobSystem.h>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Recording of a synthetic draw list through RecordChunks() on 1 to N
+// threads (N defaults to the hardware thread count; pass another as the
+// first argument). The recorder is a stub that writes commands into one
+// buffer per chunk and spends a fixed amount of work per call, standing in
+// for command list recording and its validation.
+namespace {
+
+const uint32_t MaxChunks = 8;
+const uint32_t MinDraws  = 256;
+const uint32_t Repeats   = 20;
+
+struct Draw
+{
+    uint32_t    Page;
+    uint32_t    Material;
+    uint32_t    FirstInstance;
+    uint32_t    InstanceCount;
+};
+
+class StubRecorder : public IChunkRecorder
+{
+public:
+    explicit StubRecorder(const std::vector<Draw>& draws)
+        : m_Draws(draws)
+        , m_Lists(MaxChunks)
+    {
+    }
+
+    void RecordChunk(uint32_t index, uint32_t begin, uint32_t end)
+    {
+        auto& list = m_Lists[index];
+        list.clear();
+
+        // Each list starts without state, like a reset command list.
+        uint32_t boundPage     = UINT32_MAX;
+        uint32_t boundMaterial = UINT32_MAX;
+
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& draw = m_Draws[i];
+            if (draw.Page != boundPage)
+            {
+                boundPage = draw.Page;
+                Emit(list, 1, draw.Page);
+            }
+
+            if (draw.Material != boundMaterial)
+            {
+                boundMaterial = draw.Material;
+                Emit(list, 2, draw.Material);
+            }
+
+            Emit(list, 3, draw.FirstInstance);
+            Emit(list, 4, draw.InstanceCount);
+        }
+    }
+
+    uint64_t GetSize() const
+    {
+        uint64_t size = 0;
+        for (const auto& list : m_Lists)
+        {
+            size += list.size();
+        }
+        return size;
+    }
+
+private:
+    const std::vector<Draw>&            m_Draws;
+    std::vector<std::vector<uint32_t>>  m_Lists;
+
+    static void Emit(std::vector<uint32_t>& list, uint32_t op, uint32_t value)
+    {
+        // Stand-in for the driver's work per call.
+        auto hash = op * 2654435761u ^ value;
+        for (auto k = 0; k < 32; ++k)
+        {
+            hash = (hash ^ (hash >> 15)) * 2246822519u;
+        }
+
+        list.push_back(op);
+        list.push_back(value);
+        list.push_back(hash);
+    }
+};
+
+double Run(JobSystem& jobs, const std::vector<Draw>& draws, uint32_t maxChunks)
+{
+    StubRecorder recorder(draws);
+
+    // Warm up the list buffers.
+    RecordChunks(jobs, &recorder, uint32_t(draws.size()), maxChunks, MinDraws);
+
+    BenchTimer timer;
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        RecordChunks(jobs, &recorder, uint32_t(draws.size()), maxChunks, MinDraws);
+    }
+    const auto elapsed = timer.GetElapsedMs() / Repeats;
+
+    KeepAlive(recorder.GetSize());
+    return elapsed;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto maxThreads = std::thread::hardware_concurrency();
+    if (argc > 1)
+    {
+        maxThreads = uint32_t(atoi(argv[1]));
+    }
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+
+    // Sorted like render items: runs of draws share a material and a page.
+    std::mt19937 random(31);
+    const uint32_t drawCounts[] = { 10000, 50000, 100000 };
+
+    printf("%8s %8s %12s %10s\n", "draws", "threads", "record ms", "speedup");
+
+    for (auto drawCount : drawCounts)
+    {
+        std::vector<Draw> draws(drawCount);
+        for (auto i = 0u; i < drawCount; ++i)
+        {
+            draws[i].Page          = i / 4096;
+            draws[i].Material      = i / 64;
+            draws[i].FirstInstance = i;
+            draws[i].InstanceCount = 1 + random() % 4;
+        }
+
+        double baseline = 0.0;
+        for (auto threadCount = 1u; threadCount <= maxThreads; ++threadCount)
+        {
+            // One thread records everything into a single list, as before.
+            JobSystem jobs;
+            if (threadCount > 1 && !jobs.Init(threadCount - 1))
+            {
+                break;
+            }
+
+            const auto chunks  = std::min(threadCount, MaxChunks);
+            const auto elapsed = Run(jobs, draws, chunks);
+            if (threadCount == 1)
+            {
+                baseline = elapsed;
+            }
+
+            printf("%8u %8u %12.3f %10.2f\n", drawCount, threadCount, elapsed, baseline / elapsed);
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <TestUtil.h>
+#include <ChunkRecorder.h>
+#include <JobSystem.h>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Notes which chunk recorded each draw; chunks only write their own slots.
+class StubRecorder : public IChunkRecorder
+{
+public:
+    StubRecorder(uint32_t drawCount, uint32_t maxChunks)
+        : Owner(drawCount, UINT32_MAX)
+        , Ranges(maxChunks)
+        , Calls(0)
+    {
+    }
+
+    void RecordChunk(uint32_t index, uint32_t begin, uint32_t end)
+    {
+        Ranges[index].first  = begin;
+        Ranges[index].second = end;
+        for (auto i = begin; i < end; ++i)
+        {
+            Owner[i] = index;
+        }
+        Calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::vector<uint32_t>                       Owner;
+    std::vector<std::pair<uint32_t, uint32_t>>  Ranges;
+    std::atomic<uint32_t>                       Calls;
+};
+
+void TestPartition()
+{
+    // Below minDraws: one chunk.
+    auto layout = PartitionChunks(100, 8, 256);
+    CHECK(layout.Count == 1);
+    CHECK(layout.Size == 100);
+
+    // No draws still records one (empty) chunk.
+    layout = PartitionChunks(0, 8, 256);
+    CHECK(layout.Count == 1);
+    CHECK(layout.Size == 0);
+
+    // One chunk per started minDraws, split evenly.
+    layout = PartitionChunks(800, 8, 256);
+    CHECK(layout.Count == 4);
+    CHECK(layout.Size == 200);
+
+    // Capped at maxChunks.
+    layout = PartitionChunks(100000, 8, 256);
+    CHECK(layout.Count == 8);
+    CHECK(layout.Size == 12500);
+
+    // maxChunks and minDraws of zero behave like one.
+    layout = PartitionChunks(10, 0, 0);
+    CHECK(layout.Count == 1);
+    CHECK(layout.Size == 10);
+}
+
+// Every draw is recorded exactly once, in contiguous ascending ranges.
+void TestCoverage(JobSystem& jobs)
+{
+    const uint32_t drawCounts[] = { 0, 1, 255, 256, 257, 1000, 4099, 100000 };
+    const uint32_t maxChunks[]  = { 1, 3, 8 };
+
+    for (auto drawCount : drawCounts)
+    {
+        for (auto chunks : maxChunks)
+        {
+            StubRecorder recorder(drawCount, chunks);
+            const auto count = RecordChunks(jobs, &recorder, drawCount, chunks, 256);
+
+            CHECK(count >= 1 && count <= chunks);
+            CHECK(recorder.Calls.load() == count);
+
+            bool covered = true;
+            for (auto i = 0u; i < drawCount; ++i)
+            {
+                covered = covered && recorder.Owner[i] < count;
+                covered = covered && (i == 0 || recorder.Owner[i] >= recorder.Owner[i - 1]);
+            }
+            CHECK(covered);
+
+            for (auto c = 1u; c < count; ++c)
+            {
+                CHECK(recorder.Ranges[c].first == recorder.Ranges[c - 1].second);
+            }
+            CHECK(recorder.Ranges[0].first == 0);
+            CHECK(recorder.Ranges[count - 1].second == drawCount);
+        }
+    }
+}
+
+void TestSingleThread()
+{
+    JobSystem jobs;
+    TestCoverage(jobs);
+}
+
+void TestWorkers()
+{
+    JobSystem jobs;
+    CHECK(jobs.Init(3));
+    TestCoverage(jobs);
+    jobs.Term();
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestPartition);
+    RUN_TEST(TestSingleThread);
+    RUN_TEST(TestWorkers);
+
+    return GetTestResult();
+}
\ No newline at end of file
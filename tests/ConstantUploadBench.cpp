@@ -0,0 +1,251 @@
+#include <TestUtil.h>
+#include <MemoryUtil.h>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Bytes written to the upload buffers per frame, and the time taken, for
+//  - per item: every item carries its own transform (World, View, Proj),
+//    lights, material and pass constants, each in a 256-byte constant
+//    buffer slot, copied with memcpy as ConstantBuffer::CopyData() did
+//    before the pass constants were split out,
+//  - full:     one PassConstant per frame plus a full ObjectBuffer per item,
+//  - dirty:    the same layout, copying only the fields changed since the
+//    frame resource was last used (Renderer::UpdateObject()),
+// with 1k to 100k items and 0% to 100% of the items moving every frame.
+// The structs mirror the sizes in FrameResource.h. The destination is
+// ordinary memory here, not a write-combined upload heap.
+namespace {
+
+const uint32_t FrameResourceCount = 3;
+const uint32_t Frames             = 60;
+const uint32_t SlotSize           = 256;    // constant buffer placement alignment
+
+struct Matrix
+{
+    float m[16];
+};
+
+struct ObjectBuffer         // 80 bytes
+{
+    Matrix      World;
+    uint32_t    MaterialIndex;
+    uint32_t    Flags;
+    uint32_t    pad[2];
+};
+
+struct TransformBuffer      // 192 bytes
+{
+    Matrix World;
+    Matrix View;
+    Matrix Proj;
+};
+
+struct LightBuffer          // 144 bytes
+{
+    float Items[3][12];
+};
+
+struct MaterialBuffer       // 32 bytes
+{
+    float Values[8];
+};
+
+struct OldPassConstant      // 48 bytes
+{
+    float   CameraPosition[4];
+    float   AmbientLight[4];
+    int32_t MapUsable[4];
+};
+
+struct PassConstant         // 256 bytes
+{
+    Matrix          ViewProj;
+    LightBuffer     Lights;
+    float           CameraPosition[4];
+    float           AmbientLight[4];
+    int32_t         MapUsable[4];
+};
+
+enum FIELD
+{
+    FIELD_WORLD    = 0,
+    FIELD_MATERIAL = 1,
+    FIELD_COUNT
+};
+
+struct Item
+{
+    ObjectBuffer    Object;
+    uint64_t        Version[FIELD_COUNT];
+};
+
+struct Result
+{
+    uint64_t    Bytes;  // per frame
+    double      Ms;     // per frame
+};
+
+// Moves fraction of the items, stamping them with version.
+void Animate(std::vector<Item>& items, float fraction, uint64_t version, std::mt19937& random)
+{
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    for (auto& item : items)
+    {
+        if (fraction > 0.0f && chance(random) < fraction)
+        {
+            item.Object.World.m[12] += 0.01f;
+            item.Version[FIELD_WORLD] = version;
+        }
+    }
+}
+
+Result RunPerItem(uint32_t count)
+{
+    std::vector<uint8_t> transforms(size_t(count) * SlotSize);
+    std::vector<uint8_t> lights(size_t(count) * SlotSize);
+    std::vector<uint8_t> materials(size_t(count) * SlotSize);
+    std::vector<uint8_t> passes(size_t(count) * SlotSize);
+
+    TransformBuffer transform = {};
+    LightBuffer     light     = {};
+    MaterialBuffer  material  = {};
+    OldPassConstant pass      = {};
+
+    uint64_t bytes = 0;
+    BenchTimer timer;
+    for (auto frame = 0u; frame < Frames; ++frame)
+    {
+        transform.World.m[12] = float(frame);
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto offset = size_t(i) * SlotSize;
+            memcpy(&transforms[offset], &transform, sizeof(transform));
+            memcpy(&lights[offset],     &light,     sizeof(light));
+            memcpy(&materials[offset],  &material,  sizeof(material));
+            memcpy(&passes[offset],     &pass,      sizeof(pass));
+            bytes += sizeof(transform) + sizeof(light) + sizeof(material) + sizeof(pass);
+        }
+    }
+
+    Result result;
+    result.Ms    = timer.GetElapsedMs() / Frames;
+    result.Bytes = bytes / Frames;
+
+    KeepAlive(transforms[size_t(count / 2) * SlotSize + 48]);
+    return result;
+}
+
+// dirtyOnly false rewrites every ObjectBuffer, true copies only the fields
+// changed since the frame resource last synced, as Renderer::UpdateObject().
+Result RunSplit(uint32_t count, float fraction, bool dirtyOnly)
+{
+    std::vector<Item> items(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        memset(&items[i].Object, 0, sizeof(ObjectBuffer));
+        items[i].Object.MaterialIndex   = i % 64;
+        items[i].Version[FIELD_WORLD]    = 1;
+        items[i].Version[FIELD_MATERIAL] = 1;
+    }
+
+    std::vector<ObjectBuffer> buffers[FrameResourceCount];
+    uint64_t                  synced[FrameResourceCount] = {};
+    for (auto& buffer : buffers)
+    {
+        buffer.resize(count);
+    }
+
+    std::vector<uint8_t> passRing(SlotSize * FrameResourceCount);
+    PassConstant pass = {};
+
+    std::mt19937 random(37);
+    uint64_t bytes   = 0;
+    double   elapsed = 0.0;
+    for (auto frame = 0u; frame < Frames + FrameResourceCount; ++frame)
+    {
+        const auto version = uint64_t(frame) + 2;
+        Animate(items, fraction, version, random);
+
+        // The first frame of every frame resource copies everything; only
+        // the frames after that are measured.
+        const auto measured = frame >= FrameResourceCount;
+        const auto index    = frame % FrameResourceCount;
+        auto       pDst     = buffers[index].data();
+        uint64_t   frameBytes = 0;
+
+        BenchTimer timer;
+        StreamCopy(&passRing[SlotSize * index], &pass, sizeof(pass));
+        frameBytes += sizeof(pass);
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto& item = items[i];
+            auto&       dst  = pDst[i];
+
+            if (!dirtyOnly)
+            {
+                StreamCopy(&dst, &item.Object, sizeof(ObjectBuffer));
+                frameBytes += sizeof(ObjectBuffer);
+                continue;
+            }
+
+            if (item.Version[FIELD_WORLD] > synced[index])
+            {
+                StreamCopy(&dst.World, &item.Object.World, sizeof(dst.World));
+                frameBytes += sizeof(dst.World);
+            }
+
+            if (item.Version[FIELD_MATERIAL] > synced[index])
+            {
+                dst.MaterialIndex = item.Object.MaterialIndex;
+                dst.Flags         = item.Object.Flags;
+                frameBytes += sizeof(dst.MaterialIndex) + sizeof(dst.Flags);
+            }
+        }
+        synced[index] = version;
+
+        if (measured)
+        {
+            elapsed += timer.GetElapsedMs();
+            bytes   += frameBytes;
+        }
+    }
+
+    Result result;
+    result.Ms    = elapsed / Frames;
+    result.Bytes = bytes / Frames;
+
+    KeepAlive(buffers[0][count / 2].MaterialIndex);
+    return result;
+}
+
+void Print(uint32_t count, const char* mode, float fraction, const Result& result)
+{
+    printf("%8u %9s %7.0f%% %14llu %10.1f %10.3f\n",
+        count, mode, fraction * 100.0f,
+        (unsigned long long)result.Bytes, double(result.Bytes) / count, result.Ms);
+}
+
+} // namespace
+
+int main()
+{
+    printf("%8s %9s %8s %14s %10s %10s\n", "items", "mode", "moving", "bytes/frame", "bytes/item", "ms/frame");
+
+    const uint32_t counts[]    = { 1000, 10000, 100000 };
+    const float    fractions[] = { 0.0f, 0.01f, 0.1f, 1.0f };
+
+    for (auto count : counts)
+    {
+        Print(count, "per item", 1.0f, RunPerItem(count));
+        Print(count, "full", 1.0f, RunSplit(count, 1.0f, false));
+
+        for (auto fraction : fractions)
+        {
+            Print(count, "dirty", fraction, RunSplit(count, fraction, true));
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <TestUtil.h>
+#include <FrameRing.h>
+
+namespace {
+
+void TestInit()
+{
+    FrameRing ring;
+    CHECK(!ring.Init(0, 2));
+    CHECK(!ring.Init(256, 0));
+    CHECK(ring.Init(256, 3));
+    CHECK(ring.GetPartitionSize() == 256);
+    CHECK(ring.GetPartitionCount() == 3);
+
+    // Allocating outside a frame fails.
+    uint32_t offset;
+    CHECK(!ring.Alloc(16, 1, offset));
+}
+
+void TestAllocInPartition()
+{
+    FrameRing ring;
+    CHECK(ring.Init(256, 2));
+    CHECK(ring.BeginFrame(1, 0));
+
+    uint32_t offset = 0;
+    CHECK(ring.Alloc(10, 1, offset));
+    CHECK(offset == 256);
+
+    // Aligned within the partition.
+    CHECK(ring.Alloc(16, 64, offset));
+    CHECK(offset == 256 + 64);
+    CHECK(ring.GetUsedCount() == 80);
+
+    CHECK(!ring.Alloc(0, 1, offset));
+
+    // Exactly filling the partition works, one more does not.
+    CHECK(ring.Alloc(176, 1, offset));
+    CHECK(offset == 256 + 80);
+    CHECK(!ring.Alloc(1, 1, offset));
+    CHECK(ring.GetPeakCount() == 256);
+
+    // An alignment past the end fails without wrapping.
+    CHECK(ring.BeginFrame(1, 0));
+    CHECK(ring.Alloc(200, 1, offset));
+    CHECK(!ring.Alloc(1, 256, offset));
+    CHECK(ring.GetUsedCount() == 200);
+    CHECK(ring.GetPeakCount() == 256);
+}
+
+// Three partitions, the GPU two frames behind: a partition is only reused
+// once the fence value of its last frame has completed.
+void TestFrameLoop()
+{
+    const uint32_t PartitionCount = 3;
+
+    FrameRing ring;
+    FakeFence fence;
+    CHECK(ring.Init(1024, PartitionCount));
+
+    uint64_t frameFences[PartitionCount] = {};
+    for (auto frame = 0u; frame < 30; ++frame)
+    {
+        const auto partition = frame % PartitionCount;
+
+        // Not yet finished on the GPU.
+        if (frame >= PartitionCount)
+        {
+            CHECK(!ring.BeginFrame(partition, fence.GetCompletedValue()));
+            fence.Complete(frameFences[partition]);
+        }
+
+        CHECK(ring.BeginFrame(partition, fence.GetCompletedValue()));
+
+        uint32_t offset;
+        for (auto i = 0u; i < 4; ++i)
+        {
+            CHECK(ring.Alloc(100, 256, offset));
+            CHECK(offset >= partition * 1024 && offset + 100 <= (partition + 1) * 1024);
+            CHECK((offset & 255) == 0);
+        }
+
+        frameFences[partition] = fence.Signal();
+        ring.EndFrame(frameFences[partition]);
+        CHECK(ring.GetFenceValue(partition) == frameFences[partition]);
+
+        CHECK(!ring.Alloc(1, 1, offset));
+    }
+
+    // EndFrame() outside a frame changes nothing.
+    ring.EndFrame(12345);
+    CHECK(ring.GetFenceValue(0) != 12345);
+    CHECK(ring.GetFenceValue(PartitionCount) == 0);
+    CHECK(!ring.BeginFrame(PartitionCount, 0));
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestInit);
+    RUN_TEST(TestAllocInPartition);
+    RUN_TEST(TestFrameLoop);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include <TestUtil.h>
+#include <FrustumCuller.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+// FrustumCuller::Cull() over 1M random AABBs against a scalar loop over an
+// array of boxes that tests one box against one plane at a time, with the
+// same planes. About one box in six is visible.
+namespace {
+
+const uint32_t BoxCount = 1000000;
+const uint32_t Repeats  = 20;
+
+struct Box
+{
+    XMFLOAT3 Center;
+    XMFLOAT3 Extents;
+};
+
+struct Plane
+{
+    float X, Y, Z, W;
+};
+
+void GetPlanes(FXMMATRIX viewProj, Plane* pPlanes)
+{
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, viewProj);
+
+    const float rows[6][4] = {
+        { m.m[0][3] + m.m[0][0], m.m[1][3] + m.m[1][0], m.m[2][3] + m.m[2][0], m.m[3][3] + m.m[3][0] },
+        { m.m[0][3] - m.m[0][0], m.m[1][3] - m.m[1][0], m.m[2][3] - m.m[2][0], m.m[3][3] - m.m[3][0] },
+        { m.m[0][3] + m.m[0][1], m.m[1][3] + m.m[1][1], m.m[2][3] + m.m[2][1], m.m[3][3] + m.m[3][1] },
+        { m.m[0][3] - m.m[0][1], m.m[1][3] - m.m[1][1], m.m[2][3] - m.m[2][1], m.m[3][3] - m.m[3][1] },
+        { m.m[0][2],             m.m[1][2],             m.m[2][2],             m.m[3][2] },
+        { m.m[0][3] - m.m[0][2], m.m[1][3] - m.m[1][2], m.m[2][3] - m.m[2][2], m.m[3][3] - m.m[3][2] },
+    };
+
+    for (auto i = 0; i < 6; ++i)
+    {
+        const auto length = std::sqrt(rows[i][0] * rows[i][0] + rows[i][1] * rows[i][1] + rows[i][2] * rows[i][2]);
+        pPlanes[i].X = rows[i][0] / length;
+        pPlanes[i].Y = rows[i][1] / length;
+        pPlanes[i].Z = rows[i][2] / length;
+        pPlanes[i].W = rows[i][3] / length;
+    }
+}
+
+uint32_t CullScalar(const Plane* pPlanes, const std::vector<Box>& boxes, uint32_t* pVisible)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < uint32_t(boxes.size()); ++i)
+    {
+        const auto& box = boxes[i];
+
+        bool inside = true;
+        for (auto p = 0; p < 6 && inside; ++p)
+        {
+            const auto& plane = pPlanes[p];
+            const auto d = plane.X * box.Center.x + plane.Y * box.Center.y + plane.Z * box.Center.z + plane.W;
+            const auto r = std::fabs(plane.X) * box.Extents.x
+                         + std::fabs(plane.Y) * box.Extents.y
+                         + std::fabs(plane.Z) * box.Extents.z;
+            inside = (d + r >= 0.0f);
+        }
+
+        if (inside)
+        {
+            pVisible[count++] = i;
+        }
+    }
+
+    return count;
+}
+
+} // namespace
+
+int main()
+{
+    const auto view     = XMMatrixTranslation(0.0f, 0.0f, 20.0f);
+    const auto proj     = XMMatrixPerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.5f, 200.0f);
+    const auto viewProj = XMMatrixMultiply(view, proj);
+
+    std::mt19937 random(29);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.0f, 2.0f);
+
+    FrustumCuller culler;
+    culler.Resize(BoxCount);
+    culler.SetFrustum(viewProj);
+
+    std::vector<Box> boxes(BoxCount);
+    for (auto i = 0u; i < BoxCount; ++i)
+    {
+        boxes[i].Center  = XMFLOAT3(position(random), position(random), position(random));
+        boxes[i].Extents = XMFLOAT3(size(random), size(random), size(random));
+        culler.SetBox(i, boxes[i].Center, boxes[i].Extents);
+    }
+
+    Plane planes[6];
+    GetPlanes(viewProj, planes);
+
+    std::vector<uint32_t> visible(BoxCount);
+
+    uint32_t simdCount = 0;
+    double   simdMs    = 0.0;
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        BenchTimer timer;
+        simdCount = culler.Cull(0, BoxCount, visible.data());
+        simdMs += timer.GetElapsedMs();
+    }
+    KeepAlive(visible[simdCount / 2]);
+
+    uint32_t scalarCount = 0;
+    double   scalarMs    = 0.0;
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        BenchTimer timer;
+        scalarCount = CullScalar(planes, boxes, visible.data());
+        scalarMs += timer.GetElapsedMs();
+    }
+    KeepAlive(visible[scalarCount / 2]);
+
+    printf("%8s %10s %12s %12s %8s\n", "boxes", "visible", "Cull ms", "scalar ms", "speedup");
+    printf("%8u %10u %12.3f %12.3f %8.2f\n",
+        BoxCount, simdCount, simdMs / Repeats, scalarMs / Repeats, scalarMs / simdMs);
+
+    // Both loops use the same planes; only rounding may differ.
+    if (simdCount != scalarCount)
+    {
+        printf("note : visible counts differ (scalar %u)\n", scalarCount);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include <TestUtil.h>
+#include <FrustumCuller.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace DirectX;
+
+namespace {
+
+// With an identity view-projection the frustum is clip space itself:
+// -1 <= x <= 1, -1 <= y <= 1 and 0 <= z <= 1.
+void SetClipSpace(FrustumCuller& culler)
+{
+    culler.SetFrustum(XMMatrixIdentity());
+}
+
+void SetBox(FrustumCuller& culler, uint32_t index, float x, float y, float z, float extent)
+{
+    culler.SetBox(index, XMFLOAT3(x, y, z), XMFLOAT3(extent, extent, extent));
+}
+
+// Per-box test with the planes taken from viewProj the way FrustumCuller
+// does, one box and one plane at a time.
+bool IsVisible(const XMFLOAT4X4& m, const XMFLOAT3& center, const XMFLOAT3& extents)
+{
+    // Column c of the row-vector matrix gives clip coordinate c.
+    float planes[6][4];
+    for (auto r = 0; r < 4; ++r)
+    {
+        planes[0][r] = m.m[r][3] + m.m[r][0];
+        planes[1][r] = m.m[r][3] - m.m[r][0];
+        planes[2][r] = m.m[r][3] + m.m[r][1];
+        planes[3][r] = m.m[r][3] - m.m[r][1];
+        planes[4][r] = m.m[r][2];
+        planes[5][r] = m.m[r][3] - m.m[r][2];
+    }
+
+    for (const auto& plane : planes)
+    {
+        const auto length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        const auto d = plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3];
+        const auto r = std::fabs(plane[0]) * extents.x + std::fabs(plane[1]) * extents.y + std::fabs(plane[2]) * extents.z;
+        if ((d + r) / length < 0.0f)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TestInsideOutside()
+{
+    FrustumCuller culler;
+    culler.Resize(8);
+    SetClipSpace(culler);
+
+    SetBox(culler, 0, 0.0f, 0.0f, 0.5f, 0.1f);     // inside
+    SetBox(culler, 1, 5.0f, 0.0f, 0.5f, 0.1f);     // right of the frustum
+    SetBox(culler, 2, 0.0f, -3.0f, 0.5f, 0.1f);    // below
+    SetBox(culler, 3, 0.0f, 0.0f, -1.0f, 0.5f);    // behind the near plane
+    SetBox(culler, 4, 0.0f, 0.0f, 2.0f, 0.5f);     // past the far plane
+    SetBox(culler, 5, 1.0f, 0.0f, 0.5f, 0.5f);     // straddles the right plane
+    SetBox(culler, 6, 0.0f, 0.0f, 0.0f, 0.25f);    // straddles the near plane
+    SetBox(culler, 7, 0.0f, 0.0f, 0.5f, 10.0f);    // contains the frustum
+
+    uint32_t visible[8] = {};
+    const auto count = culler.Cull(0, 8, visible);
+
+    CHECK(count == 4);
+    CHECK(visible[0] == 0);
+    CHECK(visible[1] == 5);
+    CHECK(visible[2] == 6);
+    CHECK(visible[3] == 7);
+}
+
+// Counts that are not a multiple of four leave padding lanes, and ranges
+// may start and end inside a group of four.
+void TestTail()
+{
+    const uint32_t counts[] = { 1, 2, 3, 5, 6, 7, 9, 13 };
+    for (auto count : counts)
+    {
+        FrustumCuller culler;
+        culler.Resize(count);
+        SetClipSpace(culler);
+
+        // Every other box inside.
+        for (auto i = 0u; i < count; ++i)
+        {
+            SetBox(culler, i, (i % 2 == 0) ? 0.0f : 5.0f, 0.0f, 0.5f, 0.1f);
+        }
+
+        for (auto begin = 0u; begin <= count; ++begin)
+        {
+            for (auto end = begin; end <= count + 2; ++end)
+            {
+                std::vector<uint32_t> visible(count + 4, UINT32_MAX);
+                const auto result = culler.Cull(begin, end, visible.data());
+
+                uint32_t expected = 0;
+                for (auto i = begin; i < end && i < count; ++i)
+                {
+                    if (i % 2 == 0)
+                    {
+                        CHECK(visible[expected] == i);
+                        ++expected;
+                    }
+                }
+
+                CHECK(result == expected);
+                CHECK(visible[expected] == UINT32_MAX);
+            }
+        }
+    }
+}
+
+// Padding lanes hold zero boxes at the origin, which lies on the near plane
+// of clip space. They must never be reported.
+void TestPaddingNeverVisible()
+{
+    FrustumCuller culler;
+    culler.Resize(5);
+    SetClipSpace(culler);
+
+    for (auto i = 0u; i < 5; ++i)
+    {
+        SetBox(culler, i, 5.0f, 5.0f, 5.0f, 0.1f);
+    }
+
+    uint32_t visible[8] = {};
+    CHECK(culler.Cull(0, 8, visible) == 0);
+
+    // Shrinking keeps the old boxes in the padding.
+    culler.Resize(8);
+    SetBox(culler, 6, 0.0f, 0.0f, 0.5f, 0.1f);
+    culler.Resize(5);
+    CHECK(culler.Cull(0, 8, visible) == 0);
+}
+
+// Random boxes against a perspective frustum match the per-box test.
+void TestMatchesScalar()
+{
+    const uint32_t count = 10001;
+
+    const auto view     = XMMatrixTranslation(0.0f, 0.0f, 20.0f);
+    const auto proj     = XMMatrixPerspectiveFovLH(1.0f, 16.0f / 9.0f, 0.5f, 100.0f);
+    const auto viewProj = XMMatrixMultiply(view, proj);
+
+    XMFLOAT4X4 m;
+    XMStoreFloat4x4(&m, viewProj);
+
+    FrustumCuller culler;
+    culler.Resize(count);
+    culler.SetFrustum(viewProj);
+
+    std::mt19937 random(23);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.0f, 5.0f);
+
+    std::vector<XMFLOAT3> centers(count);
+    std::vector<XMFLOAT3> extents(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        centers[i] = XMFLOAT3(position(random), position(random), position(random));
+        extents[i] = XMFLOAT3(size(random), size(random), size(random));
+        culler.SetBox(i, centers[i], extents[i]);
+    }
+
+    std::vector<uint32_t> visible(count);
+    const auto result = culler.Cull(0, count, visible.data());
+
+    uint32_t expected = 0;
+    bool     match    = true;
+    for (auto i = 0u; i < count; ++i)
+    {
+        if (IsVisible(m, centers[i], extents[i]))
+        {
+            match = match && (expected < result) && (visible[expected] == i);
+            ++expected;
+        }
+    }
+
+    CHECK(expected > 0 && expected < count);
+    CHECK(result == expected);
+    CHECK(match);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestInsideOutside);
+    RUN_TEST(TestTail);
+    RUN_TEST(TestPaddingNeverVisible);
+    RUN_TEST(TestMatchesScalar);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include <TestUtil.h>
+#include <GeometryAllocator.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+void TestInit()
+{
+    GeometryAllocator allocator;
+    CHECK(!allocator.Init(0, 16));
+    CHECK(!allocator.Init(16, 0));
+    CHECK(allocator.Init(16, 32));
+
+    // No page yet, so nothing fits.
+    GeometryRange range;
+    CHECK(!allocator.Alloc(1, 1, range));
+    CHECK(!range.IsValid());
+
+    CHECK(!allocator.AddPage(0, 32));
+    CHECK(allocator.GetPageCount() == 0);
+}
+
+void TestPageSize()
+{
+    GeometryAllocator allocator;
+    CHECK(allocator.Init(1000, 3000));
+
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    allocator.GetPageSizeFor(10, 30, vertexCount, indexCount);
+    CHECK(vertexCount == 1000 && indexCount == 3000);
+
+    // An oversized mesh gets a page of its own size in that dimension only.
+    allocator.GetPageSizeFor(5000, 30, vertexCount, indexCount);
+    CHECK(vertexCount == 5000 && indexCount == 3000);
+    allocator.GetPageSizeFor(10, 9000, vertexCount, indexCount);
+    CHECK(vertexCount == 1000 && indexCount == 9000);
+}
+
+void TestOffsets()
+{
+    GeometryAllocator allocator;
+    CHECK(allocator.Init(100, 300));
+    CHECK(allocator.AddPage(100, 300));
+
+    GeometryRange a, b;
+    CHECK(allocator.Alloc(40, 120, a));
+    CHECK(allocator.Alloc(60, 60, b));
+
+    CHECK(a.Page == 0 && b.Page == 0);
+    CHECK(a.GetBaseVertex() == 0 && a.GetFirstIndex() == 0 && a.GetIndexCount() == 120);
+    CHECK(b.GetBaseVertex() == 40 && b.GetFirstIndex() == 120 && b.GetIndexCount() == 60);
+    CHECK(allocator.GetUsedVertexCount() == 100);
+    CHECK(allocator.GetUsedIndexCount() == 180);
+
+    // Vertices are full even though indices are not.
+    GeometryRange c;
+    CHECK(!allocator.Alloc(1, 1, c));
+
+    allocator.Free(a);
+    CHECK(!a.IsValid());
+    CHECK(allocator.GetUsedVertexCount() == 60);
+
+    CHECK(allocator.Alloc(40, 100, c));
+    CHECK(c.GetBaseVertex() == 0 && c.GetFirstIndex() == 0);
+
+    // Freeing twice is a no-op.
+    allocator.Free(a);
+    CHECK(allocator.GetUsedVertexCount() == 100);
+}
+
+// A page that has room for the vertices but not the indices must not keep
+// the vertex range it took.
+void TestRollback()
+{
+    GeometryAllocator allocator;
+    CHECK(allocator.Init(100, 100));
+    CHECK(allocator.AddPage(100, 100));
+    CHECK(allocator.AddPage(100, 100));
+
+    GeometryRange a;
+    CHECK(allocator.Alloc(10, 90, a));
+    CHECK(a.Page == 0);
+
+    GeometryRange b;
+    CHECK(allocator.Alloc(10, 20, b));
+    CHECK(b.Page == 1);
+    CHECK(b.GetBaseVertex() == 0);
+
+    CHECK(allocator.GetUsedVertexCount() == 20);
+    CHECK(allocator.GetUsedIndexCount() == 110);
+
+    // Page 0 is still tried first.
+    GeometryRange c;
+    CHECK(allocator.Alloc(10, 10, c));
+    CHECK(c.Page == 0 && c.GetBaseVertex() == 10 && c.GetFirstIndex() == 90);
+}
+
+// Mirrors GeometryBuffer::Alloc(): on failure add a page of
+// GetPageSizeFor() and retry, which must then succeed.
+void TestGrowOnDemand()
+{
+    GeometryAllocator allocator;
+    CHECK(allocator.Init(1024, 4096));
+
+    std::vector<GeometryRange> ranges;
+    std::mt19937 random(7);
+    uint32_t vertexCount = 0;
+    uint32_t indexCount  = 0;
+
+    for (auto i = 0u; i < 2000; ++i)
+    {
+        if (!ranges.empty() && random() % 3 == 0)
+        {
+            const auto index = random() % ranges.size();
+            vertexCount -= ranges[index].Vertices.Count;
+            indexCount  -= ranges[index].Indices.Count;
+            allocator.Free(ranges[index]);
+            ranges[index] = ranges.back();
+            ranges.pop_back();
+            continue;
+        }
+
+        // Now and then a mesh bigger than a regular page.
+        const auto vertices = (i % 97 == 0) ? 3000 : 1 + random() % 200;
+        const auto indices  = (i % 89 == 0) ? 10000 : 3 + random() % 600;
+
+        GeometryRange range;
+        if (!allocator.Alloc(vertices, indices, range))
+        {
+            uint32_t pageVertexCount;
+            uint32_t pageIndexCount;
+            allocator.GetPageSizeFor(vertices, indices, pageVertexCount, pageIndexCount);
+            CHECK(allocator.AddPage(pageVertexCount, pageIndexCount));
+            CHECK(allocator.Alloc(vertices, indices, range));
+        }
+
+        CHECK(range.IsValid() && range.Page < allocator.GetPageCount());
+        CHECK(range.Vertices.Count == vertices && range.Indices.Count == indices);
+
+        vertexCount += vertices;
+        indexCount  += indices;
+        ranges.push_back(range);
+    }
+
+    CHECK(allocator.GetUsedVertexCount() == vertexCount);
+    CHECK(allocator.GetUsedIndexCount() == indexCount);
+
+    // Ranges in the same page never overlap.
+    for (size_t i = 0; i < ranges.size(); ++i)
+    {
+        for (size_t j = i + 1; j < ranges.size(); ++j)
+        {
+            if (ranges[i].Page != ranges[j].Page)
+            {
+                continue;
+            }
+
+            const auto& a = ranges[i];
+            const auto& b = ranges[j];
+            CHECK(a.Vertices.Offset + a.Vertices.Count <= b.Vertices.Offset
+               || b.Vertices.Offset + b.Vertices.Count <= a.Vertices.Offset);
+            CHECK(a.Indices.Offset + a.Indices.Count <= b.Indices.Offset
+               || b.Indices.Offset + b.Indices.Count <= a.Indices.Offset);
+        }
+    }
+
+    for (auto& range : ranges)
+    {
+        allocator.Free(range);
+    }
+
+    CHECK(allocator.GetUsedVertexCount() == 0);
+    CHECK(allocator.GetUsedIndexCount() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestInit);
+    RUN_TEST(TestPageSize);
+    RUN_TEST(TestOffsets);
+    RUN_TEST(TestRollback);
+    RUN_TEST(TestGrowOnDemand);
+
+    return GetTestResult();
+}
\ No newline at end of file
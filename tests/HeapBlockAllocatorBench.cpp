@@ -0,0 +1,93 @@
+#include <TestUtil.h>
+#include <HeapBlockAllocator.h>
+#include <random>
+#include <vector>
+
+// Placement throughput of HeapBlockAllocator for a mix of buffer and texture
+// sized requests, adding blocks on demand as GpuAllocator does, with the
+// reserved bytes per live requested byte and the fragmentation left behind.
+namespace {
+
+const uint64_t KB = 1024;
+const uint64_t MB = 1024 * KB;
+
+const uint32_t Operations = 1000000;
+
+void Run(uint64_t blockSize, uint32_t liveCount)
+{
+    HeapBlockAllocator allocator;
+    allocator.Init(blockSize, 64 * KB);
+
+    std::vector<HeapBlockAllocator::Allocation> live;
+    live.reserve(liveCount);
+    std::mt19937 random(5);
+
+    uint64_t requested = 0;
+    uint32_t blockCount = 0;
+    BenchTimer timer;
+
+    for (auto i = 0u; i < Operations; ++i)
+    {
+        if (live.size() >= liveCount || (!live.empty() && (random() & 1)))
+        {
+            const auto index = random() % live.size();
+            requested -= live[index].Size;
+            allocator.Free(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            continue;
+        }
+
+        // Mostly small buffers, some textures with 4MB alignment.
+        uint64_t size      = 1 + random() % (256 * KB);
+        uint64_t alignment = 64 * KB;
+        if (random() % 16 == 0)
+        {
+            size      = (1 + random() % 16) * MB;
+            alignment = 4 * MB;
+        }
+
+        HeapBlockAllocator::Allocation allocation;
+        if (!allocator.Alloc(size, alignment, allocation))
+        {
+            allocator.AddBlock(allocator.GetBlockSizeFor(size, alignment));
+            blockCount++;
+            allocator.Alloc(size, alignment, allocation);
+        }
+
+        requested += size;
+        live.push_back(allocation);
+    }
+
+    const auto elapsed = timer.GetElapsedMs();
+    const auto stats = allocator.GetStats();
+
+    printf("%8llu %8u %10.1f %8u %8u %10.1f %10.3f\n",
+        (unsigned long long)(blockSize / MB),
+        liveCount,
+        elapsed * 1.0e6 / Operations,
+        blockCount,
+        stats.BlockCount,
+        double(stats.ReservedBytes) / double(requested),
+        stats.GetFragmentation());
+}
+
+} // namespace
+
+int main()
+{
+    printf("%8s %8s %10s %8s %8s %10s %10s\n",
+        "blockMB", "live", "ns/op", "added", "blocks", "rsv/live", "fragment");
+
+    const uint64_t blockSizes[] = { 64 * MB, 256 * MB };
+    const uint32_t liveCounts[] = { 100, 1000, 10000 };
+    for (auto blockSize : blockSizes)
+    {
+        for (auto liveCount : liveCounts)
+        {
+            Run(blockSize, liveCount);
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <TestUtil.h>
+#include <HeapBlockAllocator.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+const uint64_t KB = 1024;
+const uint64_t MB = 1024 * KB;
+
+void TestInit()
+{
+    HeapBlockAllocator allocator;
+    CHECK(!allocator.Init(64 * MB, 0));
+    CHECK(!allocator.Init(64 * MB, 3000));
+    CHECK(!allocator.Init(32 * KB, 64 * KB));
+    CHECK(allocator.Init(64 * MB, 64 * KB));
+    CHECK(allocator.GetBlockSize() == 64 * MB);
+    CHECK(allocator.GetGranularity() == 64 * KB);
+
+    // No block yet.
+    HeapBlockAllocator::Allocation allocation;
+    CHECK(!allocator.Alloc(64 * KB, 64 * KB, allocation));
+    CHECK(!allocation.IsValid());
+
+    // Blocks must hold at least one unit.
+    CHECK(allocator.AddBlock(1 * KB) == HeapBlockAllocator::InvalidBlock);
+}
+
+void TestAllocFree()
+{
+    HeapBlockAllocator allocator;
+    CHECK(allocator.Init(1 * MB, 64 * KB));
+    CHECK(allocator.AddBlock(allocator.GetBlockSize()) == 0);
+
+    // Sizes round up to the granularity.
+    HeapBlockAllocator::Allocation a, b;
+    CHECK(allocator.Alloc(1, 0, a));
+    CHECK(a.Block == 0 && a.Offset == 0 && a.Size == 1);
+    CHECK(allocator.Alloc(100 * KB, 64 * KB, b));
+    CHECK(b.Offset == 64 * KB);
+
+    auto stats = allocator.GetStats();
+    CHECK(stats.BlockCount == 1);
+    CHECK(stats.AllocationCount == 2);
+    CHECK(stats.ReservedBytes == 1 * MB);
+    CHECK(stats.UsedBytes == 192 * KB);
+    CHECK(stats.LargestFreeBytes == 1 * MB - 192 * KB);
+    CHECK(stats.GetFragmentation() == 0.0f);
+
+    // Over the block size, with no other block.
+    HeapBlockAllocator::Allocation c;
+    CHECK(!allocator.Alloc(1 * MB, 64 * KB, c));
+
+    allocator.Free(a);
+    CHECK(!a.IsValid());
+    stats = allocator.GetStats();
+    CHECK(stats.AllocationCount == 1);
+    CHECK(stats.FreeRangeCount == 2);
+    CHECK(stats.GetFragmentation() > 0.0f);
+
+    allocator.Free(a);
+    CHECK(allocator.GetStats().AllocationCount == 1);
+
+    // Non power of two alignments are refused.
+    CHECK(!allocator.Alloc(64 * KB, 3 * 64 * KB, c));
+}
+
+// Alignment above the granularity is relative to the block start.
+void TestLargeAlignment()
+{
+    HeapBlockAllocator allocator;
+    CHECK(allocator.Init(16 * MB, 64 * KB));
+    CHECK(allocator.AddBlock(allocator.GetBlockSize()) == 0);
+
+    HeapBlockAllocator::Allocation small, aligned;
+    CHECK(allocator.Alloc(64 * KB, 64 * KB, small));
+    CHECK(allocator.Alloc(4 * MB, 4 * MB, aligned));
+    CHECK(aligned.Offset % (4 * MB) == 0);
+    CHECK(aligned.Offset >= small.Offset + 64 * KB);
+    CHECK(aligned.Offset + aligned.Size <= 16 * MB);
+
+    // The padding is counted as used.
+    CHECK(allocator.GetStats().UsedBytes >= 64 * KB + 4 * MB);
+}
+
+void TestBlocks()
+{
+    HeapBlockAllocator allocator;
+    CHECK(allocator.Init(1 * MB, 64 * KB));
+
+    // A request larger than a block gets a block of its own size.
+    CHECK(allocator.GetBlockSizeFor(64 * KB, 64 * KB) == 1 * MB);
+    CHECK(allocator.GetBlockSizeFor(3 * MB + 1, 64 * KB) == 3 * MB + 64 * KB);
+    CHECK(allocator.GetBlockSizeFor(64 * KB, 4 * MB) == 4 * MB);
+
+    const auto big = allocator.AddBlock(allocator.GetBlockSizeFor(3 * MB, 64 * KB));
+    CHECK(big == 0);
+    CHECK(allocator.AddBlock(1 * MB) == 1);
+    CHECK(allocator.AddBlock(1 * MB) == 2);
+
+    HeapBlockAllocator::Allocation a, b;
+    CHECK(allocator.Alloc(3 * MB, 64 * KB, a));
+    CHECK(a.Block == 0);
+    CHECK(allocator.Alloc(512 * KB, 64 * KB, b));
+    CHECK(b.Block == 1);
+
+    // Block 2 is empty; keeping one empty block releases nothing.
+    std::vector<uint32_t> released;
+    auto collect = [&released](uint32_t block) { released.push_back(block); };
+    CHECK(allocator.ReleaseEmptyBlocks(1, collect) == 0);
+
+    allocator.Free(a);
+    CHECK(allocator.ReleaseEmptyBlocks(1, collect) == 1);
+    CHECK(released.size() == 1 && released[0] == 2);
+    CHECK(allocator.GetStats().BlockCount == 2);
+
+    CHECK(allocator.ReleaseEmptyBlocks(0, collect) == 1);
+    CHECK(released.size() == 2 && released[1] == 0);
+
+    // Released indices are reused.
+    const auto index = allocator.AddBlock(1 * MB);
+    CHECK(index == 0 || index == 2);
+
+    allocator.Free(b);
+    CHECK(allocator.ReleaseEmptyBlocks(0, collect) == 2);
+    CHECK(allocator.GetStats().BlockCount == 0);
+    CHECK(allocator.GetStats().ReservedBytes == 0);
+}
+
+// Random placement of resource-like sizes, adding blocks on demand as
+// GpuAllocator does; allocations in a block must never overlap.
+void TestChurn()
+{
+    HeapBlockAllocator allocator;
+    CHECK(allocator.Init(8 * MB, 64 * KB));
+
+    std::vector<HeapBlockAllocator::Allocation> live;
+    std::mt19937 random(99);
+
+    for (auto i = 0u; i < 5000; ++i)
+    {
+        if (!live.empty() && random() % 5 < 2)
+        {
+            const auto index = random() % live.size();
+            allocator.Free(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+            continue;
+        }
+
+        const auto size      = 1 + random() % (2 * MB);
+        const auto alignment = (random() % 8 == 0) ? 4 * MB : 64 * KB;
+
+        HeapBlockAllocator::Allocation allocation;
+        if (!allocator.Alloc(size, alignment, allocation))
+        {
+            CHECK(allocator.AddBlock(allocator.GetBlockSizeFor(size, alignment)) != HeapBlockAllocator::InvalidBlock);
+            CHECK(allocator.Alloc(size, alignment, allocation));
+        }
+
+        CHECK(allocation.Offset % alignment == 0);
+        live.push_back(allocation);
+    }
+
+    CHECK(allocator.GetStats().AllocationCount == live.size());
+
+    for (size_t i = 0; i < live.size(); ++i)
+    {
+        for (size_t j = i + 1; j < live.size(); ++j)
+        {
+            const auto& a = live[i];
+            const auto& b = live[j];
+            if (a.Block == b.Block)
+            {
+                CHECK(a.Offset + a.Size <= b.Offset || b.Offset + b.Size <= a.Offset);
+            }
+        }
+    }
+
+    for (auto& allocation : live)
+    {
+        allocator.Free(allocation);
+    }
+
+    const auto stats = allocator.GetStats();
+    CHECK(stats.AllocationCount == 0);
+    CHECK(stats.UsedBytes == 0);
+    CHECK(stats.FreeRangeCount == stats.BlockCount);
+    CHECK(allocator.ReleaseEmptyBlocks(0, [](uint32_t) {}) == stats.BlockCount);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestInit);
+    RUN_TEST(TestAllocFree);
+    RUN_TEST(TestLargeAlignment);
+    RUN_TEST(TestBlocks);
+    RUN_TEST(TestChurn);
+
+    return GetTestResult();
+}
\ No newline at end of file
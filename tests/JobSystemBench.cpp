@@ -0,0 +1,95 @@
+#include <TestUtil.h>
+#include <JobSystem.h>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Scaling of JobSystem from 1 to N threads (N defaults to the hardware
+// thread count; pass another as the first argument), for
+//  - ParallelFor over a compute bound loop, like frustum culling, and
+//  - many tiny jobs, which measures the scheduling overhead per job.
+namespace {
+
+const uint32_t ItemCount = 1 << 20;
+const uint32_t JobCount  = 100000;
+
+double RunParallelFor(JobSystem& jobs, std::vector<float>& data)
+{
+    BenchTimer timer;
+    for (auto pass = 0; pass < 10; ++pass)
+    {
+        jobs.ParallelFor(ItemCount, 4096, [&data](uint32_t begin, uint32_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                auto x = data[i];
+                for (auto k = 0; k < 16; ++k)
+                {
+                    x = std::sqrt(x * x + 1.0f) * 0.5f;
+                }
+                data[i] = x;
+            }
+        });
+    }
+
+    return timer.GetElapsedMs() / 10.0;
+}
+
+double RunTinyJobs(JobSystem& jobs)
+{
+    std::atomic<uint32_t> count(0);
+    JobCounter counter;
+
+    BenchTimer timer;
+    for (auto i = 0u; i < JobCount; ++i)
+    {
+        jobs.Run([&count]() { count.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+
+    return timer.GetElapsedMs() * 1.0e6 / JobCount;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    auto maxThreads = std::thread::hardware_concurrency();
+    if (argc > 1)
+    {
+        maxThreads = uint32_t(atoi(argv[1]));
+    }
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+
+    std::vector<float> data(ItemCount, 1.0f);
+
+    printf("%8s %14s %10s %14s\n", "threads", "parallelFor ms", "speedup", "ns per job");
+
+    double baseline = 0.0;
+    for (auto threadCount = 1u; threadCount <= maxThreads; ++threadCount)
+    {
+        // Init(0) picks the hardware count; a system without workers runs
+        // every job on the caller, which is the single thread baseline.
+        JobSystem jobs;
+        if (threadCount > 1 && !jobs.Init(threadCount - 1))
+        {
+            break;
+        }
+
+        const auto elapsed = RunParallelFor(jobs, data);
+        const auto perJob  = RunTinyJobs(jobs);
+        if (threadCount == 1)
+        {
+            baseline = elapsed;
+        }
+
+        printf("%8u %14.2f %10.2f %14.1f\n", threadCount, elapsed, baseline / elapsed, perJob);
+    }
+
+    KeepAlive(uint64_t(data[ItemCount / 2]));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include <TestUtil.h>
+#include <JobSystem.h>
+#include <WorkStealingDeque.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void TestDequeSingleThread()
+{
+    WorkStealingDeque<int> deque;
+    CHECK(!deque.Init(0));
+    CHECK(!deque.Init(6));
+    CHECK(deque.Init(4));
+    CHECK(deque.IsEmpty());
+    CHECK(deque.Pop() == nullptr);
+    CHECK(deque.Steal() == nullptr);
+
+    int values[5] = { 0, 1, 2, 3, 4 };
+    for (auto i = 0; i < 4; ++i)
+    {
+        CHECK(deque.Push(&values[i]));
+    }
+
+    // Fixed capacity.
+    CHECK(!deque.Push(&values[4]));
+
+    // The owner pops the newest, thieves take the oldest.
+    CHECK(deque.Pop() == &values[3]);
+    CHECK(deque.Steal() == &values[0]);
+    CHECK(deque.Pop() == &values[2]);
+    CHECK(deque.Steal() == &values[1]);
+    CHECK(deque.IsEmpty());
+
+    // Wraps around the buffer.
+    for (auto round = 0; round < 3; ++round)
+    {
+        for (auto i = 0; i < 3; ++i)
+        {
+            CHECK(deque.Push(&values[i]));
+        }
+        CHECK(deque.Steal() == &values[0]);
+        CHECK(deque.Pop() == &values[2]);
+        CHECK(deque.Pop() == &values[1]);
+    }
+    CHECK(deque.Pop() == nullptr);
+}
+
+// The owner pushes and pops while thieves steal; every item must be taken
+// exactly once.
+void TestDequeConcurrent()
+{
+    const uint32_t ItemCount   = 200000;
+    const uint32_t ThiefCount  = 3;
+
+    WorkStealingDeque<uint32_t> deque;
+    CHECK(deque.Init(256));
+
+    std::vector<uint32_t> items(ItemCount);
+    std::vector<std::atomic<uint32_t>> taken(ItemCount);
+    for (auto i = 0u; i < ItemCount; ++i)
+    {
+        items[i] = i;
+        taken[i].store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic<bool> done(false);
+    std::vector<std::thread> thieves;
+    for (auto t = 0u; t < ThiefCount; ++t)
+    {
+        thieves.emplace_back([&]()
+        {
+            while (!done.load(std::memory_order_acquire) || !deque.IsEmpty())
+            {
+                auto pItem = deque.Steal();
+                if (pItem != nullptr)
+                {
+                    taken[*pItem].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (auto i = 0u; i < ItemCount; ++i)
+    {
+        while (!deque.Push(&items[i]))
+        {
+            auto pItem = deque.Pop();
+            if (pItem != nullptr)
+            {
+                taken[*pItem].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (i % 3 == 0)
+        {
+            auto pItem = deque.Pop();
+            if (pItem != nullptr)
+            {
+                taken[*pItem].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    for (auto pItem = deque.Pop(); pItem != nullptr; pItem = deque.Pop())
+    {
+        taken[*pItem].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    done.store(true, std::memory_order_release);
+    for (auto& thief : thieves)
+    {
+        thief.join();
+    }
+
+    uint32_t wrong = 0;
+    for (auto& count : taken)
+    {
+        wrong += (count.load() != 1) ? 1 : 0;
+    }
+    CHECK(wrong == 0);
+}
+
+void TestNoWorkers()
+{
+    // One thread per hardware thread, the caller included.
+    JobSystem jobs;
+    CHECK(jobs.Init(0));
+    const auto hardware = std::thread::hardware_concurrency();
+    CHECK(jobs.GetThreadCount() == ((hardware > 1) ? hardware : 1));
+    jobs.Term();
+
+    // Without workers a job runs on the calling thread right away.
+    int value = 0;
+    JobCounter counter;
+    jobs.Run([&value]() { value = 1; }, &counter);
+    CHECK(value == 1);
+    CHECK(counter.IsDone());
+}
+
+void TestRunWait()
+{
+    JobSystem jobs;
+    CHECK(jobs.Init(3));
+    CHECK(jobs.GetThreadCount() == 4);
+
+    // More jobs than the job pool holds: the rest run inline.
+    std::atomic<uint32_t> sum(0);
+    JobCounter counter;
+    for (auto i = 1u; i <= 10000; ++i)
+    {
+        jobs.Run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+    }
+
+    jobs.Wait(counter);
+    CHECK(counter.IsDone());
+    CHECK(sum.load() == 10000u * 10001u / 2);
+}
+
+// Jobs started from a job join the same counter before their parent finishes.
+void TestNestedJobs()
+{
+    JobSystem jobs;
+    CHECK(jobs.Init(3));
+
+    std::atomic<uint32_t> count(0);
+    JobCounter counter;
+    for (auto i = 0u; i < 64; ++i)
+    {
+        jobs.Run([&]()
+        {
+            for (auto j = 0u; j < 16; ++j)
+            {
+                jobs.Run([&count]() { count.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            count.fetch_add(1, std::memory_order_relaxed);
+        }, &counter);
+    }
+
+    jobs.Wait(counter);
+    CHECK(count.load() == 64 * 17);
+}
+
+// Threads outside the system go through the injection queue.
+void TestForeignThread()
+{
+    JobSystem jobs;
+    CHECK(jobs.Init(2));
+
+    std::atomic<uint32_t> count(0);
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < 4; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            JobCounter counter;
+            for (auto i = 0u; i < 500; ++i)
+            {
+                jobs.Run([&count]() { count.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            }
+            jobs.Wait(counter);
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(count.load() == 2000);
+}
+
+void TestParallelFor()
+{
+    JobSystem jobs;
+    CHECK(jobs.Init(3));
+
+    const uint32_t counts[] = { 0, 1, 63, 64, 65, 1000, 12345 };
+    for (auto count : counts)
+    {
+        std::vector<std::atomic<uint32_t>> visits(count);
+        for (auto& visit : visits)
+        {
+            visit.store(0, std::memory_order_relaxed);
+        }
+
+        jobs.ParallelFor(count, 64, [&visits](uint32_t begin, uint32_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                visits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        uint32_t wrong = 0;
+        for (auto& visit : visits)
+        {
+            wrong += (visit.load() != 1) ? 1 : 0;
+        }
+        CHECK(wrong == 0);
+    }
+
+    // A grain size of zero is treated as one.
+    std::atomic<uint32_t> sum(0);
+    jobs.ParallelFor(100, 0, [&sum](uint32_t begin, uint32_t end) { sum.fetch_add(end - begin); });
+    CHECK(sum.load() == 100);
+}
+
+void TestReinit()
+{
+    JobSystem jobs;
+    for (auto i = 0u; i < 3; ++i)
+    {
+        CHECK(jobs.Init(2));
+
+        std::atomic<uint32_t> count(0);
+        jobs.ParallelFor(1000, 10, [&count](uint32_t begin, uint32_t end) { count.fetch_add(end - begin); });
+        CHECK(count.load() == 1000);
+
+        jobs.Term();
+    }
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestDequeSingleThread);
+    RUN_TEST(TestDequeConcurrent);
+    RUN_TEST(TestNoWorkers);
+    RUN_TEST(TestRunWait);
+    RUN_TEST(TestNestedJobs);
+    RUN_TEST(TestForeignThread);
+    RUN_TEST(TestParallelFor);
+    RUN_TEST(TestReinit);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,191 @@
+#include <TestUtil.h>
+#include <MagazinePool.h>
+#include <LockFreePool.h>
+#include <atomic>
+#include <condition_variable>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Value
+{
+    uint32_t    Owner;
+    uint32_t    Serial;
+};
+
+void TestSingleThread()
+{
+    MagazinePool<Value> pool;
+    CHECK(pool.Init(16));
+
+    Value* values[16] = {};
+    CHECK(pool.AllocN(16, values) == 16);
+    CHECK(pool.Alloc() == nullptr);
+    CHECK(pool.GetUsedCount() == 16);
+
+    std::set<Value*> unique(values, values + 16);
+    CHECK(unique.size() == 16);
+
+    // Freed items stay in the thread's magazine but count as available.
+    pool.FreeN(values, 16);
+    CHECK(pool.GetUsedCount() == 0);
+    CHECK(pool.GetAvailableCount() == 16);
+    CHECK(pool.GetReservedCount() == 16);
+
+    pool.Flush();
+    CHECK(pool.GetReservedCount() == 0);
+}
+
+// Items parked in another live thread's magazine are taken back before the
+// pool reports exhaustion.
+void TestDrainLiveThread()
+{
+    MagazinePool<Value> pool;
+    CHECK(pool.Init(16));
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool parked   = false;
+    bool finished = false;
+
+    std::thread owner([&]()
+    {
+        Value* values[16] = {};
+        CHECK(pool.AllocN(16, values) == 16);
+        pool.FreeN(values, 16);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        parked = true;
+        cond.notify_all();
+        cond.wait(lock, [&]() { return finished; });
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [&]() { return parked; });
+    }
+
+    Value* values[16] = {};
+    CHECK(pool.AllocN(16, values) == 16);
+    CHECK(pool.GetUsedCount() == 16);
+    pool.FreeN(values, 16);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished = true;
+    }
+    cond.notify_all();
+    owner.join();
+
+    CHECK(pool.GetUsedCount() == 0);
+}
+
+// A thread that exits returns its magazine to the pool.
+void TestThreadExit()
+{
+    MagazinePool<Value> pool;
+    CHECK(pool.Init(16));
+
+    for (auto round = 0u; round < 4; ++round)
+    {
+        std::thread worker([&pool]()
+        {
+            Value* values[16] = {};
+            CHECK(pool.AllocN(16, values) == 16);
+            pool.FreeN(values, 16);
+        });
+        worker.join();
+
+        CHECK(pool.GetReservedCount() == 0);
+    }
+
+    Value* values[16] = {};
+    CHECK(pool.AllocN(16, values) == 16);
+    pool.FreeN(values, 16);
+}
+
+// A thread meeting many short-lived pools must keep working; slots of
+// destroyed pools are dropped rather than reused.
+void TestPoolLifetime()
+{
+    for (auto i = 0u; i < 200; ++i)
+    {
+        MagazinePool<Value> pool;
+        CHECK(pool.Init(4));
+
+        Value* values[4] = {};
+        CHECK(pool.AllocN(4, values) == 4);
+        CHECK(pool.Alloc() == nullptr);
+        pool.FreeN(values, 4);
+        CHECK(pool.GetUsedCount() == 0);
+    }
+}
+
+template<typename TPool>
+void TestConcurrent()
+{
+    const uint32_t ThreadCount = 8;
+    const uint32_t Iterations  = 5000;
+    const uint32_t HoldCount   = 4;
+
+    TPool pool;
+
+    // Fewer items than the threads could park, so draining is exercised.
+    CHECK(pool.Init(ThreadCount * HoldCount));
+
+    std::atomic<uint32_t> errorCount(0);
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < ThreadCount; ++t)
+    {
+        threads.emplace_back([&pool, &errorCount, t]()
+        {
+            Value* values[HoldCount];
+            for (auto i = 0u; i < Iterations; ++i)
+            {
+                const auto n = pool.AllocN(HoldCount, values);
+                for (auto j = 0u; j < n; ++j)
+                {
+                    values[j]->Owner  = t;
+                    values[j]->Serial = i;
+                }
+
+                std::this_thread::yield();
+
+                for (auto j = 0u; j < n; ++j)
+                {
+                    if (values[j]->Owner != t || values[j]->Serial != i)
+                    {
+                        errorCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                pool.FreeN(values, n);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(errorCount.load() == 0);
+    CHECK(pool.GetUsedCount() == 0);
+    CHECK(pool.GetReservedCount() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestSingleThread);
+    RUN_TEST(TestDrainLiveThread);
+    RUN_TEST(TestThreadExit);
+    RUN_TEST(TestPoolLifetime);
+    RUN_TEST(TestConcurrent<MagazinePool<Value>>);
+    RUN_TEST((TestConcurrent<MagazinePool<Value, LockFreePool<Value>>>));
+
+    return GetTestResult();
+}
\ No newline at end of file
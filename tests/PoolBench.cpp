@@ -0,0 +1,79 @@
+#include <TestUtil.h>
+#include <LockFreePool.h>
+#include <Pool.h>
+#include <thread>
+#include <vector>
+
+// Contention benchmark of the mutex Pool<T> against LockFreePool<T>: every
+// thread allocates a few items, touches them and frees them again, as the
+// descriptor pools do when several threads record at once.
+namespace {
+
+struct Value
+{
+    uint64_t Data[4];
+};
+
+const uint32_t OpsPerThread = 200000;
+const uint32_t HoldCount    = 4;
+
+template<typename TPool>
+double Run(uint32_t threadCount)
+{
+    TPool pool;
+    if (!pool.Init(threadCount * HoldCount))
+    {
+        return 0.0;
+    }
+
+    std::vector<std::thread> threads;
+    BenchTimer timer;
+
+    for (auto t = 0u; t < threadCount; ++t)
+    {
+        threads.emplace_back([&pool]()
+        {
+            Value* values[HoldCount];
+            uint64_t sum = 0;
+            for (auto i = 0u; i < OpsPerThread; i += HoldCount)
+            {
+                for (auto j = 0u; j < HoldCount; ++j)
+                {
+                    values[j] = pool.Alloc();
+                    values[j]->Data[0] = i + j;
+                }
+
+                for (auto j = 0u; j < HoldCount; ++j)
+                {
+                    sum += values[j]->Data[0];
+                    pool.Free(values[j]);
+                }
+            }
+            KeepAlive(sum);
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Mega operations per second over all threads; an op is one Alloc + Free.
+    return double(threadCount) * OpsPerThread / (timer.GetElapsedMs() * 1000.0);
+}
+
+} // namespace
+
+int main()
+{
+    printf("%8s %16s %18s\n", "threads", "Pool (Mops/s)", "LockFree (Mops/s)");
+
+    for (auto threadCount = 1u; threadCount <= 32; threadCount *= 2)
+    {
+        const auto locked   = Run<Pool<Value>>(threadCount);
+        const auto lockFree = Run<LockFreePool<Value>>(threadCount);
+        printf("%8u %16.2f %18.2f\n", threadCount, locked, lockFree);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include <TestUtil.h>
+#include <LockFreePool.h>
+#include <Pool.h>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Value
+{
+    uint32_t    Owner;
+    uint32_t    Serial;
+};
+
+template<POOL_LAYOUT Layout>
+void TestAllocUntilExhausted()
+{
+    LockFreePool<Value, Layout> pool;
+    CHECK(pool.Init(64));
+    CHECK(pool.GetSize() == 64);
+
+    std::vector<Value*> values;
+    std::set<uint32_t> indices;
+    for (auto i = 0u; i < 64; ++i)
+    {
+        uint32_t index = uint32_t(-1);
+        auto pValue = pool.Alloc([&](uint32_t idx, Value*) { index = idx; });
+        CHECK(pValue != nullptr);
+        CHECK(pool.GetIndex(pValue) == index);
+        CHECK(index < 64);
+        indices.insert(index);
+        values.push_back(pValue);
+    }
+
+    CHECK(indices.size() == 64);
+    CHECK(pool.GetUsedCount() == 64);
+    CHECK(pool.GetAvailableCount() == 0);
+    CHECK(pool.Alloc() == nullptr);
+
+    pool.Free(values[10]);
+    CHECK(pool.GetUsedCount() == 63);
+
+    auto pValue = pool.Alloc();
+    CHECK(pValue == values[10]);
+
+    for (auto p : values)
+    {
+        pool.Free(p);
+    }
+    CHECK(pool.GetUsedCount() == 0);
+
+    pool.Free(nullptr);
+    CHECK(pool.GetUsedCount() == 0);
+}
+
+void TestInitRejectsZero()
+{
+    LockFreePool<Value> pool;
+    CHECK(!pool.Init(0));
+    CHECK(pool.Alloc() == nullptr);
+}
+
+void TestAllocNFreeN()
+{
+    LockFreePool<Value> pool;
+    CHECK(pool.Init(16));
+
+    Value* values[32] = {};
+    CHECK(pool.AllocN(10, values) == 10);
+    CHECK(pool.GetUsedCount() == 10);
+
+    // Only what is left comes back.
+    CHECK(pool.AllocN(32, values + 10) == 6);
+    CHECK(pool.GetUsedCount() == 16);
+    CHECK(pool.AllocN(1, values + 16) == 0);
+
+    std::set<Value*> unique(values, values + 16);
+    CHECK(unique.size() == 16);
+
+    // nullptr entries are skipped.
+    values[3] = nullptr;
+    pool.FreeN(values, 16);
+    CHECK(pool.GetUsedCount() == 1);
+
+    CHECK(pool.AllocN(0, values) == 0);
+    CHECK(pool.AllocN(15, values) == 15);
+    CHECK(pool.GetAvailableCount() == 0);
+}
+
+// Every thread stamps the items it owns and checks the stamp is still there
+// before freeing, so an item handed to two threads at once shows up. The
+// used count must never exceed the capacity while items move.
+void TestConcurrentAllocFree()
+{
+    const uint32_t ThreadCount = 8;
+    const uint32_t Iterations  = 20000;
+    const uint32_t BatchSize   = 8;
+
+    LockFreePool<Value> pool;
+    CHECK(pool.Init(ThreadCount * BatchSize));
+
+    std::atomic<uint32_t> errorCount(0);
+    std::atomic<uint32_t> overCount(0);
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < ThreadCount; ++t)
+    {
+        threads.emplace_back([&pool, &errorCount, &overCount, t]()
+        {
+            Value* values[BatchSize];
+            for (auto i = 0u; i < Iterations; ++i)
+            {
+                uint32_t n = 0;
+                if (i & 1)
+                {
+                    n = pool.AllocN(BatchSize, values);
+                }
+                else
+                {
+                    while (n < BatchSize && (values[n] = pool.Alloc()) != nullptr)
+                    {
+                        n++;
+                    }
+                }
+
+                for (auto j = 0u; j < n; ++j)
+                {
+                    values[j]->Owner  = t;
+                    values[j]->Serial = i;
+                }
+
+                if (pool.GetUsedCount() > pool.GetSize() || pool.GetAvailableCount() > pool.GetSize())
+                {
+                    overCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                std::this_thread::yield();
+
+                for (auto j = 0u; j < n; ++j)
+                {
+                    if (values[j]->Owner != t || values[j]->Serial != i)
+                    {
+                        errorCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                if (i & 2)
+                {
+                    pool.FreeN(values, n);
+                }
+                else
+                {
+                    for (auto j = 0u; j < n; ++j)
+                    {
+                        pool.Free(values[j]);
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CHECK(errorCount.load() == 0);
+    CHECK(overCount.load() == 0);
+    CHECK(pool.GetUsedCount() == 0);
+
+    // The free list must still hold every item exactly once.
+    std::vector<Value*> values(ThreadCount * BatchSize);
+    CHECK(pool.AllocN(uint32_t(values.size()), values.data()) == values.size());
+    std::set<Value*> unique(values.begin(), values.end());
+    CHECK(unique.size() == values.size());
+}
+
+void TestMutexPoolMatches()
+{
+    Pool<Value, POOL_LAYOUT_SOA> pool;
+    CHECK(pool.Init(8));
+
+    Value* values[8] = {};
+    CHECK(pool.AllocN(8, values) == 8);
+    CHECK(pool.Alloc() == nullptr);
+
+    for (auto i = 0u; i < 8; ++i)
+    {
+        CHECK(pool.GetIndex(values[i]) < 8);
+    }
+
+    pool.FreeN(values, 8);
+    CHECK(pool.GetUsedCount() == 0);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestAllocUntilExhausted<POOL_LAYOUT_AOS>);
+    RUN_TEST(TestAllocUntilExhausted<POOL_LAYOUT_SOA>);
+    RUN_TEST(TestInitRejectsZero);
+    RUN_TEST(TestAllocNFreeN);
+    RUN_TEST(TestConcurrentAllocFree);
+    RUN_TEST(TestMutexPoolMatches);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <TestUtil.h>
+#include <RadixSort.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// RadixSorter against std::sort on an index array, the way render items
+// were sorted before, at 1k to 100k items. Keys are either random or shaped
+// like render item keys (few states, depth in the low bits).
+namespace {
+
+const uint32_t Repeats = 20;
+
+void MakeKeys(std::vector<uint64_t>& keys, bool renderLike, std::mt19937_64& random)
+{
+    for (auto& key : keys)
+    {
+        if (renderLike)
+        {
+            const auto pso      = random() % 4;
+            const auto material = random() % 64;
+            const auto mesh     = random() % 256;
+            const auto depth    = random() & 0xfffff;
+            key = (pso << 56) | (material << 40) | (mesh << 20) | depth;
+        }
+        else
+        {
+            key = random();
+        }
+    }
+}
+
+void Run(uint32_t count, bool renderLike)
+{
+    std::mt19937_64 random(17);
+    std::vector<uint64_t> source(count);
+    MakeKeys(source, renderLike, random);
+
+    RadixSorter sorter;
+    std::vector<uint64_t> keys;
+    std::vector<uint32_t> values(count);
+
+    double radixMs = 0.0;
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        keys = source;
+        std::iota(values.begin(), values.end(), 0u);
+
+        BenchTimer timer;
+        sorter.Sort(keys, values);
+        radixMs += timer.GetElapsedMs();
+    }
+    KeepAlive(values[count / 2]);
+
+    double stdMs = 0.0;
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        std::iota(values.begin(), values.end(), 0u);
+
+        BenchTimer timer;
+        std::sort(values.begin(), values.end(), [&source](uint32_t a, uint32_t b)
+        {
+            return source[a] < source[b];
+        });
+        stdMs += timer.GetElapsedMs();
+    }
+    KeepAlive(values[count / 2]);
+
+    printf("%8u %8s %12.3f %12.3f %8.2f\n",
+        count, renderLike ? "render" : "random",
+        radixMs / Repeats, stdMs / Repeats, stdMs / radixMs);
+}
+
+} // namespace
+
+int main()
+{
+    printf("%8s %8s %12s %12s %8s\n", "items", "keys", "radix ms", "std::sort ms", "speedup");
+
+    const uint32_t counts[] = { 1000, 10000, 100000 };
+    for (auto count : counts)
+    {
+        Run(count, true);
+        Run(count, false);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <TestUtil.h>
+#include <RadixSort.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Sorts the same data with std::stable_sort and compares keys and values.
+bool SortMatches(RadixSorter& sorter, std::vector<uint64_t> keys)
+{
+    std::vector<uint32_t> values(keys.size());
+    std::vector<std::pair<uint64_t, uint32_t>> expected(keys.size());
+    for (uint32_t i = 0; i < uint32_t(keys.size()); ++i)
+    {
+        values[i]   = i;
+        expected[i] = std::make_pair(keys[i], i);
+    }
+
+    std::stable_sort(expected.begin(), expected.end(),
+        [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b)
+        {
+            return a.first < b.first;
+        });
+
+    sorter.Sort(keys, values);
+
+    if (keys.size() != expected.size() || values.size() != expected.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        if (keys[i] != expected[i].first || values[i] != expected[i].second)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void TestSmall()
+{
+    RadixSorter sorter;
+    CHECK(SortMatches(sorter, {}));
+    CHECK(SortMatches(sorter, { 42 }));
+    CHECK(SortMatches(sorter, { 2, 1 }));
+    CHECK(SortMatches(sorter, { 1, 1, 1 }));
+    CHECK(SortMatches(sorter, { UINT64_MAX, 0, uint64_t(1) << 63, 1 }));
+}
+
+void TestRandom()
+{
+    RadixSorter sorter;
+    std::mt19937_64 random(11);
+
+    const uint32_t counts[] = { 2, 3, 100, 1000, 100000 };
+    for (auto count : counts)
+    {
+        std::vector<uint64_t> keys(count);
+        for (auto& key : keys)
+        {
+            key = random();
+        }
+        CHECK(SortMatches(sorter, keys));
+    }
+}
+
+// Keys with many duplicates and only a few bytes in use, as render item
+// keys are: skipped passes must not break the order or stability.
+void TestSparseKeys()
+{
+    RadixSorter sorter;
+    std::mt19937_64 random(12);
+
+    const uint32_t shifts[] = { 0, 8, 20, 40, 56 };
+    for (auto shift : shifts)
+    {
+        std::vector<uint64_t> keys(5000);
+        for (auto& key : keys)
+        {
+            key = uint64_t(random() % 37) << shift;
+        }
+        CHECK(SortMatches(sorter, keys));
+    }
+
+    // Every key equal: nothing moves.
+    std::vector<uint64_t> keys(1000, 0x0123456789abcdefull);
+    CHECK(SortMatches(sorter, keys));
+}
+
+void TestSortedInput()
+{
+    RadixSorter sorter;
+
+    std::vector<uint64_t> ascending(10000);
+    std::vector<uint64_t> descending(10000);
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        ascending[i]  = uint64_t(i) * 0x10001;
+        descending[i] = uint64_t(10000 - i) * 0x10001;
+    }
+
+    CHECK(SortMatches(sorter, ascending));
+    CHECK(SortMatches(sorter, descending));
+}
+
+// The scratch buffers are reused between calls of different sizes.
+void TestReuse()
+{
+    RadixSorter sorter;
+    std::mt19937_64 random(13);
+
+    const uint32_t counts[] = { 1000, 10, 5000, 3 };
+    for (auto count : counts)
+    {
+        std::vector<uint64_t> keys(count);
+        for (auto& key : keys)
+        {
+            key = random() >> (random() % 64);
+        }
+        CHECK(SortMatches(sorter, keys));
+    }
+
+    sorter.Term();
+    CHECK(SortMatches(sorter, { 3, 2, 1 }));
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestSmall);
+    RUN_TEST(TestRandom);
+    RUN_TEST(TestSparseKeys);
+    RUN_TEST(TestSortedInput);
+    RUN_TEST(TestReuse);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <TestUtil.h>
+#include <RangeAllocator.h>
+#include <random>
+#include <vector>
+
+// Allocation throughput of RangeAllocator under random churn at several
+// fill levels, with the fragmentation left behind.
+namespace {
+
+const uint32_t Size       = 1 << 20;
+const uint32_t Operations = 2000000;
+
+void Run(uint32_t maxCount, uint32_t targetFill)
+{
+    RangeAllocator allocator;
+    allocator.Init(Size);
+
+    std::vector<RangeAllocator::Allocation> live;
+    live.reserve(Size);
+    std::mt19937 random(42);
+
+    // Fill up to the target before timing.
+    const auto target = uint64_t(Size) * targetFill / 100;
+    while (allocator.GetUsedCount() < target)
+    {
+        RangeAllocator::Allocation allocation;
+        if (!allocator.Alloc(1 + random() % maxCount, allocation))
+        {
+            break;
+        }
+        live.push_back(allocation);
+    }
+
+    uint32_t failed = 0;
+    BenchTimer timer;
+
+    for (auto i = 0u; i < Operations; ++i)
+    {
+        if ((i & 1) == 0)
+        {
+            RangeAllocator::Allocation allocation;
+            if (allocator.Alloc(1 + random() % maxCount, allocation))
+            {
+                live.push_back(allocation);
+            }
+            else
+            {
+                failed++;
+            }
+        }
+        else if (!live.empty())
+        {
+            const auto index = random() % live.size();
+            allocator.Free(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    const auto elapsed = timer.GetElapsedMs();
+    const auto freeCount = allocator.GetFreeCount();
+    const auto fragmentation = (freeCount > 0)
+        ? 1.0 - double(allocator.GetLargestFreeRange()) / double(freeCount) : 0.0;
+
+    printf("%9u %6u%% %12.1f %10u %12u %10.3f\n",
+        maxCount, targetFill,
+        elapsed * 1.0e6 / Operations,
+        failed,
+        allocator.GetFreeRangeCount(),
+        fragmentation);
+}
+
+} // namespace
+
+int main()
+{
+    printf("%9s %7s %12s %10s %12s %10s\n",
+        "maxCount", "fill", "ns/op", "failed", "freeRanges", "fragment");
+
+    const uint32_t maxCounts[] = { 1, 16, 256 };
+    const uint32_t fills[]     = { 25, 50, 90 };
+    for (auto maxCount : maxCounts)
+    {
+        for (auto fill : fills)
+        {
+            Run(maxCount, fill);
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
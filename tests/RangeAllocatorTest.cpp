@@ -0,0 +1,283 @@
+#include <TestUtil.h>
+#include <RangeAllocator.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Marks the ranges handed out and reports overlaps or out of bounds ranges.
+class Occupancy
+{
+public:
+    explicit Occupancy(uint32_t size)
+        : m_Used(size, false)
+    {
+    }
+
+    bool Mark(const RangeAllocator::Allocation& allocation, bool used)
+    {
+        if (allocation.Offset + allocation.Count > m_Used.size())
+        {
+            return false;
+        }
+
+        for (auto i = allocation.Offset; i < allocation.Offset + allocation.Count; ++i)
+        {
+            if (m_Used[i] == used)
+            {
+                return false;
+            }
+            m_Used[i] = used;
+        }
+
+        return true;
+    }
+
+    // Number of maximal free runs and the longest one.
+    void GetFreeRuns(uint32_t& count, uint32_t& largest) const
+    {
+        count   = 0;
+        largest = 0;
+
+        uint32_t run = 0;
+        for (auto used : m_Used)
+        {
+            if (!used)
+            {
+                if (run++ == 0)
+                {
+                    count++;
+                }
+                largest = (run > largest) ? run : largest;
+            }
+            else
+            {
+                run = 0;
+            }
+        }
+    }
+
+private:
+    std::vector<bool> m_Used;
+};
+
+void CheckMatches(const RangeAllocator& allocator, const Occupancy& occupancy)
+{
+    uint32_t count;
+    uint32_t largest;
+    occupancy.GetFreeRuns(count, largest);
+
+    CHECK(allocator.GetFreeRangeCount() == count);
+    CHECK(allocator.GetLargestFreeRange() == largest);
+}
+
+void TestAllocFree()
+{
+    RangeAllocator allocator;
+    CHECK(allocator.Init(100));
+    CHECK(allocator.GetSize() == 100);
+    CHECK(allocator.GetFreeRangeCount() == 1);
+
+    RangeAllocator::Allocation a, b, c;
+    CHECK(allocator.Alloc(10, a));
+    CHECK(allocator.Alloc(20, b));
+    CHECK(allocator.Alloc(70, c));
+    CHECK(a.Offset == 0 && a.Count == 10);
+    CHECK(b.Offset == 10 && b.Count == 20);
+    CHECK(c.Offset == 30 && c.Count == 70);
+    CHECK(allocator.GetUsedCount() == 100);
+    CHECK(allocator.GetFreeRangeCount() == 0);
+    CHECK(allocator.GetLargestFreeRange() == 0);
+
+    RangeAllocator::Allocation d;
+    CHECK(!allocator.Alloc(1, d));
+    CHECK(!d.IsValid());
+    CHECK(!allocator.Alloc(0, d));
+
+    allocator.Free(b);
+    CHECK(!b.IsValid());
+    CHECK(allocator.GetUsedCount() == 80);
+    CHECK(allocator.GetLargestFreeRange() == 20);
+
+    // Freeing an invalid allocation is a no-op.
+    allocator.Free(b);
+    CHECK(allocator.GetUsedCount() == 80);
+}
+
+void TestCoalesce()
+{
+    RangeAllocator allocator;
+    CHECK(allocator.Init(64));
+
+    RangeAllocator::Allocation ranges[8];
+    for (auto& range : ranges)
+    {
+        CHECK(allocator.Alloc(8, range));
+    }
+
+    // Free every other range: four separate holes.
+    for (auto i = 0u; i < 8; i += 2)
+    {
+        allocator.Free(ranges[i]);
+    }
+    CHECK(allocator.GetFreeRangeCount() == 4);
+    CHECK(allocator.GetLargestFreeRange() == 8);
+
+    // 32 units are free but not contiguous.
+    RangeAllocator::Allocation big;
+    CHECK(allocator.GetFreeCount() == 32);
+    CHECK(!allocator.Alloc(16, big));
+
+    // Freeing a range between two holes merges all three.
+    allocator.Free(ranges[1]);
+    CHECK(allocator.GetFreeRangeCount() == 3);
+    CHECK(allocator.GetLargestFreeRange() == 24);
+    CHECK(allocator.Alloc(16, big));
+    CHECK(big.Offset == 0);
+    allocator.Free(big);
+
+    for (auto i = 3u; i < 8; i += 2)
+    {
+        allocator.Free(ranges[i]);
+    }
+    CHECK(allocator.GetUsedCount() == 0);
+    CHECK(allocator.GetFreeRangeCount() == 1);
+    CHECK(allocator.GetLargestFreeRange() == 64);
+}
+
+// A request larger than every range of its own class still finds a fitting
+// range in a larger class.
+void TestSizeClasses()
+{
+    RangeAllocator allocator;
+    CHECK(allocator.Init(1024));
+
+    RangeAllocator::Allocation pad[4], hole[3];
+    CHECK(allocator.Alloc(17, hole[0]));    // class 4
+    CHECK(allocator.Alloc(1, pad[0]));
+    CHECK(allocator.Alloc(20, hole[1]));    // class 4
+    CHECK(allocator.Alloc(1, pad[1]));
+    CHECK(allocator.Alloc(40, hole[2]));    // class 5
+    CHECK(allocator.Alloc(1, pad[2]));
+    CHECK(allocator.Alloc(1024 - 80, pad[3]));
+    CHECK(allocator.GetFreeCount() == 0);
+
+    allocator.Free(hole[0]);
+    allocator.Free(hole[1]);
+    allocator.Free(hole[2]);
+
+    RangeAllocator::Allocation a;
+    CHECK(allocator.Alloc(20, a));
+    CHECK(a.Offset == 18);
+    allocator.Free(a);
+
+    CHECK(allocator.Alloc(30, a));
+    CHECK(a.Offset == 39);
+    allocator.Free(a);
+
+    CHECK(!allocator.Alloc(41, a));
+}
+
+void TestGrow()
+{
+    RangeAllocator allocator;
+    CHECK(allocator.Init(0));
+    CHECK(allocator.GetSize() == 0);
+
+    RangeAllocator::Allocation a, b;
+    CHECK(!allocator.Alloc(1, a));
+
+    CHECK(allocator.Grow(16));
+    CHECK(allocator.Alloc(16, a));
+
+    // Grown space behind a used range is a new free range.
+    CHECK(allocator.Grow(32));
+    CHECK(allocator.GetFreeRangeCount() == 1);
+    CHECK(allocator.Alloc(16, b));
+    CHECK(b.Offset == 16);
+
+    // Shrinking is refused; growing to the same size is not an error.
+    CHECK(!allocator.Grow(8));
+    CHECK(allocator.Grow(32));
+    CHECK(allocator.GetSize() == 32);
+}
+
+// Random churn checked against a shadow occupancy map: no range is handed
+// out twice, and the free range statistics match the actual holes.
+void TestFragmentationChurn()
+{
+    const uint32_t Size = 4096;
+
+    RangeAllocator allocator;
+    CHECK(allocator.Init(Size));
+
+    Occupancy occupancy(Size);
+    std::vector<RangeAllocator::Allocation> live;
+    std::mt19937 random(1234);
+    uint32_t used = 0;
+    uint32_t failed = 0;
+
+    for (auto i = 0u; i < 20000; ++i)
+    {
+        if (live.empty() || random() % 100 < 55)
+        {
+            const auto count = 1 + random() % 64;
+
+            RangeAllocator::Allocation allocation;
+            if (allocator.Alloc(count, allocation))
+            {
+                CHECK(allocation.Count == count);
+                CHECK(occupancy.Mark(allocation, true));
+                used += count;
+                live.push_back(allocation);
+            }
+            else
+            {
+                // Only fails when no hole is big enough.
+                CHECK(allocator.GetLargestFreeRange() < count);
+                failed++;
+            }
+        }
+        else
+        {
+            const auto index = random() % live.size();
+            CHECK(occupancy.Mark(live[index], false));
+            used -= live[index].Count;
+            allocator.Free(live[index]);
+            live[index] = live.back();
+            live.pop_back();
+        }
+
+        CHECK(allocator.GetUsedCount() == used);
+
+        if (i % 500 == 0)
+        {
+            CheckMatches(allocator, occupancy);
+        }
+    }
+
+    CheckMatches(allocator, occupancy);
+    CHECK(failed > 0);
+
+    for (auto& allocation : live)
+    {
+        allocator.Free(allocation);
+    }
+
+    CHECK(allocator.GetUsedCount() == 0);
+    CHECK(allocator.GetFreeRangeCount() == 1);
+    CHECK(allocator.GetLargestFreeRange() == Size);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestAllocFree);
+    RUN_TEST(TestCoalesce);
+    RUN_TEST(TestSizeClasses);
+    RUN_TEST(TestGrow);
+    RUN_TEST(TestFragmentationChurn);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <TestUtil.h>
+#include <RetireQueue.h>
+#include <memory>
+#include <vector>
+
+namespace {
+
+void TestCollectOrder()
+{
+    RetireQueue queue;
+    FakeFence fence;
+    std::vector<int> released;
+
+    const auto frame1 = fence.Signal();
+    queue.Enqueue(frame1, [&released]() { released.push_back(1); });
+    queue.Enqueue(frame1, [&released]() { released.push_back(2); });
+    const auto frame2 = fence.Signal();
+    queue.Enqueue(frame2, [&released]() { released.push_back(3); });
+
+    CHECK(queue.GetPendingCount() == 3);
+    CHECK(queue.GetLastFenceValue() == frame2);
+
+    // Nothing has completed.
+    CHECK(queue.Collect(fence.GetCompletedValue()) == 0);
+    CHECK(released.empty());
+
+    fence.Complete(frame1);
+    CHECK(queue.Collect(fence.GetCompletedValue()) == 2);
+    CHECK(released.size() == 2 && released[0] == 1 && released[1] == 2);
+
+    // Collecting again at the same value runs nothing twice.
+    CHECK(queue.Collect(fence.GetCompletedValue()) == 0);
+
+    fence.Complete(frame2);
+    CHECK(queue.Collect(fence.GetCompletedValue()) == 1);
+    CHECK(released.size() == 3 && released[2] == 3);
+    CHECK(queue.GetPendingCount() == 0);
+    CHECK(queue.GetLastFenceValue() == 0);
+}
+
+// A value lower than the last one is raised so nothing runs early or out of order.
+void TestDecreasingValue()
+{
+    RetireQueue queue;
+    std::vector<int> released;
+
+    queue.Enqueue(5, [&released]() { released.push_back(5); });
+    queue.Enqueue(3, [&released]() { released.push_back(3); });
+    CHECK(queue.GetLastFenceValue() == 5);
+
+    CHECK(queue.Collect(4) == 0);
+    CHECK(queue.Collect(5) == 2);
+    CHECK(released.size() == 2 && released[0] == 5 && released[1] == 3);
+}
+
+void TestEmptyRelease()
+{
+    RetireQueue queue;
+    queue.Enqueue(1, RetireQueue::ReleaseFunc());
+    CHECK(queue.GetPendingCount() == 0);
+}
+
+// A release may retire more objects, e.g. a material releasing its textures.
+void TestEnqueueFromRelease()
+{
+    RetireQueue queue;
+    FakeFence fence;
+    int count = 0;
+
+    const auto frame1 = fence.Signal();
+    const auto frame2 = fence.Signal();
+    queue.Enqueue(frame1, [&]()
+    {
+        count++;
+        queue.Enqueue(frame1, [&count]() { count += 10; });
+        queue.Enqueue(frame2, [&count]() { count += 100; });
+    });
+
+    fence.Complete(frame1);
+    CHECK(queue.Collect(fence.GetCompletedValue()) == 2);
+    CHECK(count == 11);
+    CHECK(queue.GetPendingCount() == 1);
+
+    queue.Flush();
+    CHECK(count == 111);
+}
+
+// Objects live until their frame completes, and the destructor releases
+// whatever is still queued.
+void TestObjectLifetime()
+{
+    auto alive = std::make_shared<int>(0);
+    std::weak_ptr<int> watch = alive;
+
+    {
+        RetireQueue queue;
+        FakeFence fence;
+
+        const auto frame = fence.Signal();
+        queue.Enqueue(frame, [alive]() mutable { alive.reset(); });
+        alive.reset();
+        CHECK(!watch.expired());
+
+        CHECK(queue.Collect(fence.GetCompletedValue()) == 0);
+        CHECK(!watch.expired());
+
+        auto late = std::make_shared<int>(1);
+        watch = late;
+        queue.Enqueue(fence.Signal(), [late]() mutable { late.reset(); });
+        late.reset();
+    }
+
+    CHECK(watch.expired());
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestCollectOrder);
+    RUN_TEST(TestDecreasingValue);
+    RUN_TEST(TestEmptyRelease);
+    RUN_TEST(TestEnqueueFromRelease);
+    RUN_TEST(TestObjectLifetime);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <TestUtil.h>
+#include <SlotMap.h>
+#include <Pool.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// SlotMap<T> against the active list of Pool<T>:
+//  - iterating every live value: a linear scan of the dense array against a
+//    walk of the intrusive list, which after churn visits items in an order
+//    unrelated to their addresses;
+//  - random lookup: SlotHandle resolution (generation check plus one
+//    indirection) against dereferencing a raw pointer.
+namespace {
+
+struct Value
+{
+    float       Data[6];
+    uint32_t    Id;
+};
+
+const uint32_t Repeats = 20;
+
+void Run(uint32_t count)
+{
+    Pool<Value> pool;
+    SlotMap<Value> map;
+    pool.Init(count);
+    map.Init(count);
+
+    std::vector<Value*> pointers;
+    std::vector<SlotHandle> handles;
+    std::mt19937 random(21);
+
+    for (auto i = 0u; i < count; ++i)
+    {
+        pointers.push_back(pool.Alloc());
+        pointers.back()->Id = i;
+
+        Value value = {};
+        value.Id = i;
+        handles.push_back(map.Insert(value));
+    }
+
+    // Churn half the items so the active list and the slot indices get
+    // scattered, as after a scene has been edited for a while.
+    for (auto i = 0u; i < count / 2; ++i)
+    {
+        const auto index = random() % count;
+
+        pool.Free(pointers[index]);
+        pointers[index] = pool.Alloc();
+        pointers[index]->Id = index;
+
+        map.Erase(handles[index]);
+        Value value = {};
+        value.Id = index;
+        handles[index] = map.Insert(value);
+    }
+
+    uint64_t sum = 0;
+
+    BenchTimer timer;
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        pool.ForEach([&sum](Value* pValue) { sum += pValue->Id; });
+    }
+    const auto listMs = timer.GetElapsedMs() / Repeats;
+
+    timer.Reset();
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        for (auto& value : map)
+        {
+            sum += value.Id;
+        }
+    }
+    const auto denseMs = timer.GetElapsedMs() / Repeats;
+
+    // Same random order for both lookups.
+    std::vector<uint32_t> order(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), random);
+
+    timer.Reset();
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        for (auto index : order)
+        {
+            sum += pointers[index]->Id;
+        }
+    }
+    const auto pointerMs = timer.GetElapsedMs() / Repeats;
+
+    timer.Reset();
+    for (auto r = 0u; r < Repeats; ++r)
+    {
+        for (auto index : order)
+        {
+            sum += map.Get(handles[index])->Id;
+        }
+    }
+    const auto handleMs = timer.GetElapsedMs() / Repeats;
+
+    KeepAlive(sum);
+
+    printf("%9u %12.3f %12.3f %14.3f %17.3f\n", count, listMs, denseMs, pointerMs, handleMs);
+}
+
+} // namespace
+
+int main()
+{
+    printf("%9s %12s %12s %14s %17s\n",
+        "items", "list ms", "dense ms", "ptr lookup ms", "handle lookup ms");
+
+    const uint32_t counts[] = { 1000, 10000, 100000, 1000000 };
+    for (auto count : counts)
+    {
+        Run(count);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <TestUtil.h>
+#include <SlotMap.h>
+#include <Pool.h>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+void TestHandle()
+{
+    SlotHandle empty;
+    CHECK(!empty.IsValid());
+
+    SlotHandle handle(5, 7);
+    CHECK(handle.IsValid());
+    CHECK(handle.GetIndex() == 5);
+    CHECK(handle.GetGeneration() == 7);
+    CHECK(handle != empty);
+    CHECK(handle == SlotHandle(5, 7));
+
+    // Generation 0 is skipped on wrap-around.
+    CHECK(SlotHandle::NextGeneration(SlotHandle::GenerationMask) == 1);
+    CHECK(SlotHandle::NextGeneration(1) == 2);
+}
+
+void TestInsertErase()
+{
+    SlotMap<uint32_t> map;
+    CHECK(!map.Init(0));
+    CHECK(map.Init(4));
+
+    const auto a = map.Insert(10);
+    const auto b = map.Insert(20);
+    const auto c = map.Insert(30);
+    CHECK(a.IsValid() && b.IsValid() && c.IsValid());
+    CHECK(map.GetUsedCount() == 3);
+    CHECK(*map.Get(b) == 20);
+
+    // Erasing from the middle moves the last value into the hole.
+    CHECK(map.Erase(a));
+    CHECK(map.GetUsedCount() == 2);
+    CHECK(map.Get(a) == nullptr);
+    CHECK(!map.Erase(a));
+    CHECK(*map.Get(b) == 20);
+    CHECK(*map.Get(c) == 30);
+    CHECK(map.GetData()[0] == 30);
+    CHECK(map.GetHandle(0) == c);
+
+    // A reused slot gets a new generation, so the old handle stays dead.
+    const auto d = map.Insert(40);
+    CHECK(d.GetIndex() == a.GetIndex());
+    CHECK(d != a);
+    CHECK(map.Get(a) == nullptr);
+    CHECK(*map.Get(d) == 40);
+
+    CHECK(map.Insert(50).IsValid());
+    CHECK(!map.Insert(60).IsValid());
+    CHECK(map.GetAvailableCount() == 0);
+
+    // Handles outside the capacity resolve to nothing.
+    CHECK(map.Get(SlotHandle(100, 1)) == nullptr);
+}
+
+// Random insert/erase against a reference set: every live handle resolves
+// to its value, every dead one to nothing, and the dense array holds
+// exactly the live values.
+void TestChurn()
+{
+    const uint32_t Capacity = 1000;
+
+    SlotMap<uint32_t> map;
+    CHECK(map.Init(Capacity));
+
+    std::vector<std::pair<SlotHandle, uint32_t>> live;
+    std::vector<SlotHandle> dead;
+    std::mt19937 random(3);
+    uint32_t serial = 0;
+
+    for (auto i = 0u; i < 20000; ++i)
+    {
+        if (live.size() < Capacity && (live.empty() || random() % 2 == 0))
+        {
+            const auto handle = map.Insert(serial);
+            CHECK(handle.IsValid());
+            live.push_back(std::make_pair(handle, serial++));
+        }
+        else
+        {
+            const auto index = random() % live.size();
+            CHECK(map.Erase(live[index].first));
+            dead.push_back(live[index].first);
+            live[index] = live.back();
+            live.pop_back();
+        }
+    }
+
+    CHECK(map.GetUsedCount() == live.size());
+
+    uint32_t wrong = 0;
+    for (auto& entry : live)
+    {
+        auto pValue = map.Get(entry.first);
+        wrong += (pValue == nullptr || *pValue != entry.second) ? 1 : 0;
+    }
+    for (auto handle : dead)
+    {
+        // Far fewer erases per slot than it takes the generation to wrap.
+        wrong += map.Contains(handle) ? 1 : 0;
+    }
+    CHECK(wrong == 0);
+
+    std::set<uint32_t> expected;
+    for (auto& entry : live)
+    {
+        expected.insert(entry.second);
+    }
+
+    std::set<uint32_t> actual(map.begin(), map.end());
+    CHECK(actual == expected);
+
+    for (uint32_t i = 0; i < map.GetUsedCount(); ++i)
+    {
+        CHECK(map.Get(map.GetHandle(i)) == map.GetData() + i);
+    }
+}
+
+void TestPoolForEach()
+{
+    Pool<uint32_t> pool;
+    CHECK(pool.Init(8));
+
+    uint32_t* values[8] = {};
+    for (auto i = 0u; i < 8; ++i)
+    {
+        values[i] = pool.Alloc();
+        *values[i] = i;
+    }
+
+    pool.Free(values[2]);
+    pool.Free(values[5]);
+
+    uint32_t sum   = 0;
+    uint32_t count = 0;
+    pool.ForEach([&](uint32_t* pValue) { sum += *pValue; count++; });
+    CHECK(count == 6);
+    CHECK(sum == 28 - 2 - 5);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestHandle);
+    RUN_TEST(TestInsertErase);
+    RUN_TEST(TestChurn);
+    RUN_TEST(TestPoolForEach);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include <TestUtil.h>
+#include <SortKey.h>
+#include <RadixSort.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+void TestGetRenderPass()
+{
+    CHECK(GetRenderPass(1.0f) == RENDER_PASS_OPAQUE);
+    CHECK(GetRenderPass(0.999f) == RENDER_PASS_BLEND);
+    CHECK(GetRenderPass(0.0f) == RENDER_PASS_BLEND);
+}
+
+void TestQuantizeDepth()
+{
+    CHECK(QuantizeDepth(0.0f) == 0);
+    CHECK(QuantizeDepth(-1.0f) == 0);
+    CHECK(QuantizeDepth(0.5f) < QuantizeDepth(1.0f));
+    CHECK(QuantizeDepth(1.0f) < QuantizeDepth(100.0f));
+    CHECK(QuantizeDepth(100.0f) < QuantizeDepth(1.0e6f));
+}
+
+// Blended items must be drawn back to front, whatever their state.
+void TestBlendBackToFront()
+{
+    const float depths[] = { 0.5f, 1.0f, 2.0f, 10.0f, 75.0f, 400.0f };
+    const auto  count    = sizeof(depths) / sizeof(depths[0]);
+
+    for (auto i = 0u; i + 1 < count; ++i)
+    {
+        const auto nearKey = MakeSortKey(RENDER_PASS_BLEND, 0, 0, 0, depths[i]);
+        const auto farKey  = MakeSortKey(RENDER_PASS_BLEND, 0, 0, 0, depths[i + 1]);
+        CHECK(farKey < nearKey);
+
+        // Depth leads: a farther item comes first even with a larger state.
+        const auto farState = MakeSortKey(RENDER_PASS_BLEND, 63, 0xFFFF, 0xFFFFF, depths[i + 1]);
+        CHECK(farState < nearKey);
+    }
+}
+
+// Opaque items are grouped by state and drawn front to back within a state.
+void TestOpaqueStateThenFrontToBack()
+{
+    CHECK(MakeSortKey(RENDER_PASS_OPAQUE, 0, 1, 2, 1.0f) < MakeSortKey(RENDER_PASS_OPAQUE, 0, 1, 2, 5.0f));
+
+    // State leads: a nearer item with a larger material comes later.
+    CHECK(MakeSortKey(RENDER_PASS_OPAQUE, 0, 1, 0, 100.0f) < MakeSortKey(RENDER_PASS_OPAQUE, 0, 2, 0, 1.0f));
+    CHECK(MakeSortKey(RENDER_PASS_OPAQUE, 0, 1, 3, 100.0f) < MakeSortKey(RENDER_PASS_OPAQUE, 0, 1, 4, 1.0f));
+    CHECK(MakeSortKey(RENDER_PASS_OPAQUE, 1, 0, 0, 100.0f) < MakeSortKey(RENDER_PASS_OPAQUE, 2, 0, 0, 1.0f));
+}
+
+// Random items sorted by key: every opaque item comes before every blended
+// one, and the blended ones are in descending depth. Depths that quantize
+// alike fall back to state order, so the quantized depths are compared.
+void TestSortedOrder()
+{
+    const uint32_t count = 5000;
+
+    std::mt19937 random(41);
+    std::uniform_real_distribution<float> depth(0.1f, 500.0f);
+    std::uniform_int_distribution<uint32_t> state(0, 255);
+
+    std::vector<RENDER_PASS> passes(count);
+    std::vector<float>       depths(count);
+    std::vector<uint64_t>    keys(count);
+    std::vector<uint32_t>    items(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        passes[i] = (i % 3 == 0) ? RENDER_PASS_BLEND : RENDER_PASS_OPAQUE;
+        depths[i] = depth(random);
+        keys[i]   = MakeSortKey(passes[i], 0, state(random), state(random), depths[i]);
+        items[i]  = i;
+    }
+
+    RadixSorter sorter;
+    sorter.Sort(keys, items);
+
+    auto firstBlend = count;
+    for (auto i = 0u; i < count; ++i)
+    {
+        if (passes[items[i]] == RENDER_PASS_BLEND)
+        {
+            firstBlend = i;
+            break;
+        }
+    }
+
+    CHECK(firstBlend == count - (count + 2) / 3);
+
+    bool opaqueFirst = true;
+    bool backToFront = true;
+    for (auto i = firstBlend; i < count; ++i)
+    {
+        opaqueFirst = opaqueFirst && (passes[items[i]] == RENDER_PASS_BLEND);
+        if (i + 1 < count)
+        {
+            backToFront = backToFront && (QuantizeDepth(depths[items[i]]) >= QuantizeDepth(depths[items[i + 1]]));
+        }
+    }
+
+    CHECK(opaqueFirst);
+    CHECK(backToFront);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestGetRenderPass);
+    RUN_TEST(TestQuantizeDepth);
+    RUN_TEST(TestBlendBackToFront);
+    RUN_TEST(TestOpaqueStateThenFrontToBack);
+    RUN_TEST(TestSortedOrder);
+
+    return GetTestResult();
+}
\ No newline at end of file
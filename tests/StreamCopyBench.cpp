@@ -0,0 +1,134 @@
+#include <TestUtil.h>
+#include <MemoryUtil.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#endif
+
+// StreamCopy() against memcpy() into
+//  - a small destination that stays in cache, where streaming should lose,
+//  - write-combined memory like a mapped upload heap (Windows only), and
+//  - a destination much larger than the last level cache, the closest
+//    portable stand-in: it is written once and never read back, so cached
+//    stores only evict the source and pay for the read-for-ownership.
+namespace {
+
+const size_t LargeSize = size_t(256) * 1024 * 1024;
+
+struct Buffer
+{
+    uint8_t*    pData;
+    size_t      Size;
+    bool        WriteCombined;
+};
+
+Buffer CreateBuffer(size_t size, bool writeCombined)
+{
+    Buffer buffer = { nullptr, size, false };
+
+#if defined(_WIN32)
+    if (writeCombined)
+    {
+        buffer.pData = static_cast<uint8_t*>(VirtualAlloc(
+            nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE | PAGE_WRITECOMBINE));
+        buffer.WriteCombined = (buffer.pData != nullptr);
+    }
+#else
+    (void)writeCombined;
+#endif
+
+    if (buffer.pData == nullptr)
+    {
+        buffer.pData = static_cast<uint8_t*>(malloc(size));
+    }
+
+    // Commit the pages before timing.
+    memset(buffer.pData, 0, size);
+    return buffer;
+}
+
+void DestroyBuffer(Buffer& buffer)
+{
+#if defined(_WIN32)
+    if (buffer.WriteCombined)
+    {
+        VirtualFree(buffer.pData, 0, MEM_RELEASE);
+        buffer.pData = nullptr;
+        return;
+    }
+#endif
+
+    free(buffer.pData);
+    buffer.pData = nullptr;
+}
+
+// Copies copySize bytes per call, walking through the whole destination so
+// that large destinations are cold on every call. Returns GB/s.
+template<typename Func>
+double Measure(Buffer& dst, const uint8_t* pSrc, size_t copySize, Func&& func)
+{
+    const size_t totalBytes = size_t(1) << 30;
+    const auto slots = dst.Size / copySize;
+
+    BenchTimer timer;
+    size_t slot = 0;
+    for (size_t copied = 0; copied < totalBytes; copied += copySize)
+    {
+        func(dst.pData + slot * copySize, pSrc, copySize);
+        slot = (slot + 1 < slots) ? slot + 1 : 0;
+    }
+
+    KeepAlive(dst.pData[copySize / 2]);
+    return double(totalBytes) / (timer.GetElapsedMs() * 1.0e6);
+}
+
+void Run(const char* name, Buffer& dst, const uint8_t* pSrc)
+{
+    const size_t copySizes[] = { 256, 1024, 2048, 4 * 1024, 8 * 1024, 16 * 1024, 64 * 1024, 1024 * 1024 };
+    for (auto copySize : copySizes)
+    {
+        if (copySize > dst.Size)
+        {
+            continue;
+        }
+
+        const auto copy   = Measure(dst, pSrc, copySize, [](void* d, const void* s, size_t n) { memcpy(d, s, n); });
+        const auto stream = Measure(dst, pSrc, copySize, [](void* d, const void* s, size_t n) { StreamCopy(d, s, n); });
+        printf("%-16s %10zu %12.2f %12.2f\n", name, copySize, copy, stream);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> src(1024 * 1024);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        src[i] = uint8_t(i);
+    }
+
+    printf("%-16s %10s %12s %12s\n", "destination", "copy size", "memcpy GB/s", "stream GB/s");
+
+    auto cached = CreateBuffer(1024 * 1024, false);
+    Run("cached", cached, src.data());
+    DestroyBuffer(cached);
+
+#if defined(_WIN32)
+    auto combined = CreateBuffer(64 * 1024 * 1024, true);
+    Run(combined.WriteCombined ? "write-combined" : "write-comb (n/a)", combined, src.data());
+    DestroyBuffer(combined);
+#endif
+
+    auto cold = CreateBuffer(LargeSize, false);
+    Run("cold", cold, src.data());
+    DestroyBuffer(cold);
+
+    return 0;
+}
\ No newline at end of file
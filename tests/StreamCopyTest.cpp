@@ -0,0 +1,67 @@
+#include <TestUtil.h>
+#include <MemoryUtil.h>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Sizes around the streaming threshold and line boundaries, at several
+// destination and source misalignments within a line.
+void TestMatchesMemcpy()
+{
+    const size_t MaxSize = 8192;
+    const size_t Guard   = 64;
+
+    std::vector<uint8_t> src(MaxSize + 128);
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        src[i] = uint8_t(i * 7 + 3);
+    }
+
+    std::vector<uint8_t> dst(MaxSize + 128 + 2 * Guard);
+    std::vector<uint8_t> expected(dst.size());
+
+    const size_t sizes[] = { 0, 1, 63, 64, 65, 1000, 4095, 4096, 4097, 4159, 4160, 4161, 5000, 8191, 8192 };
+    for (auto size : sizes)
+    {
+        for (size_t dstOffset = 0; dstOffset < 64; dstOffset += 3)
+        {
+            for (size_t srcOffset = 0; srcOffset < 64; srcOffset += 17)
+            {
+                memset(dst.data(), 0xcd, dst.size());
+                memset(expected.data(), 0xcd, expected.size());
+
+                StreamCopy(dst.data() + Guard + dstOffset, src.data() + srcOffset, size);
+                memcpy(expected.data() + Guard + dstOffset, src.data() + srcOffset, size);
+
+                // Nothing before or after the destination is touched either.
+                CHECK(memcmp(dst.data(), expected.data(), dst.size()) == 0);
+            }
+        }
+    }
+}
+
+void TestLargeCopy()
+{
+    const size_t Size = 4 * 1024 * 1024 + 37;
+
+    std::vector<uint8_t> src(Size);
+    for (size_t i = 0; i < Size; ++i)
+    {
+        src[i] = uint8_t(i ^ (i >> 8));
+    }
+
+    std::vector<uint8_t> dst(Size + 1);
+    StreamCopy(dst.data() + 1, src.data(), Size);
+    CHECK(memcmp(dst.data() + 1, src.data(), Size) == 0);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestMatchesMemcpy);
+    RUN_TEST(TestLargeCopy);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include <TestUtil.h>
+#include <TableCache.h>
+#include <vector>
+
+namespace {
+
+typedef TableCache<uint32_t, 4> Cache;
+
+Cache::Key MakeKey(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+    return Cache::Key{ { a, b, c, d } };
+}
+
+void TestHitMiss()
+{
+    Cache cache;
+    cache.Init(4);
+
+    const auto key = MakeKey(1, 2, 3, 4);
+    CHECK(cache.Acquire(key) == Cache::InvalidIndex);
+    CHECK(cache.GetMissCount() == 1);
+
+    const auto index = cache.Insert(key, 100);
+    CHECK(cache.GetCount() == 1);
+    CHECK(cache.Get(index) != nullptr && *cache.Get(index) == 100);
+
+    CHECK(cache.Acquire(key) == index);
+    CHECK(cache.GetHitCount() == 1);
+
+    // Same words in another order are another table.
+    CHECK(cache.Acquire(MakeKey(4, 3, 2, 1)) == Cache::InvalidIndex);
+    CHECK(cache.GetMissCount() == 2);
+}
+
+void TestReleaseAndReuse()
+{
+    Cache cache;
+    cache.Init(4);
+
+    const auto key = MakeKey(7, 0, 0, 0);
+    const auto index = cache.Insert(key, 1);
+    CHECK(cache.Acquire(key) == index);     // two references
+
+    cache.Release(index, 10);
+    CHECK(cache.GetUnusedCount() == 0);
+    cache.Release(index, 11);
+    CHECK(cache.GetUnusedCount() == 1);
+
+    // An unreferenced entry is still found, and is in use again.
+    CHECK(cache.Acquire(key) == index);
+    CHECK(cache.GetUnusedCount() == 0);
+    CHECK(cache.GetCount() == 1);
+
+    // Releasing an unknown index is ignored.
+    cache.Release(1234, 0);
+    CHECK(cache.GetUnusedCount() == 0);
+}
+
+void TestTrimOrder()
+{
+    Cache cache;
+    cache.Init(2);
+
+    uint32_t indices[5];
+    for (auto i = 0u; i < 5; ++i)
+    {
+        indices[i] = cache.Insert(MakeKey(i, 0, 0, 0), i);
+    }
+
+    // Released in the order 3, 1, 4, 0; 2 stays referenced.
+    cache.Release(indices[3], 1);
+    cache.Release(indices[1], 2);
+    cache.Release(indices[4], 3);
+    cache.Release(indices[0], 4);
+    CHECK(cache.GetUnusedCount() == 4);
+
+    std::vector<uint32_t> evicted;
+    auto collect = [&evicted](uint32_t value) { evicted.push_back(value); };
+
+    // Nothing has completed yet.
+    CHECK(cache.Trim(0, collect) == 0);
+
+    // Oldest first, and only what has completed.
+    CHECK(cache.Trim(1, collect) == 1);
+    CHECK(evicted.size() == 1 && evicted[0] == 3);
+
+    CHECK(cache.Trim(100, collect) == 1);
+    CHECK(evicted.size() == 2 && evicted[1] == 1);
+    CHECK(cache.GetUnusedCount() == 2);
+    CHECK(cache.GetCount() == 3);
+
+    // Under the limit nothing more goes.
+    CHECK(cache.Trim(100, collect) == 0);
+    CHECK(cache.Acquire(MakeKey(3, 0, 0, 0)) == Cache::InvalidIndex);
+    CHECK(cache.Acquire(MakeKey(4, 0, 0, 0)) == indices[4]);
+    CHECK(cache.GetUnusedCount() == 1);
+
+    // Evicted slots are reused.
+    const auto index = cache.Insert(MakeKey(9, 0, 0, 0), 9);
+    CHECK(index == indices[3] || index == indices[1]);
+    CHECK(cache.Get(indices[3] == index ? indices[1] : indices[3]) == nullptr);
+}
+
+// A re-acquired entry leaves the middle of the LRU list; the rest must stay linked.
+void TestUnlinkMiddle()
+{
+    Cache cache;
+    cache.Init(0);
+
+    uint32_t indices[3];
+    for (auto i = 0u; i < 3; ++i)
+    {
+        indices[i] = cache.Insert(MakeKey(i, 1, 0, 0), i);
+        cache.Release(indices[i], 0);
+    }
+
+    CHECK(cache.Acquire(MakeKey(1, 1, 0, 0)) == indices[1]);
+
+    std::vector<uint32_t> evicted;
+    CHECK(cache.Trim(0, [&evicted](uint32_t value) { evicted.push_back(value); }) == 2);
+    CHECK(evicted.size() == 2 && evicted[0] == 0 && evicted[1] == 2);
+
+    cache.Release(indices[1], 0);
+    CHECK(cache.Trim(0, [&evicted](uint32_t value) { evicted.push_back(value); }) == 1);
+    CHECK(cache.GetCount() == 0);
+}
+
+void TestClear()
+{
+    Cache cache;
+    cache.Init(8);
+
+    for (auto i = 0u; i < 6; ++i)
+    {
+        const auto index = cache.Insert(MakeKey(i, 2, 0, 0), i);
+        if (i & 1)
+        {
+            cache.Release(index, 0);
+        }
+    }
+
+    uint32_t sum = 0;
+    cache.Clear([&sum](uint32_t value) { sum += value + 1; });
+    CHECK(sum == 21);
+    CHECK(cache.GetCount() == 0);
+    CHECK(cache.GetUnusedCount() == 0);
+
+    // The limit survives Clear().
+    for (auto i = 0u; i < 8; ++i)
+    {
+        cache.Release(cache.Insert(MakeKey(i, 3, 0, 0), i), 0);
+    }
+    CHECK(cache.Trim(0, [](uint32_t) {}) == 0);
+}
+
+} // namespace
+
+int main()
+{
+    RUN_TEST(TestHitMiss);
+    RUN_TEST(TestReleaseAndReuse);
+    RUN_TEST(TestTrimOrder);
+    RUN_TEST(TestUnlinkMiddle);
+    RUN_TEST(TestClear);
+
+    return GetTestResult();
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <TestUtil.h>
+#include <atomic>
+#include <cstdarg>
+
+namespace {
+
+std::atomic<int> g_FailureCount(0);
+
+} // namespace
+
+void ReportFailure(const char* file, int line, const char* expr)
+{
+    printf("[File : %s, Line : %d] CHECK( %s ) Failed.\n", file, line, expr);
+    g_FailureCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+int GetFailureCount()
+{
+    return g_FailureCount.load(std::memory_order_relaxed);
+}
+
+// Logger.cpp goes through OutputDebugStringA; the engine sources built here
+// log to stdout instead.
+void OutputLog(const char* format, ...)
+{
+    va_list arg;
+
+    va_start(arg, format);
+    vprintf(format, arg);
+    va_end(arg);
+}
\ No newline at end of file
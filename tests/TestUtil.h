@@ -0,0 +1,88 @@
+#ifndef _TEST_UTIL_H_
+#define _TEST_UTIL_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+
+// Minimal test harness: CHECK() reports a failure and keeps going, and
+// RUN_TEST() prints each test by name. main() returns GetTestResult() so
+// that ctest sees a failed check as a failed test.
+void ReportFailure(const char* file, int line, const char* expr);
+int GetFailureCount();
+
+#define CHECK( x ) do { if (!(x)) { ReportFailure(__FILE__, __LINE__, #x); } } while (0)
+
+#define RUN_TEST( func ) do { printf("[ RUN  ] %s\n", #func); func(); } while (0)
+
+inline int GetTestResult()
+{
+    const auto count = GetFailureCount();
+    printf("%s : %d failure(s)\n", (count == 0) ? "PASSED" : "FAILED", count);
+    return (count == 0) ? 0 : 1;
+}
+
+// Wall clock timer for the benchmarks.
+class BenchTimer
+{
+public:
+    BenchTimer()
+        : m_Start(std::chrono::steady_clock::now())
+    {
+    }
+
+    void Reset()
+    {
+        m_Start = std::chrono::steady_clock::now();
+    }
+
+    double GetElapsedMs() const
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - m_Start;
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_Start;
+};
+
+// Stands in for a queue fence: Signal() hands out increasing values and
+// the test decides how far the GPU has got with Complete().
+class FakeFence
+{
+public:
+    FakeFence()
+        : m_NextValue(1)
+        , m_CompletedValue(0)
+    {
+    }
+
+    uint64_t Signal()
+    {
+        return m_NextValue++;
+    }
+
+    void Complete(uint64_t value)
+    {
+        m_CompletedValue = value;
+    }
+
+    uint64_t GetCompletedValue() const
+    {
+        return m_CompletedValue;
+    }
+
+private:
+    uint64_t m_NextValue;
+    uint64_t m_CompletedValue;
+};
+
+// Keeps the compiler from dropping a result the benchmark never reads.
+template<typename T>
+inline void KeepAlive(const T& value)
+{
+    static volatile uint64_t sink;
+    sink = sink + uint64_t(value);
+}
+
+#endif
\ No newline at end of file